@@ -8,7 +8,7 @@ Airplane::Airplane(unsigned int id, string model, unsigned int capacity, vector<
                    Date maintenancePeriod) : id(id),
                                              model(model),
                                              capacity(capacity),
-                                             flights(flights), maintenance(maintenance),
+                                             flights(flights.begin(), flights.end()), maintenance(maintenance),
                                              maintenancePeriod(maintenancePeriod) {}
 
 Airplane::Airplane(unsigned int id, string model, unsigned int capacity, Date maintenance, Date maintenancePeriod) {
@@ -16,13 +16,16 @@ Airplane::Airplane(unsigned int id, string model, unsigned int capacity, Date ma
     this->id = id;
     this->model = model;
     this->capacity = capacity;
-    vector<Flight *> v;
-    flights = v;
+    flights.clear();
     this->maintenance = maintenance;
     this->maintenancePeriod = maintenancePeriod;
 }
 
 string Airplane::getModel() const {
+    return this->model.str();
+}
+
+Symbol Airplane::getModelSymbol() const {
     return this->model;
 }
 
@@ -34,7 +37,7 @@ unsigned int Airplane::getCapacity() const {
     return this->capacity;
 }
 
-vector<Flight *> Airplane::getFlights() const {
+const vector<FlightId> &Airplane::getFlights() const {
     return this->flights;
 }
 
@@ -65,8 +68,8 @@ void Airplane::setCapacity(unsigned int capacity) {
     }
 }
 
-void Airplane::setFlights(vector<Flight *> flights) {
-    this->flights = flights;
+void Airplane::setFlights(vector<FlightId> flights) {
+    this->flights = move(flights);
 }
 
 void Airplane::setMaintenance(Date maintenance) {
@@ -79,13 +82,13 @@ void Airplane::setMaintenancePeriod(Date maintenancePeriod) {
 
 void Airplane::printSummary() const {
 
-    cout << setw(11) << id << setw(3) << " " << setw(7) << model << setw(3) << " " << setw(7) << capacity << endl;
+    cout << setw(11) << id << setw(3) << " " << setw(7) << model.str() << setw(3) << " " << setw(7) << capacity << endl;
 }
 
 void Airplane::print() const {
 
     cout << "Id: " << id << endl;
-    cout << "Model: " << model << endl;
+    cout << "Model: " << model.str() << endl;
     cout << "Capacity: " << capacity << endl;
     cout << "Next maintenance date: " << maintenance.print() << endl;
     cout << "Maintenance period: " << maintenancePeriod.day << " day(s)" << endl;
@@ -145,7 +148,7 @@ void Airplane::addFlight(Flight *flight) {
 }
 
 ostream &operator<<(ostream &o, const Airplane *a) {
-    o << to_string(a->id) << "; " << a->model << "; " << to_string(a->capacity) << "; ";
+    o << to_string(a->id) << "; " << a->model.str() << "; " << to_string(a->capacity) << "; ";
     o << a->getMaintenance().print() << "; ";
     o << a->getMaintenancePeriod().day << "; ";
     if (!a->flights.empty()) {
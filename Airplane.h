@@ -7,6 +7,7 @@
 #include "Booking.h"
 #include "exceptions.h"
 #include "helper.h"
+#include "Symbol.h"
 
 using namespace std;
 
@@ -14,12 +15,12 @@ using namespace std;
 class Airplane {
 
 private:
-    string model;
+    Symbol model;
     unsigned int id;
     unsigned int capacity;
     Date maintenance;
     Date maintenancePeriod;
-    vector<Flight *> flights;
+    vector<FlightId> flights;
 
 public:
     /**
@@ -55,6 +56,12 @@ public:
      */
     string getModel() const;
 
+    /**
+     * @brief  Gets the interned Model of the Airplane
+     * @return Symbol model of the Airplane
+     */
+    Symbol getModelSymbol() const;
+
     /**
      * @brief Gets the ID of the Airplane
      * @return unsigned int ID of the Airplanes
@@ -68,10 +75,10 @@ public:
     unsigned int getCapacity() const;
 
     /**
-     * @brief Gets the vector with the pointers to all the flights of an Airplane
-     * @return vector <Flight *> pointers to the flights of an Airplane
+     * @brief Gets the flights of an Airplane, without copying them
+     * @return const vector <FlightId> & handles to the flights of an Airplane
      */
-    vector<Flight *> getFlights() const;
+    const vector<FlightId> &getFlights() const;
 
     /**
      * @brief Gets the Date of a Airplane object
@@ -105,9 +112,9 @@ public:
 
     /**
      * @brief Sets the Airplane's flights vector to the one passed as parameter
-     * @param vector <\ Flight * \> flights
+     * @param vector <\ FlightId \> flights
      */
-    void setFlights(vector<Flight *> flights);
+    void setFlights(vector<FlightId> flights);
 
     /**
      * @brief Sets the Airplane's maintenance date to the one passed as parameter
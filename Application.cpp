@@ -1,6 +1,12 @@
 #include <iomanip>
 #include <vector>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
 #include "Application.h"
+#include "LatencyHistogram.h"
+#include "BookingServer.h"
+#include "Bench.h"
 
 Date Application::currentDate(0, 0, 0, 0, 0);
 
@@ -39,6 +45,7 @@ void Application::setupMenus() {
     menuPassengers["1"] = &Company::passengerShow;
     menuPassengers["2"] = &Company::passengerCreateWrapper;
     menuPassengers["3"] = &Company::passengerDelete;
+    menuPassengers["5"] = &Company::passengerSearch;
 
     //airplanes menu
     menuAirplanes["1"] = &Company::airplaneShow;
@@ -57,6 +64,12 @@ void Application::setupMenus() {
     menuLists["9"] = &Application::printListFlights;
     menuLists["10"] = &Application::printListFlights;
     menuLists["11"] = &Application::printListFlights;
+    menuLists["12"] = &Application::printListFares;
+    menuLists["13"] = &Application::printListPage;
+    menuLists["14"] = &Application::printListPage;
+    menuLists["15"] = &Application::printListPage;
+    menuLists["16"] = &Application::printListBirths;
+    menuLists["17"] = &Application::printListBirths;
 
     //flights menu
     menuFlights["1"] = &Company::flightShow;
@@ -169,6 +182,7 @@ void Application::printPassengersMenu() const {
     cout << "[2]- Create new passenger.\n";
     cout << "[3]- Delete passenger.\n";
     cout << "[4]- Update passenger.\n";
+    cout << "[5]- Search passenger by name.\n";
     cout << "[9]- Back.\n\n";
 
 }
@@ -201,7 +215,15 @@ void Application::printListsMenu() const {
     cout << "[8]- Flights by price (low to high).\n";
     cout << "[9]- Flights by price (high to low).\n";
     cout << "[10]- Flights by destination.\n";
-    cout << "[11]- Flights by time to flight.\n\n";
+    cout << "[11]- Flights by time to flight.\n";
+    cout << "[12]- Fare calendar for a route.\n\n";
+    cout << "Paginated lists.\n\n";
+    cout << "[13]- Cheapest flights (top N).\n";
+    cout << "[14]- Next departures (top N).\n";
+    cout << "[15]- Passengers by name (page).\n\n";
+    cout << "Age lists.\n\n";
+    cout << "[16]- Passengers born between two dates.\n";
+    cout << "[17]- Passengers by age group.\n\n";
     cout << "[0]- Back.\n\n";
 }
 
@@ -244,7 +266,7 @@ void Application::printPassengerUpdateMenu(Passenger *passenger) const {
     cout << "[1]- Change passenger name.\n";
     cout << "[2]- Change passenger date of birth.\n";
 
-    if (passenger->getType() == "c") {
+    if (passenger->getKind() == PASSENGER_CARD) {
 
 
         cout << "[3]- Change passenger job.\n";
@@ -522,39 +544,29 @@ void Application::listsMenu() {
 
 void Application::printListPassengers(type t) {
 
-    vector<Passenger *> passengers;
-
     string title;
     switch (t) {
 
         case PID:
-            passengers = company.getAllPassengers();
-            sort(passengers.begin(), passengers.end(), compPID);
             title = "Passengers by id:\n";
             break;
         case PNAME:
-            passengers = company.getAllPassengers();
-            sort(passengers.begin(), passengers.end(), compPNAME);
             title = "Passengers by name:\n";
             break;
         case PAGE:
-            passengers = company.getAllPassengers();
-            sort(passengers.begin(), passengers.end(), compPAGE);
             title = "Passengers by age:\n";
             break;
         case PACT:
-            passengers = company.getPassengers();
-            sort(passengers.begin(), passengers.end(), compPID);
             title = "Active passengers by id:\n";
             break;
         case PINC:
-            passengers = company.getIncPassengers();
-            sort(passengers.begin(), passengers.end(), compPID);
             title = "Inactive passengers by id:\n";
             break;
         default:
             return;
     }
+    SnapshotStore::Reader snapshot(company.getSnapshots());
+    vector<const PassengerRow *> passengers = snapshot->passengersBy(t);
     if (passengers.empty()) {
         cout << "There are no passengers.\n";
         return;
@@ -563,8 +575,8 @@ void Application::printListPassengers(type t) {
     cout << std::left;
     cout << setw(12) << "Passenger ID" << setw(3) << " " << setw(30) << "Name" << setw(3) << " " << setw(13)
          << "Date of Birth" << endl;
-    for (auto &passenger : passengers) {
-        passenger->printSummary();
+    for (auto const &passenger : passengers) {
+        cout << passenger->summary;
     }
 
 }
@@ -601,41 +613,37 @@ void Application::printListAirplane(type t) {
 
 void Application::printListFlights(type t) {
 
-    if (company.getFlights().empty()) {
+    SnapshotStore::Reader snapshot(company.getSnapshots());
+    if (snapshot->flights->empty()) {
 
         cout << "There are no flights.\n";
         return;
 
     }
 
-    vector<Flight *> flights = company.getFlights();
     string title;
     switch (t) {
 
         case FID:
-            sort(flights.begin(), flights.end(), compFId);
             title = "Flight by id:\n";
             break;
         case FPRICEL:
-            sort(flights.begin(), flights.end(), compFPriceL);
             title = "Flight by price (low to high):\n";
             break;
         case FPRICEH:
-            sort(flights.begin(), flights.end(), compFPriceH);
             title = "Flight by price (high to low):\n";
             break;
         case FDEST:
-            sort(flights.begin(), flights.end(), compFDest);
             title = "Flight by destination:\n";
             break;
         case FTIME:
-            sort(flights.begin(), flights.end(), compFTime);
-            title = "Flight by price:\n";
+            title = "Flight by time to flight:\n";
             break;
         default:
             return;
 
     }
+    vector<const FlightRow *> flights = snapshot->flightsBy(t);
 
     cout << title;
     cout << std::left;
@@ -643,11 +651,179 @@ void Application::printListFlights(type t) {
          << "Destination" << setw(3) << " " << setw(18) << "Date" << setw(3) << " " << setw(9)
          << "Price (€)\n";
 
-    for (auto &flight : flights) {
+    for (auto const &flight : flights) {
+
+        cout << flight->list;
+    }
+
+}
+
+void Application::printListFares(type) {
+
+    if (company.getFlights().empty()) {
+
+        cout << "There are no flights.\n";
+        return;
+
+    }
+
+    company.printFareCalendar();
+}
+
+void Application::printListPage(type t) {
+
+    string title, header, foo;
+    bool byFlight = t != PNAMEPAGE;
+    switch (t) {
+
+        case FCHEAP:
+            title = "Cheapest flights";
+            break;
+        case FNEXT:
+            title = "Next departures";
+            break;
+        case PNAMEPAGE:
+            title = "Passengers by name";
+            break;
+        default:
+            return;
+    }
+
+    if (byFlight && company.getFlights().empty()) {
+        cout << "There are no flights.\n";
+        return;
+    }
+    if (!byFlight && company.getPassengerStore().empty()) {
+        cout << "There are no passengers.\n";
+        return;
+    }
+
+    int pageSize;
+    do {
+        cout << "Insert the number of entries per page: ";
+        if (!validArg(pageSize)) continue;
+        if (pageSize <= 0) {
+            cout << "Invalid number of entries.\n";
+            continue;
+        }
+        break;
+    } while (true);
+
+    if (byFlight) {
+        appendColumn(header, "Flight ID", 9);
+        header += "   ";
+        appendColumn(header, "Departure", 15);
+        header += "   ";
+        appendColumn(header, "Destination", 15);
+        header += "   ";
+        appendColumn(header, "Date", 18);
+        header += "   ";
+        header += "Price (€)\n";
+    } else {
+        appendColumn(header, "Passenger ID", 12);
+        header += "   ";
+        appendColumn(header, "Name", 30);
+        header += "   ";
+        header += "Date of Birth\n";
+    }
+
+    for (size_t page = 0;;) {
+
+        // every page is formatted into a single buffer and written at once
+        string out = title + " (page " + to_string(page + 1) + "):\n" + header;
+        size_t rows = 0;
+        if (byFlight) {
+            vector<Flight *> flights = company.getFlightsPage(t == FCHEAP ? FPRICEL : FTIME, page, (size_t) pageSize);
+            for (auto const &flight : flights) flight->formatList(out);
+            rows = flights.size();
+        } else {
+            vector<Passenger *> passengers = company.getPassengersPage(PNAME, page, (size_t) pageSize);
+            for (auto const &passenger : passengers) passenger->formatSummary(out);
+            rows = passengers.size();
+        }
+        if (rows == 0) {
+            cout << "There are no more entries.\n";
+            return;
+        }
+        cout.write(out.data(), out.size());
+        if (rows < (size_t) pageSize) return;
+
+        // a page is sliced from the sorted view, so jumping to any page costs the same as the next one
+        size_t next = page + 1;
+        do {
+            cout << "Show next page (Y/N) or insert the number of a page: ";
+            if (!validString(foo)) continue;
+            normalize(foo);
+            if (foo == "y" || foo == "n") break;
+            if (!foo.empty() && foo.size() < 10 && all_of(foo.begin(), foo.end(), ::isdigit) && stoul(foo) > 0) {
+                next = stoul(foo) - 1;
+                break;
+            }
+            cout << "Invalid option.\n";
+        } while (true);
+        if (foo == "n") return;
+        page = next;
+    }
+}
+
+void Application::printListBirths(type t) {
+
+    if (company.getPassengerStore().empty()) {
+        cout << "There are no passengers.\n";
+        return;
+    }
+
+    if (t == PBIRTH) {
+        Date from, to;
+        do {
+            cout << "Born on or after (DD/MM/YYYY): ";
+            if (validDate(from)) break;
+        } while (true);
+        do {
+            cout << "Born on or before (DD/MM/YYYY): ";
+            if (validDate(to)) break;
+        } while (true);
+
+        vector<Passenger *> passengers = company.getPassengersBornBetween(from, to);
+        if (passengers.empty()) {
+            cout << "There are no passengers born between " << from.print() << " and " << to.print() << ".\n";
+            return;
+        }
 
-        flight->printList();
+        string out = to_string(passengers.size()) + " passenger(s) born between " + from.print() + " and " +
+                     to.print() + ":\n";
+        appendColumn(out, "Passenger ID", 12);
+        out += "   ";
+        appendColumn(out, "Name", 30);
+        out += "   ";
+        out += "Date of Birth\n";
+        for (auto const &passenger : passengers) passenger->formatSummary(out);
+        cout.write(out.data(), out.size());
+        return;
     }
 
+    if (t != PAGEGROUP) return;
+
+    int width, groups;
+    do {
+        cout << "Insert the number of years of each age group: ";
+        if (!validArg(width)) continue;
+        if (width > 0) break;
+        cout << "Invalid number of years.\n";
+    } while (true);
+    do {
+        cout << "Insert the number of age groups: ";
+        if (!validArg(groups)) continue;
+        if (groups > 0) break;
+        cout << "Invalid number of groups.\n";
+    } while (true);
+
+    vector<int> histogram = company.getAgeHistogram(width, groups);
+    cout << "Passengers by age group:\n";
+    for (int i = 0; i < groups; i++) {
+        string label = to_string(i * width) + (i == groups - 1 ? "+" : "-" + to_string((i + 1) * width - 1));
+        cout << std::left << setw(9) << label << setw(3) << " " << histogram[i] << endl;
+    }
 }
 
 void Application::flightsMenu() {
@@ -698,7 +874,7 @@ void Application::bookingsMenu() {
     string menuhelper;
     Passenger *passenger;
 
-    if (company.getAllPassengers().empty()) {
+    if (company.getPassengerStore().empty()) {
         cout << "There are no passengers.\n";
         return;
     }
@@ -768,7 +944,7 @@ void Application::maintenanceMenu() {
 
 void Application::passengerUpdateMenu() {
 
-    if (company.getPassengers().empty()) {
+    if (company.getPassengerStore().withStatus(PASSENGER_ACTIVE).empty()) {
         cout << "There are no passengers.\n";
         return;
     }
@@ -962,7 +1138,7 @@ Airplane *Application::readAirplane(string &a) {
         f.push_back((unsigned int) fid);
     }
 
-    vector<Flight *> flights;
+    vector<FlightId> flights;
 
     for (auto const &id:f) {
         Flight *fp;
@@ -979,7 +1155,7 @@ Airplane *Application::readAirplane(string &a) {
 
     }
 
-    newAirplane->setFlights(flights);
+    newAirplane->setFlights(move(flights));
 
     return newAirplane;
 
@@ -1008,6 +1184,7 @@ Flight *Application::readFlight(string &f) {
     int temp;
     try { next(temp, f, ";"); } catch (InvalidFormat) {
         cout << "Please insert the Flight data in the correct format.\n";
+        delete newFlight;
         return nullptr;
     }
 
@@ -1030,6 +1207,7 @@ Flight *Application::readFlight(string &f) {
     } catch (InvalidFormat) {
         cout << "Flight " << to_string(newFlight->getId())
              << ": Please insert the Flight data in the correct format.\n";
+        delete newFlight;
         return nullptr;
     }
 
@@ -1045,6 +1223,7 @@ Flight *Application::readFlight(string &f) {
     try { next(temp, f, ";"); } catch (InvalidFormat) {
         cout << "Flight " << to_string(newFlight->getId())
              << ": Please insert the Flight data in the correct format.\n";
+        delete newFlight;
         return nullptr;
     }
 
@@ -1053,6 +1232,7 @@ Flight *Application::readFlight(string &f) {
     try { next(st, f, ";"); } catch (InvalidFormat) {
         cout << "Flight " << to_string(newFlight->getId())
              << ": Please insert the Flight data in the correct format.\n";
+        delete newFlight;
         return nullptr;
     }
 
@@ -1075,6 +1255,7 @@ Flight *Application::readFlight(string &f) {
         try { next(temp, st, ";"); } catch (InvalidFormat) {
             cout << "Flight " << to_string(newFlight->getId())
                  << ": Please insert the Flight data in the correct format.\n";
+            delete newFlight;
             return nullptr;
         }
 
@@ -1084,6 +1265,7 @@ Flight *Application::readFlight(string &f) {
             p = this->company.passengerById((unsigned int) temp);
         } catch (InvalidPassenger &i) {
             cout << "Flight " << to_string(newFlight->getId()) << ": Invalid buyer id.\n";
+            delete newFlight;
             return nullptr;
         }
         newFlight->setBuyer(p);
@@ -1100,6 +1282,7 @@ Flight *Application::readFlight(string &f) {
         int elem;
         try { next(elem, st1, "-"); } catch (InvalidFormat) {
             cout << "Flight " << to_string(newFlight->getId()) << ": Invalid passenger id.\n";
+            delete newFlight;
             return nullptr;
         }
 
@@ -1109,6 +1292,7 @@ Flight *Application::readFlight(string &f) {
             p = this->company.passengerById((unsigned int) elem);
         } catch (InvalidPassenger &i) {
             cout << "Flight " << to_string(newFlight->getId()) << ": Invalid passenger id.\n";
+            delete newFlight;
             return nullptr;
         }
 
@@ -1129,6 +1313,7 @@ Technician *Application::readTechnician(string &p) {
     try { next(temp, p, ";"); }
     catch (InvalidFormat) {
         cout << "Please insert the Passenger data in the correct format.\n";
+        delete newTechnician;
         return nullptr;
     }
 
@@ -1174,6 +1359,7 @@ Passenger *Application::readPassenger(string &p) {
     int temp;
     try { next(temp, p, ";"); } catch (InvalidFormat) {
         cout << "Please insert the Passenger data in the correct format.\n";
+        delete newPassenger;
         return nullptr;
     }
 
@@ -1201,6 +1387,7 @@ Passenger *Application::readPassenger(string &p) {
 
         try { next(temp, p, ";"); } catch (InvalidFormat) {
             cout << "Please insert the Passenger data in the correct format.\n";
+            delete newPassenger;
             return nullptr;
         }
 
@@ -1220,10 +1407,14 @@ string Application::inputFilePath(string s) {
 }
 
 void Application::loadTechnicianFile() {
+    loadTechnicianFile(inputFilePath(Company::TECHNICIAN_IDENTIFIER));
+}
+
+void Application::loadTechnicianFile(const string &path) {
 
     string f;
 
-    techniciansFilepath = inputFilePath(Company::TECHNICIAN_IDENTIFIER);
+    techniciansFilepath = path;
 
     if (techniciansFilepath == "") throw InvalidFilePath("empty");
 
@@ -1246,10 +1437,14 @@ void Application::loadTechnicianFile() {
 }
 
 void Application::loadFlightFile() {
+    loadFlightFile(inputFilePath(Company::FLIGHT_IDENTIFIER));
+}
+
+void Application::loadFlightFile(const string &path) {
 
     string f;
 
-    flightsFilepath = inputFilePath(Company::FLIGHT_IDENTIFIER);
+    flightsFilepath = path;
 
     if (flightsFilepath == "") throw InvalidFilePath("empty");
 
@@ -1258,6 +1453,8 @@ void Application::loadFlightFile() {
         flightsFilepath.clear();
         throw InvalidFilePath("fail");
     }
+    // the whole file is published to the snapshots as one version
+    SnapshotStore::Batch batch(company.getSnapshots());
     this->company.clearData(Company::FLIGHT_IDENTIFIER);
     while (getline(flFile, f)) {
         if (f.empty()) continue;
@@ -1276,8 +1473,12 @@ void Application::loadFlightFile() {
 }
 
 void Application::loadAirplaneFile() {
+    loadAirplaneFile(inputFilePath(Company::AIRPLANE_IDENTIFIER));
+}
+
+void Application::loadAirplaneFile(const string &path) {
 
-    airplanesFilepath = inputFilePath(Company::AIRPLANE_IDENTIFIER);
+    airplanesFilepath = path;
 
     string a;
 
@@ -1297,13 +1498,17 @@ void Application::loadAirplaneFile() {
     airFile.close();
 
     cout << "File successfully loaded.\n";
-    this->company.updateTime();
+    this->company.promoteWaiters(this->company.updateTime());
 
 }
 
 void Application::loadPassengerFile() {
+    loadPassengerFile(inputFilePath(Company::PASSENGER_IDENTIFIER));
+}
+
+void Application::loadPassengerFile(const string &path) {
 
-    passengersFilepath = inputFilePath(Company::PASSENGER_IDENTIFIER);
+    passengersFilepath = path;
 
     string p;
 
@@ -1314,6 +1519,8 @@ void Application::loadPassengerFile() {
         passengersFilepath.clear();
         throw InvalidFilePath("fail");
     }
+    // the whole file is published to the snapshots as one version
+    SnapshotStore::Batch batch(company.getSnapshots());
     this->company.clearData(Company::PASSENGER_IDENTIFIER);
     while (getline(passFile, p)) {
         if (p.empty()) continue;
@@ -1327,7 +1534,7 @@ void Application::loadPassengerFile() {
 
 }
 
-void Application::saveFile(string &path, AirplanesSet fleet) {
+void Application::saveFile(string &path, const AirplanesSet &fleet) {
     ofstream file(path);
 
     if (!file) throw InvalidFilePath("fail");
@@ -1355,10 +1562,13 @@ void Application::saveFile(string &path, techniciansPriorityQueue techs) {
     file.close();
 }
 
-void Application::saveAllFiles() {
+void Application::saveAllFiles(bool ask) {
+    // passengers and flights are written from one snapshot, so the files agree with each other
+    SnapshotStore::Reader snapshot(company.getSnapshots());
+
     if (company.getAirplanesChanged()) {
 
-        if (airplanesFilepath.empty()) airplanesFilepath = inputFilePath(Company::AIRPLANE_IDENTIFIER);
+        if (airplanesFilepath.empty() && ask) airplanesFilepath = inputFilePath(Company::AIRPLANE_IDENTIFIER);
 
         try { saveFile(airplanesFilepath, this->company.getFleet()); } catch (InvalidFilePath &in) { in.print(); }
 
@@ -1366,23 +1576,23 @@ void Application::saveAllFiles() {
 
     if (company.getFlightsChanged()) {
 
-        if (flightsFilepath.empty()) flightsFilepath = inputFilePath(Company::FLIGHT_IDENTIFIER);
+        if (flightsFilepath.empty() && ask) flightsFilepath = inputFilePath(Company::FLIGHT_IDENTIFIER);
 
-        try { saveFile(flightsFilepath, this->company.getFlights()); } catch (InvalidFilePath &in) { in.print(); }
+        try { saveFile(flightsFilepath, *snapshot->flights); } catch (InvalidFilePath &in) { in.print(); }
 
     }
 
     if (company.getPassengersChanged()) {
 
-        if (passengersFilepath.empty()) passengersFilepath = inputFilePath(Company::PASSENGER_IDENTIFIER);
+        if (passengersFilepath.empty() && ask) passengersFilepath = inputFilePath(Company::PASSENGER_IDENTIFIER);
 
-        try { saveFile(passengersFilepath, this->company.getPassengers()); } catch (InvalidFilePath &in) { in.print(); }
+        try { saveFile(passengersFilepath, *snapshot->active); } catch (InvalidFilePath &in) { in.print(); }
 
     }
 
     if (company.getTechniciansChanged()) {
 
-        if (techniciansFilepath.empty()) techniciansFilepath = inputFilePath(Company::TECHNICIAN_IDENTIFIER);
+        if (techniciansFilepath.empty() && ask) techniciansFilepath = inputFilePath(Company::TECHNICIAN_IDENTIFIER);
 
         try { saveFile(techniciansFilepath, this->company.getTechnicians()); } catch (
                 InvalidFilePath &in) { in.print(); }
@@ -1392,10 +1602,6 @@ void Application::saveAllFiles() {
 
 }
 
-void Application::advanceTime(Date d) {
-    currentDate = currentDate + d;
-}
-
 void Application::timeMenu() {
     string op;
 
@@ -1469,9 +1675,308 @@ void Application::manageTime(date_member_t date_member) {
     } while (true);
 
     *dm = input;
-    this->advanceTime(d);
-    this->company.updateTime();
+    this->company.advanceClock(d);
     cout << "Time updated successfully.\n\n";
 
 }
 
+/**
+ * @brief Splits a line of a batch script by ';' and trims every piece
+ * @param line const string &line
+ * @return vector<string>
+ */
+static vector<string> splitCommand(const string &line) {
+    vector<string> args;
+    stringstream ss(line);
+    string piece;
+    while (getline(ss, piece, ';')) {
+        size_t first = piece.find_first_not_of(" \t\r");
+        size_t last = piece.find_last_not_of(" \t\r");
+        args.push_back(first == string::npos ? "" : piece.substr(first, last - first + 1));
+    }
+    return args;
+}
+
+/**
+ * @brief Error of a batch line that is not a command (or not one with these arguments)
+ */
+static const string INVALID_COMMAND = "invalid command";
+
+/**
+ * @brief Parses an unsigned number of at most 9 digits
+ * @param s const string &s
+ * @param n unsigned int &n
+ * @return true if s is a number and false otherwise
+ */
+static bool parseNumber(const string &s, unsigned int &n) {
+    if (s.empty() || s.size() > 9 || s.find_first_not_of("0123456789") != string::npos) return false;
+    n = (unsigned int) stoul(s);
+    return true;
+}
+
+/**
+ * @brief Parses a date in the DD/MM/YYYY-hh:mm format (or DD/MM/YYYY if withTime is false)
+ * @param s const string &s
+ * @param date Date &date
+ * @param withTime bool withTime
+ * @return true if s is a valid date and false otherwise
+ */
+static bool parseDate(const string &s, Date &date, bool withTime) {
+    Date d;
+    char extra;
+    int fields = withTime ? sscanf(s.c_str(), "%d/%d/%d-%d:%d%c", &d.day, &d.month, &d.year, &d.hour, &d.minute,
+                                   &extra)
+                          : sscanf(s.c_str(), "%d/%d/%d%c", &d.day, &d.month, &d.year, &extra);
+    if (fields != (withTime ? 5 : 3) || d.day < 1 || d.month < 1 || d.hour < 0 || d.minute < 0) return false;
+    Date copyDate = d;
+    copyDate.normalize();
+    if (!(d == copyDate)) return false;
+    date = d;
+    return true;
+}
+
+/**
+ * @brief Parses a duration in the hh:mm format
+ * @param s const string &s
+ * @param duration Date &duration
+ * @return true if s is a valid duration and false otherwise
+ */
+static bool parseTime(const string &s, Date &duration) {
+    Date d;
+    char extra;
+    if (sscanf(s.c_str(), "%d:%d%c", &d.hour, &d.minute, &extra) != 2 || d.hour < 0 || d.minute < 0) return false;
+    d.normalize();
+    duration = d;
+    return true;
+}
+
+int Application::runBatch(const string &scriptPath) {
+
+    ifstream script(scriptPath);
+    if (!script) {
+        InvalidFilePath("fail").print();
+        return 1;
+    }
+
+    // the messages of the failed commands are printed at the end, so the loop never waits on the terminal
+    stringstream log;
+    map<string, LatencyHistogram> latencies;
+    unsigned int lineNumber = 0, failed = 0;
+    uint64_t ops = 0;
+    string line, error;
+
+    auto start = chrono::steady_clock::now();
+    while (getline(script, line)) {
+        lineNumber++;
+        vector<string> args = splitCommand(line);
+        if (args.empty() || args[0].empty() || args[0][0] == '#') continue;
+
+        string label = args[0];
+        if ((label == "create" || label == "delete") && args.size() > 1) label += " " + args[1];
+
+        auto begin = chrono::steady_clock::now();
+        bool ok = runBatchCommand(args, error);
+        auto end = chrono::steady_clock::now();
+
+        // the lines that are not commands share one histogram, so a script of typos cannot add one per line
+        if (!ok && error == INVALID_COMMAND) label = "invalid";
+        latencies[label].record((uint64_t) chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+        ops++;
+        if (!ok) {
+            failed++;
+            log << "Line " << lineNumber << " (" << line << "): " << error << ".\n";
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << log.str();
+    cout << "\n[BATCH REPORT]\n\n";
+    stringstream summary;
+    summary << ops << " commands (" << failed << " failed) in " << fixed << setprecision(3) << seconds << " s";
+    if (seconds > 0) summary << ", " << setprecision(0) << ops / seconds << " ops/s";
+    cout << summary.str() << "\n\n";
+    for (auto const &l : latencies) l.second.print(cout, l.first);
+
+    return 0;
+}
+
+bool Application::runBatchCommand(const vector<string> &args, string &error) {
+
+    const string &command = args.at(0);
+    unsigned int id, other;
+    service_status_t status;
+
+    if (command == "date" && args.size() == 2) {
+        Date date;
+        if (!parseDate(args[1], date, true)) {
+            error = "invalid date";
+            return false;
+        }
+        currentDate = date;
+        company.promoteWaiters(company.updateTime());
+        return true;
+    }
+
+    if (command == "load" && args.size() == 3) {
+        try {
+            if (args[1] == "passengers") loadPassengerFile(args[2]);
+            else if (args[1] == "flights") loadFlightFile(args[2]);
+            else if (args[1] == "airplanes") loadAirplaneFile(args[2]);
+            else if (args[1] == "technicians") loadTechnicianFile(args[2]);
+            else {
+                error = "unknown file type '" + args[1] + "'";
+                return false;
+            }
+        }
+        catch (InvalidFilePath &i) {
+            error = "failed to open '" + args[2] + "'";
+            return false;
+        }
+        return true;
+    }
+
+    if (command == "rush" && args.size() == 2) {
+        if (!parseNumber(args[1], id) || id == 0 || id > 256) {
+            error = "invalid number of threads";
+            return false;
+        }
+        benchRush(company, id);
+        return true;
+    }
+
+    if (command == "stress" && args.size() == 3) {
+        if (!parseNumber(args[1], id) || id == 0 || id > 256 || !parseNumber(args[2], other)) {
+            error = "invalid stress arguments";
+            return false;
+        }
+        if (!benchStress(company, id, other)) {
+            error = "the bookings changed";
+            return false;
+        }
+        return true;
+    }
+
+    if (command == "allocate" && args.size() == 5) {
+        unsigned int capacity, load, k, parties;
+        if (!parseNumber(args[1], capacity) || capacity == 0 || capacity % SeatMap::ROW_SEATS ||
+            !parseNumber(args[2], load) || load > 100 || !parseNumber(args[3], k) || k == 0 ||
+            !parseNumber(args[4], parties)) {
+            error = "invalid allocate arguments";
+            return false;
+        }
+        benchAllocate(capacity, load, k, parties);
+        return true;
+    }
+
+    if (command == "radix" && args.size() == 2) {
+        // the benchmark passengers take handles next to the ones of the company (at most 64M)
+        if (!parseNumber(args[1], id) || id == 0 || id > 50000000) {
+            error = "invalid number of passengers";
+            return false;
+        }
+        if (!benchRadix(id)) {
+            error = "the radix sort is out of order";
+            return false;
+        }
+        return true;
+    }
+
+    if (command == "idmap" && args.size() == 2) {
+        if (!parseNumber(args[1], id) || id == 0 || id > 50000000) {
+            error = "invalid number of passengers";
+            return false;
+        }
+        if (!benchIdMap(id)) {
+            error = "the id maps do not agree";
+            return false;
+        }
+        return true;
+    }
+
+    if (command == "save" && args.size() == 1) {
+        saveAllFiles(false);
+        resetFlags();
+        return true;
+    }
+
+    if (command == "book" && args.size() == 4 && parseNumber(args[1], id) && parseNumber(args[2], other))
+        status = company.book(id, other, args[3]);
+    else if (command == "return" && args.size() == 2 && parseNumber(args[1], id))
+        status = company.returnBooking(id);
+    else if (command == "group" && args.size() >= 4 && (args.size() - 1) % 3 == 0) {
+        vector<GroupRequest> requests;
+        for (size_t i = 1; i < args.size(); i += 3) {
+            GroupRequest request;
+            if (!parseNumber(args[i], request.passengerId) || !parseNumber(args[i + 1], request.flightId)) {
+                error = "invalid group";
+                return false;
+            }
+            request.seat = args[i + 2];
+            requests.push_back(request);
+        }
+        status = company.bookGroup(requests);
+    } else if (command == "hold" && args.size() == 5 && parseNumber(args[1], id) && parseNumber(args[2], other)) {
+        unsigned int minutes;
+        if (!parseNumber(args[4], minutes)) {
+            error = "invalid minutes";
+            return false;
+        }
+        status = company.holdSeat(id, other, args[3], minutes);
+    } else if (command == "release" && args.size() == 4 && parseNumber(args[1], id) && parseNumber(args[2], other))
+        status = company.releaseHold(id, other, args[3]);
+    else if (command == "wait" && args.size() == 3 && parseNumber(args[1], id) && parseNumber(args[2], other))
+        status = company.joinWaitlist(id, other);
+    else if (command == "overbook" && args.size() == 2 && parseNumber(args[1], id)) {
+        company.setOverbookingMargin(id);
+        status = SERVICE_OK;
+    } else if (command == "maintain" && args.size() == 2 && parseNumber(args[1], id))
+        status = company.performMaintenance(id);
+    else if (command == "advance" && args.size() == 2 && parseNumber(args[1], id)) {
+        company.advanceClock(id);
+        status = SERVICE_OK;
+    } else if (command == "delete" && args.size() == 3 && args[1] == "flight" && parseNumber(args[2], id))
+        status = company.deleteFlight(id);
+    else if (command == "delete" && args.size() == 3 && args[1] == "passenger" && parseNumber(args[2], id))
+        status = company.deletePassenger(id);
+    else if (command == "create" && args.size() == 10 && args[1] == "flight") {
+        unsigned int price;
+        Date date, duration;
+        if (!parseNumber(args[2], other) || (args[3] != "c" && args[3] != "r") || !parseNumber(args[4], id) ||
+            args[5].empty() || args[6].empty() || !parseDate(args[7], date, true) || !parseTime(args[8], duration) ||
+            !parseNumber(args[9], price)) {
+            error = "invalid flight";
+            return false;
+        }
+        status = company.createFlight(other, args[3] == "r" ? FLIGHT_RENTED : FLIGHT_COMMERCIAL, id, args[5], args[6],
+                                      date, duration, price);
+    } else if (command == "create" && (args.size() == 6 || args.size() == 7) && args[1] == "passenger") {
+        bool card = args[2] == "c";
+        Date dateOfBirth;
+        if ((!card && args[2] != "n") || card != (args.size() == 7) || !parseNumber(args[3], id) || args[4].empty() ||
+            !parseDate(args[5], dateOfBirth, false) || (card && args[6].empty())) {
+            error = "invalid passenger";
+            return false;
+        }
+        status = company.createPassenger(card ? PASSENGER_CARD : PASSENGER_REGULAR, id, args[4], dateOfBirth,
+                                         card ? args[6] : "");
+    } else {
+        error = INVALID_COMMAND;
+        return false;
+    }
+
+    if (status != SERVICE_OK) {
+        error = Company::describe(status);
+        return false;
+    }
+    return true;
+}
+
+#ifdef __linux__
+
+int Application::serve(const string &socketPath, const string &setupScript) {
+    if (!setupScript.empty() && runBatch(setupScript) != 0) return 1;
+    BookingServer server(company);
+    return server.run(socketPath);
+}
+
+#endif
@@ -220,6 +220,24 @@ public:
     * @param t struct type t
     */
     void printListFlights(type t);
+
+    /**
+    * @brief Prints the cheapest fare of each day of a month for a route, the list type is not used (it only matches
+    * the signature of the lists menu)
+    */
+    void printListFares(type);
+
+    /**
+    * @brief Prints a sorted list one page at a time, only the entries up to the requested page are sorted
+    * @param t struct type t (FCHEAP, FNEXT or PNAMEPAGE)
+    */
+    void printListPage(type t);
+
+    /**
+    * @brief Prints the passengers born between two dates or the number of passengers per age group
+    * @param t struct type t (PBIRTH or PAGEGROUP)
+    */
+    void printListBirths(type t);
     /** @} end of Application Menu member-functions */
 
     /** @name Application File management member-functions*/
@@ -260,27 +278,46 @@ public:
     */
     void loadFlightFile();
 
+    /**
+    *@brief Loads all the lines from the flight file passed as argument
+    * @param path const string &path
+    */
+    void loadFlightFile(const string &path);
+
     /**
     *@brief Loads all the lines from a airplane file if the filepath is correct
     */
     void loadAirplaneFile();
 
+    /**
+    *@brief Loads all the lines from the airplane file passed as argument
+    * @param path const string &path
+    */
+    void loadAirplaneFile(const string &path);
+
     /**
     *@brief Loads all the lines from a passenger file if the filepath is correct
     */
     void loadPassengerFile();
 
+    /**
+    *@brief Loads all the lines from the passenger file passed as argument
+    * @param path const string &path
+    */
+    void loadPassengerFile(const string &path);
+
     /**
     *@ brief Saves all the changes made in the execution of the program to the files
+    * @param ask bool ask (if true, asks the path of the files that were not loaded)
     */
-    void saveAllFiles();
+    void saveAllFiles(bool ask = true);
 
     /**
      * @brief Saves the fleet on the airplane File
      * @param path
      * @param fleet
      */
-    void saveFile(string &path, AirplanesSet fleet);
+    void saveFile(string &path, const AirplanesSet &fleet);
 
     /**
      * @brief Saves the technicians info in the techs file
@@ -300,16 +337,17 @@ public:
     void exitMenu();
 
     /**
-    @brief template function that saves the class T object in the file
+    @brief template function that saves the objects of a range (vector or view with begin, end and size) in the file
     */
-    template<class T>
-    void saveFile(string &path, vector<T> objects) {
+    template<class Range>
+    void saveFile(string &path, const Range &objects) {
         ofstream file(path);
 
         if (!file) throw InvalidFilePath("fail");
-        for (size_t i = 0; i < objects.size(); i++) {
-            file << objects.at(i);
-            if (i != objects.size() - 1) file << endl;
+        size_t i = objects.size();
+        for (auto const &o : objects) {
+            file << o;
+            if (--i) file << endl;
         }
         file.close();
     }
@@ -329,10 +367,10 @@ public:
     void loadTechnicianFile();
 
     /**
-     * @brief Function to manage system's dynamic time
-     * @param d Date d
+     * @brief Load the Technician file passed as argument
+     * @param path const string &path
      */
-    static void advanceTime(Date d);
+    void loadTechnicianFile(const string &path);
 
     /**
      * @brief Helper function that resets the changed Flags
@@ -345,6 +383,66 @@ public:
      */
     void manageTime(date_member_t date_member);
 
+    /**
+     * @brief Runs a script of commands through the service API of the Company, without any prompt, and reports the
+     * operations per second and the latency histogram of each command.
+     *
+     * Each line of the script is a command with its arguments separated by ';' (empty lines and lines starting
+     * with '#' are skipped):
+     *  - date; DD/MM/YYYY-hh:mm
+     *  - load; passengers|flights|airplanes|technicians; path
+     *  - book; passenger id; flight id; seat (ALL for a rented flight)
+     *  - group; passenger id; flight id; seat[; passenger id; flight id; seat ...] (all or nothing, ANY lets the
+     *    group choose the seat)
+     *  - return; booking id
+     *  - hold; passenger id; flight id; seat; minutes (the seat cannot be booked by anybody else until then)
+     *  - release; passenger id; flight id; seat
+     *  - wait; passenger id; flight id (joins the waitlist of a full flight, a freed seat is booked for the next
+     *    waiter)
+     *  - overbook; percent (waiters a full flight accepts, in percent of its capacity)
+     *  - create; flight; airplane id; c|r; id; departure; destination; DD/MM/YYYY-hh:mm; hh:mm; base price
+     *  - create; passenger; n|c; id; name; DD/MM/YYYY[; job]
+     *  - delete; flight|passenger; id
+     *  - maintain; airplane id
+     *  - advance; minutes
+     *  - rush; threads (every thread tries to book every free seat of the future flights at once, through the
+     *    BookingEngine, and the claims per second are printed)
+     *  - stress; threads; operations per thread (mixed searches, quotes, ticket lists, bookings, group bookings,
+     *    returns and snapshot reports through the service API at once; every booking is returned, the operations per
+     *    second are printed and the command fails if the bookings do not add up at the end)
+     *  - allocate; capacity; load percent; party size; parties (chooses seats for parties on a seat map kept at
+     *    the load, and prints how often a party sits in one block and the latency of the SeatAllocator)
+     *  - radix; passengers (sorts that many random passengers in every passenger list order with std::sort and with
+     *    the radix sort of the list views, and prints both times)
+     *  - idmap; passengers (inserts, finds and erases that many passenger ids in a FlatIdMap and in the old
+     *    inactivePassengersHT hash set, and prints the time of each operation)
+     *  - save
+     * Changes that are not saved by the script are discarded.
+     * @param scriptPath const string &scriptPath
+     * @return int 0 if the script was run and 1 if it could not be opened
+     */
+    int runBatch(const string &scriptPath);
+
+    /**
+     * @brief Runs one command of a batch script (see runBatch)
+     * @param args const vector<string> &args (command followed by its arguments)
+     * @param error string &error (gets the reason when the command fails)
+     * @return true if the command succeeded and false otherwise
+     */
+    bool runBatchCommand(const vector<string> &args, string &error);
+
+#ifdef __linux__
+
+    /**
+     * @brief Runs a setup script (see runBatch) and serves the Company on a Unix socket (see BookingServer)
+     * @param socketPath const string &socketPath
+     * @param setupScript const string &setupScript (empty for none)
+     * @return int 0 on a clean stop and 1 otherwise
+     */
+    int serve(const string &socketPath, const string &setupScript);
+
+#endif
+
 };
 
 
@@ -0,0 +1,306 @@
+#include "Bench.h"
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <unordered_set>
+#include "LatencyHistogram.h"
+#include "BookingEngine.h"
+#include "FlatIdMap.h"
+#include "SeatAllocator.h"
+#include "RadixSort.h"
+#include "Snapshot.h"
+
+const uint64_t XorShift::SEED;
+
+void benchRush(Company &company, unsigned int threads) {
+    vector<Passenger *> passengers = company.getAllPassengers();
+    vector<pair<unsigned int, string> > seats;
+    for (auto const &f : company.searchFlights("", "")) {
+        if (f->getKind() == FLIGHT_RENTED) seats.emplace_back(f->getId(), "ALL");
+        else
+            for (auto const &s : company.availableSeats(f, f->getCapacity())) seats.emplace_back(f->getId(), s);
+    }
+    if (passengers.empty() || seats.empty()) {
+        cout << "rush: nothing to book.\n";
+        return;
+    }
+
+    BookingEngine engine(company);
+    engine.prepare();
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.emplace_back([&engine, &passengers, &seats, t, threads]() {
+            size_t first = seats.size() * t / threads;
+            for (size_t i = 0; i < seats.size(); i++) {
+                size_t k = (first + i) % seats.size();
+                engine.claim(passengers[k % passengers.size()]->getId(), seats[k].first, seats[k].second);
+            }
+        });
+    }
+    for (auto &w : workers) w.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t booked = engine.commit();
+
+    uint64_t claims = (uint64_t) seats.size() * threads;
+    cout << "rush: " << booked << " seats booked by " << threads << " threads in " << fixed << setprecision(6)
+         << seconds << " s (" << claims << " claims, " << engine.getConflicts() << " lost races";
+    if (seconds > 0) cout << ", " << setprecision(0) << claims / seconds << " claims/s";
+    cout << ").\n";
+}
+
+void benchAllocate(unsigned int capacity, unsigned int load, unsigned int k, unsigned int parties) {
+    SeatMap seats;
+    seats.resize(capacity);
+    XorShift random;
+    while (seats.count() < (size_t) capacity * load / 100) seats.claim(random() % capacity);
+
+    LatencyHistogram latency;
+    vector<size_t> chosen;
+    uint64_t placed = 0, together = 0, blocks = 0;
+    for (unsigned int i = 0; i < parties; i++) {
+        auto begin = chrono::steady_clock::now();
+        bool found = SeatAllocator::allocate(seats, k, chosen);
+        auto end = chrono::steady_clock::now();
+        latency.record((uint64_t) chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+        if (!found) continue;
+
+        size_t parts = SeatAllocator::parts(chosen);
+        placed++;
+        together += parts == 1;
+        blocks += parts;
+        for (auto s : chosen) seats.claim(s);
+        for (size_t left = 0; left < chosen.size();) {
+            size_t s = random() % capacity;
+            if (seats.taken(s)) {
+                seats.release(s);
+                left++;
+            }
+        }
+    }
+
+    cout << "allocate: " << parties << " parties of " << k << " on " << capacity << " seats at " << load << "% load, "
+         << placed << " seated";
+    if (placed) {
+        cout << ", " << fixed << setprecision(1) << 100.0 * together / placed << "% in one block, "
+             << setprecision(2) << (double) blocks / placed << " blocks per party";
+    }
+    cout << ".\n";
+    latency.print(cout, "allocate");
+}
+
+bool benchRadix(unsigned int count) {
+    static const char *first[] = {"Ana", "Antonio", "Beatriz", "Carlos", "Diana", "Joao", "Maria", "Miguel", "Rita",
+                                  "Tiago"};
+    static const char *last[] = {"Almeida", "Costa", "Cruz", "Ferreira", "Gomes", "Martins", "Pereira", "Santos",
+                                 "Silva", "Sousa"};
+    XorShift random;
+
+    // the ids are distinct (multiplying by an odd number is a bijection) and come in no order
+    vector<Passenger> people;
+    people.reserve(count);
+    for (unsigned int i = 0; i < count; i++) {
+        string name = string(first[random() % 10]) + " " + last[random() % 10];
+        Date birth((int) (1930 + random() % 80), (int) (1 + random() % 12), (int) (1 + random() % 28), 0, 0);
+        people.emplace_back((unsigned int) (i * 2654435761u), name, birth);
+    }
+    vector<Passenger *> items;
+    items.reserve(count);
+    for (auto &p : people) items.push_back(&p);
+
+    struct Order {
+        const char *name;
+        bool (*comp)(Passenger *, Passenger *);
+        uint64_t (*key)(Passenger *);
+    };
+    const Order orders[] = {{"id", compPID, keyPID}, {"name", compPNAME, keyPNAME}, {"age", compPAGE, keyPAGE}};
+
+    bool sorted = true;
+    for (auto const &order : orders) {
+        vector<Passenger *> byStd = items, byRadix = items;
+        auto start = chrono::steady_clock::now();
+        sort(byStd.begin(), byStd.end(), order.comp);
+        double stdSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        radixSortBy(byRadix, order.key, order.comp);
+        double radixSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        bool ok = is_sorted(byRadix.begin(), byRadix.end(), order.comp);
+        sorted = sorted && ok;
+        cout << "radix: " << count << " passengers by " << order.name << ", std::sort " << fixed << setprecision(3)
+             << stdSeconds << " s, radix sort " << radixSeconds << " s";
+        if (radixSeconds > 0) cout << " (" << setprecision(2) << stdSeconds / radixSeconds << "x)";
+        cout << (ok ? ".\n" : ", NOT SORTED.\n");
+    }
+    return sorted;
+}
+
+//! struct InactivePassengerHash
+/*! Hash and equality of the inactivePassengersHT set of passengers that PassengerStore replaced, kept as the
+ * baseline of the FlatIdMap benchmark */
+struct InactivePassengerHash {
+    int operator()(const Passenger *p1) const {
+        return static_cast<int>(hash<int>()(p1->getId()));
+    }
+
+    bool operator()(const Passenger *p1, const Passenger *p2) const {
+        return p1->getId() == p2->getId();
+    }
+};
+
+bool benchIdMap(unsigned int count) {
+    // ids i * 2654435761 are distinct for every i below 2^32, so the ids of [count, 2 * count) are never inserted
+    auto idOf = [](uint64_t i) { return (unsigned int) (i * 2654435761u); };
+    vector<Passenger> people;
+    people.reserve(count);
+    for (unsigned int i = 0; i < count; i++) people.emplace_back(idOf(i), "", Date());
+
+    FlatIdMap flat;
+    unordered_set<Passenger *, InactivePassengerHash, InactivePassengerHash> table;
+    Passenger probe;
+    bool ok = true;
+    size_t found = 0;
+
+    auto report = [count](const char *operation, double flatSeconds, double tableSeconds) {
+        cout << "idmap: " << count << " ids, " << operation << ": FlatIdMap " << fixed << setprecision(3)
+             << flatSeconds << " s, inactivePassengersHT " << tableSeconds << " s";
+        if (flatSeconds > 0) cout << " (" << setprecision(2) << tableSeconds / flatSeconds << "x)";
+        cout << ".\n";
+    };
+    auto since = [](chrono::steady_clock::time_point start) {
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++) flat.insert(people[i].getId(), i);
+    double flatSeconds = since(start);
+    start = chrono::steady_clock::now();
+    for (auto &p : people) table.insert(&p);
+    report("insert", flatSeconds, since(start));
+
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++) ok = ok && flat.find(idOf(i)) == i;
+    flatSeconds = since(start);
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++) {
+        probe.setId(idOf(i));
+        found += table.find(&probe) != table.end();
+    }
+    report("find", flatSeconds, since(start));
+
+    start = chrono::steady_clock::now();
+    for (uint64_t i = count; i < 2 * (uint64_t) count; i++) ok = ok && !flat.contains(idOf(i));
+    flatSeconds = since(start);
+    start = chrono::steady_clock::now();
+    for (uint64_t i = count; i < 2 * (uint64_t) count; i++) {
+        probe.setId(idOf(i));
+        found += table.find(&probe) != table.end();
+    }
+    report("find missing", flatSeconds, since(start));
+
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++) ok = flat.erase(idOf(i)) && ok;
+    flatSeconds = since(start);
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++) {
+        probe.setId(idOf(i));
+        table.erase(&probe);
+    }
+    report("erase", flatSeconds, since(start));
+
+    return ok && flat.empty() && table.empty() && found == count;
+}
+
+bool benchStress(Company &company, unsigned int threads, unsigned int operations) {
+    vector<Passenger *> passengers = company.getAllPassengers();
+    vector<Flight *> flights = company.searchFlights("", "");
+    if (passengers.empty() || flights.empty()) {
+        cout << "stress: nothing to book.\n";
+        return true;
+    }
+    size_t before = company.getBookingCount();
+
+    const char *names[] = {"search", "quote", "tickets", "book", "return", "report", "group"};
+    vector<vector<LatencyHistogram> > latencies(threads, vector<LatencyHistogram>(7));
+    atomic<bool> torn(false);
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.emplace_back([&company, &passengers, &flights, &latencies, &torn, t, operations]() {
+            XorShift random(XorShift::SEED * (t + 1));
+            vector<unsigned int> booked;
+            for (unsigned int i = 0; i < operations; i++) {
+                uint64_t seed = random();
+                Passenger *p = passengers[seed % passengers.size()];
+                Flight *f = flights[(seed >> 20) % flights.size()];
+                unsigned int roll = (unsigned int) ((seed >> 40) % 100);
+                int op;
+
+                auto begin = chrono::steady_clock::now();
+                if (!booked.empty() && (booked.size() > 8 || roll < 5)) {
+                    op = 4;
+                    company.returnBooking(booked.front());
+                    booked.erase(booked.begin());
+                } else if (roll >= 95) {
+                    // a report walks a whole snapshot while the other threads keep booking, it must not change
+                    op = 5;
+                    SnapshotStore::Reader snapshot(company.getSnapshots());
+                    size_t rows = 0;
+                    for (auto const &r : *snapshot->active) rows += !r.line.empty();
+                    for (auto const &r : *snapshot->inactive) rows += !r.line.empty();
+                    for (auto const &r : *snapshot->flights) rows += !r.head.empty();
+                    if (rows != snapshot->active->size() + snapshot->inactive->size() + snapshot->flights->size())
+                        torn = true;
+                } else if (roll >= 90) {
+                    // three passengers book two flights together, all or nothing
+                    op = 6;
+                    Flight *g = flights[(seed >> 8) % flights.size()];
+                    vector<GroupRequest> group;
+                    for (unsigned int k = 0; k < 3; k++) {
+                        unsigned int id = passengers[(seed >> (k * 7)) % passengers.size()]->getId();
+                        group.push_back(GroupRequest{id, f->getId(), Company::ANY_SEAT});
+                        group.push_back(GroupRequest{id, g->getId(), Company::ANY_SEAT});
+                    }
+                    vector<unsigned int> ids;
+                    if (company.bookGroup(group, &ids) == SERVICE_OK)
+                        booked.insert(booked.end(), ids.begin(), ids.end());
+                } else if (roll < 40) {
+                    op = 0;
+                    company.searchFlights(f->getDeparture(), "");
+                } else if (roll < 65) {
+                    op = 1;
+                    int64_t cents;
+                    company.quote(p->getId(), f->getId(), cents);
+                } else if (roll < 80) {
+                    op = 2;
+                    company.getTickets(p);
+                } else {
+                    op = 3;
+                    unsigned int rows = max(f->getCapacity() / SeatMap::ROW_SEATS, 1u);
+                    string seat = to_string(1 + (seed >> 50) % rows) + (char) ('A' + (seed >> 30) % SeatMap::ROW_SEATS);
+                    unsigned int id;
+                    if (company.book(p->getId(), f->getId(), seat, &id) == SERVICE_OK) booked.push_back(id);
+                }
+                auto end = chrono::steady_clock::now();
+                latencies[t][op].record((uint64_t) chrono::duration_cast<chrono::nanoseconds>(end - begin).count());
+            }
+            for (auto id : booked) company.returnBooking(id);
+        });
+    }
+    for (auto &w : workers) w.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    uint64_t total = (uint64_t) threads * operations;
+    cout << "stress: " << total << " operations by " << threads << " threads in " << fixed << setprecision(3)
+         << seconds << " s";
+    if (seconds > 0) cout << ", " << setprecision(0) << total / seconds << " ops/s";
+    cout << "\n";
+    for (int op = 0; op < 7; op++) {
+        LatencyHistogram h;
+        for (auto const &l : latencies) h.merge(l[op]);
+        if (h.count()) h.print(cout, string("stress ") + names[op]);
+    }
+    if (torn) cout << "stress: a report saw a snapshot change while reading it.\n";
+    return company.getBookingCount() == before && !torn;
+}
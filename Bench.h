@@ -0,0 +1,87 @@
+#ifndef AEDA_FEUP_PROJECT_BENCH_H
+#define AEDA_FEUP_PROJECT_BENCH_H
+
+#include <cstdint>
+#include "Company.h"
+
+using namespace std;
+
+/**
+ * Xorshift generator of the benchmarks of the batch mode: cheap enough not to weigh on what they measure, and the
+ * same seed always gives the same run
+ */
+class XorShift {
+
+private:
+    uint64_t state;
+
+public:
+    /**
+     * @brief default seed
+     */
+    static const uint64_t SEED = 0x9E3779B97F4A7C15ull;
+
+    /**
+     * @brief Constructor of a generator with the seed passed as argument (not 0)
+     * @param seed uint64_t seed
+     */
+    explicit XorShift(uint64_t seed = SEED) : state(seed) {}
+
+    /**
+     * @brief Gets the next number of the sequence
+     * @return uint64_t
+     */
+    uint64_t operator()() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+/**
+ * @brief Sells out the future flights with concurrent threads: every thread tries to book every free seat, starting
+ * at a different one, so most claims race with the claims of the other threads for the same seat
+ * @param company Company &company
+ * @param threads unsigned int threads
+ */
+void benchRush(Company &company, unsigned int threads);
+
+/**
+ * @brief Measures the SeatAllocator on a seat map kept at a load factor: every party that gets seats sits down and
+ * as many random passengers leave, so the map stays as full and as fragmented as a busy flight
+ * @param capacity unsigned int capacity
+ * @param load unsigned int load (percentage of taken seats)
+ * @param k unsigned int k (seats of a party)
+ * @param parties unsigned int parties
+ */
+void benchAllocate(unsigned int capacity, unsigned int load, unsigned int k, unsigned int parties);
+
+/**
+ * @brief Sorts the same random passengers in every passenger list order with std::sort and with radixSortBy (the
+ * sort of the list views), and prints the time of each
+ * @param count unsigned int count (passengers)
+ * @return true if every radix sort is ordered by the comparator of its list and false otherwise
+ */
+bool benchRadix(unsigned int count);
+
+/**
+ * @brief Inserts, finds (present and missing ids) and erases the same passengers in a FlatIdMap from id to position
+ * and in the old inactivePassengersHT set, and prints the time of each operation
+ * @param count unsigned int count (passengers)
+ * @return true if the FlatIdMap found every inserted id at its position and no missing id, and false otherwise
+ */
+bool benchIdMap(unsigned int count);
+
+/**
+ * @brief Runs a mixed workload on the service API of the Company from concurrent threads: 40% searches of a route,
+ * 25% quotes, 15% ticket lists and 20% bookings of a random seat, each successful booking being returned a few
+ * operations later (and the rest at the end)
+ * @param company Company &company
+ * @param threads unsigned int threads
+ * @param operations unsigned int operations (per thread)
+ * @return true if the bookings of the company are the same as before the run and false otherwise
+ */
+bool benchStress(Company &company, unsigned int threads, unsigned int operations);
+
+#endif //AEDA_FEUP_PROJECT_BENCH_H
@@ -0,0 +1,112 @@
+#include "BirthIndex.h"
+#include <algorithm>
+
+/**
+ * @brief days left free on each side of the tree when it grows, so that loading a file rarely rebuilds it
+ */
+static const int BIRTH_SLACK = 100 * 365;
+
+int BirthIndex::dayOf(const Date &d) {
+    return d.convertToMinutes() / (24 * 60);
+}
+
+void BirthIndex::add(int day, int delta) {
+    for (size_t i = (size_t) (day - origin + 1); i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+}
+
+int BirthIndex::countUpTo(int day) const {
+    if (tree.empty() || day < origin) return 0;
+    size_t i = min((size_t) (day - origin + 1), tree.size() - 1);
+    int total = 0;
+    for (; i > 0; i -= i & (~i + 1)) total += tree[i];
+    return total;
+}
+
+void BirthIndex::cover(int day) {
+    int end = origin + (int) tree.size() - 1;
+    if (!tree.empty() && day >= origin && day < end) return;
+
+    int lo = tree.empty() ? day - BIRTH_SLACK : min(origin, day - BIRTH_SLACK);
+    int hi = tree.empty() ? day + BIRTH_SLACK : max(end, day + BIRTH_SLACK);
+    origin = lo;
+    tree.assign((size_t) (hi - lo + 1), 0);
+
+    // linear build: every node pushes its sum to its parent
+    for (auto const &d : days) tree[(size_t) (d.first - origin + 1)] += (int) d.second.size();
+    for (size_t i = 1; i < tree.size(); i++) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent < tree.size()) tree[parent] += tree[i];
+    }
+}
+
+void BirthIndex::insert(Passenger *passenger) {
+    if (birthDay.find(passenger) != birthDay.end()) erase(passenger);
+
+    int day = dayOf(passenger->getDateOfBirth());
+    cover(day);
+    days[day].push_back(passenger);
+    birthDay[passenger] = day;
+    add(day, 1);
+}
+
+void BirthIndex::erase(Passenger *passenger) {
+    auto it = birthDay.find(passenger);
+    if (it == birthDay.end()) return;
+
+    int day = it->second;
+    auto bucket = days.find(day);
+    if (bucket != days.end()) {
+        vector<Passenger *> &born = bucket->second;
+        born.erase(find(born.begin(), born.end(), passenger));
+        if (born.empty()) days.erase(bucket);
+    }
+    add(day, -1);
+    birthDay.erase(it);
+}
+
+void BirthIndex::update(Passenger *passenger) {
+    erase(passenger);
+    insert(passenger);
+}
+
+void BirthIndex::clear() {
+    tree.clear();
+    days.clear();
+    birthDay.clear();
+    origin = 0;
+}
+
+size_t BirthIndex::size() const {
+    return birthDay.size();
+}
+
+int BirthIndex::count(const Date &from, const Date &to) const {
+    int first = dayOf(from), last = dayOf(to);
+    if (first > last) return 0;
+    return countUpTo(last) - countUpTo(first - 1);
+}
+
+vector<Passenger *> BirthIndex::list(const Date &from, const Date &to) const {
+    vector<Passenger *> result;
+    int first = dayOf(from), last = dayOf(to);
+    if (first > last) return result;
+
+    result.reserve((size_t) count(from, to));
+    for (auto it = days.lower_bound(first); it != days.end() && it->first <= last; it++)
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    return result;
+}
+
+vector<int> BirthIndex::ageHistogram(const Date &now, int width, int groups) const {
+    vector<int> histogram;
+    if (width <= 0 || groups <= 0) return histogram;
+
+    // passengers aged at least a years were born on or before the same day a years ago
+    for (int i = 0; i < groups; i++) {
+        int youngest = dayOf(Date(now.year - i * width, now.month, now.day, 0, 0));
+        int oldest = dayOf(Date(now.year - (i + 1) * width, now.month, now.day, 0, 0));
+        if (i == groups - 1) histogram.push_back(countUpTo(youngest));
+        else histogram.push_back(countUpTo(youngest) - countUpTo(oldest));
+    }
+    return histogram;
+}
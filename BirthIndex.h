@@ -0,0 +1,119 @@
+#ifndef AEDA_FEUP_PROJECT_BIRTHINDEX_H
+#define AEDA_FEUP_PROJECT_BIRTHINDEX_H
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include "Passenger.h"
+
+using namespace std;
+
+/**
+ * Index of the passengers by birth day.
+ * A Fenwick tree over the day numbers counts the passengers born in any range of days in O(log n) and
+ * per-day buckets list them in birth order. Age histograms are a prefix sum per bucket.
+ */
+class BirthIndex {
+
+private:
+    /**
+     * @brief day number of the first slot of the tree
+     */
+    int origin = 0;
+    /**
+     * @brief Fenwick tree of the number of passengers born on each day (1-based)
+     */
+    vector<int> tree;
+    /**
+     * @brief passengers born on each day, by day number
+     */
+    map<int, vector<Passenger *> > days;
+    /**
+     * @brief indexed birth day of every passenger, used to remove it after the date of birth changed
+     */
+    unordered_map<Passenger *, int> birthDay;
+
+    /**
+     * @brief Adds delta to the count of the day passed as argument
+     * @param day int day number
+     * @param delta int delta
+     */
+    void add(int day, int delta);
+
+    /**
+     * @brief Gets the number of passengers born up to the day passed as argument (inclusive)
+     * @param day int day number
+     * @return int
+     */
+    int countUpTo(int day) const;
+
+    /**
+     * @brief Grows the tree so that it covers the day passed as argument
+     * @param day int day number
+     */
+    void cover(int day);
+
+public:
+    /**
+     * @brief Gets the day number of a date (days since year 0 in the calendar of Date::convertToMinutes)
+     * @param d const Date &d
+     * @return int
+     */
+    static int dayOf(const Date &d);
+
+    /**
+     * @brief Indexes the passenger passed as argument
+     * @param passenger Passenger *passenger
+     */
+    void insert(Passenger *passenger);
+
+    /**
+     * @brief Removes the passenger passed as argument from the index
+     * @param passenger Passenger *passenger
+     */
+    void erase(Passenger *passenger);
+
+    /**
+     * @brief Reindexes the passenger passed as argument after its date of birth changed
+     * @param passenger Passenger *passenger
+     */
+    void update(Passenger *passenger);
+
+    /**
+     * @brief Removes every passenger from the index
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of indexed passengers
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Counts the passengers born between the dates passed as argument (both inclusive)
+     * @param from const Date &from
+     * @param to const Date &to
+     * @return int
+     */
+    int count(const Date &from, const Date &to) const;
+
+    /**
+     * @brief Gets the passengers born between the dates passed as argument (both inclusive), oldest first
+     * @param from const Date &from
+     * @param to const Date &to
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> list(const Date &from, const Date &to) const;
+
+    /**
+     * @brief Counts the passengers of each age group at the date passed as argument
+     * @param now const Date &now
+     * @param width int number of years of each group
+     * @param groups int number of groups, the last one also counts every older passenger
+     * @return vector<int> number of passengers aged [i * width, (i + 1) * width) for each group i
+     */
+    vector<int> ageHistogram(const Date &now, int width, int groups) const;
+};
+
+#endif //AEDA_FEUP_PROJECT_BIRTHINDEX_H
@@ -1,4 +1,5 @@
 #include "Booking.h"
+#include "ObjectPool.h"
 
 Booking::Booking(unsigned int id, Passenger *passenger, Flight *flight, string seat) : passenger(passenger),
                                                                                        flight(flight), seat(seat),
@@ -20,3 +21,11 @@ Passenger *Booking::getPassenger() {
 unsigned int Booking::getId() {
     return this->id;
 }
+
+void *Booking::operator new(size_t size) {
+    return ObjectPool<Booking>::allocate(size);
+}
+
+void Booking::operator delete(void *p, size_t size) {
+    ObjectPool<Booking>::release(p, size);
+}
@@ -5,12 +5,12 @@
 #include "Flight.h"
 
 
-class Booking {
+class Booking : public Handled<Booking> {
 
 private:
     unsigned int id;
-    Passenger *passenger;
-    Flight *flight;
+    PassengerId passenger;
+    FlightId flight;
     string seat;
 public:
     /**
@@ -27,6 +27,20 @@ public:
      */
     Booking(unsigned int id, Passenger *passenger, Flight *flight, string seat);
 
+    /**
+     * @brief Allocates a Booking from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a Booking to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     /**
      * @brief Gets the Passenger (as a pointer) of a Booking object
      * @return Passenger *
@@ -53,4 +67,7 @@ public:
 };
 
 
+/*! 32-bit handle of a Booking */
+typedef Handle<Booking> BookingId;
+
 #endif //AEDA_FEUP_PROJECT_BOOKING_H
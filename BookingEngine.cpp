@@ -0,0 +1,72 @@
+#include "BookingEngine.h"
+#include "Booking.h"
+#include <unordered_set>
+
+ClaimQueue::~ClaimQueue() {
+    Claim *c = head.load();
+    while (c != nullptr) {
+        Claim *next = c->next;
+        delete c;
+        c = next;
+    }
+}
+
+void ClaimQueue::push(Claim *claim) {
+    claim->next = head.load(memory_order_relaxed);
+    while (!head.compare_exchange_weak(claim->next, claim, memory_order_release, memory_order_relaxed));
+}
+
+Claim *ClaimQueue::drain() {
+    Claim *c = head.exchange(nullptr, memory_order_acquire), *first = nullptr;
+    while (c != nullptr) {
+        Claim *next = c->next;
+        c->next = first;
+        first = c;
+        c = next;
+    }
+    return first;
+}
+
+BookingEngine::BookingEngine(Company &company) : company(company), conflicts(0) {}
+
+void BookingEngine::prepare() {
+    flights.clear();
+    for (auto const &f : company.searchFlights("", "")) flights[f->getId()] = f;
+}
+
+service_status_t BookingEngine::claim(unsigned int passengerId, unsigned int flightId, const string &seat) {
+    Passenger *passenger = company.getPassengerStore().find(passengerId);
+    if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+    auto it = flights.find(flightId);
+    if (it == flights.end()) return SERVICE_NO_FLIGHT;
+    Flight *flight = it->second;
+
+    string place = "ALL";
+    if (flight->getKind() == FLIGHT_COMMERCIAL) {
+        if (!Company::validSeat(seat, flight->getCapacity())) return SERVICE_INVALID_SEAT;
+        place = seat;
+    }
+    if (!flight->claim(place, passenger)) {
+        conflicts.fetch_add(1, memory_order_relaxed);
+        return SERVICE_SEAT_TAKEN;
+    }
+    claims.push(new Claim{passenger, flight, place, nullptr});
+    return SERVICE_OK;
+}
+
+size_t BookingEngine::commit() {
+    size_t n = 0;
+    unordered_set<Passenger *> passengers;
+    Claim *c = claims.drain();
+    while (c != nullptr) {
+        company.recordBooking(c->passenger, c->flight, c->seat);
+        passengers.insert(c->passenger);
+        n++;
+        Claim *next = c->next;
+        delete c;
+        c = next;
+    }
+    // the status of a passenger scans its bookings, so it is refreshed once per passenger
+    for (auto const &p : passengers) company.updatePassenger(p);
+    return n;
+}
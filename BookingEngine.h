@@ -0,0 +1,116 @@
+#ifndef AEDA_FEUP_PROJECT_BOOKINGENGINE_H
+#define AEDA_FEUP_PROJECT_BOOKINGENGINE_H
+
+#include <string>
+#include <atomic>
+#include <unordered_map>
+#include <cstdint>
+#include "Company.h"
+
+using namespace std;
+
+/**
+ * Seat claimed by a worker thread and not recorded as a Booking yet
+ */
+struct Claim {
+    PassengerId passenger; /*!< passenger of the booking */
+    FlightId flight;       /*!< flight of the booking */
+    string seat;           /*!< seat, "ALL" for a rented flight */
+    Claim *next;           /*!< next claim of the queue */
+};
+
+/**
+ * Lock-free multi-producer queue of claims with a single consumer.
+ * push() links the claim in front of the head with a compare-and-swap; drain() takes the whole list with one
+ * exchange and reverses it, so the consumer gets the claims in the order they were pushed.
+ */
+class ClaimQueue {
+
+private:
+    /**
+     * @brief last claim pushed
+     */
+    atomic<Claim *> head;
+
+public:
+    ClaimQueue() : head(nullptr) {}
+
+    ClaimQueue(const ClaimQueue &) = delete;
+
+    ClaimQueue &operator=(const ClaimQueue &) = delete;
+
+    ~ClaimQueue();
+
+    /**
+     * @brief Adds a claim, thread safe
+     * @param claim Claim *claim (owned by the queue until it is drained)
+     */
+    void push(Claim *claim);
+
+    /**
+     * @brief Takes every claim of the queue
+     * @return Claim * first claim pushed, the rest follow through next (the caller deletes them)
+     */
+    Claim *drain();
+};
+
+/**
+ * Booking path that many threads can use at once.
+ * Worker threads call claim(), which looks the passenger and the flight up in read-only indexes and takes the seat
+ * with a compare-and-swap on the seat map of the CommercialFlight (or on the buyer of the RentedFlight), so there are
+ * no locks and bookings of different flights never touch the same memory. The claims are queued and the main thread
+ * turns them into Booking records with commit().
+ *
+ * Between prepare() and commit() the Company must not be changed by anything but claim().
+ */
+class BookingEngine {
+
+private:
+    /**
+     * @brief company whose flights are sold
+     */
+    Company &company;
+    /**
+     * @brief flights that can be sold, by id
+     */
+    unordered_map<unsigned int, Flight *> flights;
+    /**
+     * @brief claims not recorded yet
+     */
+    ClaimQueue claims;
+    /**
+     * @brief number of claims that lost the seat to another one
+     */
+    atomic<uint64_t> conflicts;
+
+public:
+    explicit BookingEngine(Company &company);
+
+    /**
+     * @brief Indexes the future flights of the company, must be called by the main thread before claim()
+     */
+    void prepare();
+
+    /**
+     * @brief Claims a seat of a flight for a passenger, thread safe
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param seat const string &seat (ignored for a rented flight)
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT or SERVICE_SEAT_TAKEN
+     */
+    service_status_t claim(unsigned int passengerId, unsigned int flightId, const string &seat);
+
+    /**
+     * @brief Records the queued claims as bookings, must be called by the main thread once the workers are done
+     * @return size_t number of bookings recorded
+     */
+    size_t commit();
+
+    /**
+     * @brief Gets the number of claims that found their seat taken
+     * @return uint64_t
+     */
+    uint64_t getConflicts() const { return conflicts.load(memory_order_relaxed); }
+};
+
+#endif //AEDA_FEUP_PROJECT_BOOKINGENGINE_H
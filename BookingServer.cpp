@@ -0,0 +1,281 @@
+#include "BookingServer.h"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#include "Application.h"
+#include "UnixSocket.h"
+
+const size_t BookingServer::HIGH_WATER;
+const size_t BookingServer::READ_CHUNK;
+const int BookingServer::MAX_EVENTS;
+
+BookingServer::BookingServer(Company &company) : company(company) {}
+
+BookingServer::~BookingServer() {
+    for (auto &c : connections) closeSocket(c.first);
+    if (epollFd >= 0) closeSocket(epollFd);
+    if (listenFd >= 0) closeSocket(listenFd);
+}
+
+int BookingServer::run(const string &socketPath) {
+
+    listenFd = listenUnix(socketPath);
+    if (listenFd < 0) {
+        cout << "Failed to listen on " << socketPath << ": " << strerror(errno) << ".\n";
+        return 1;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) < 0) {
+        cout << "Failed to set up epoll: " << strerror(errno) << ".\n";
+        return 1;
+    }
+
+    watchStopSignals();
+
+    cout << "Listening on " << socketPath << ".\n";
+    cout.flush();
+
+    epoll_event events[MAX_EVENTS];
+    while (!stopRequested()) {
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            cout << "epoll_wait failed: " << strerror(errno) << ".\n";
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection &c = it->second;
+            bool alive = true;
+            if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) alive = false;
+            if (alive && (events[i].events & EPOLLIN)) alive = onReadable(c);
+            if (alive && (events[i].events & EPOLLOUT)) alive = onWritable(c);
+            if (alive && c.peerClosed && c.outSent == c.out.size()) alive = false;
+            if (alive) updateEvents(c);
+            else closeConnection(fd);
+        }
+    }
+
+    removeSocket(socketPath);
+    cout << "Server stopped.\n";
+    return 0;
+}
+
+void BookingServer::acceptConnections() {
+    while (true) {
+        int fd = acceptUnix(listenFd);
+        if (fd < 0) return;
+        Connection &c = connections[fd];
+        c.fd = fd;
+        c.events = EPOLLIN;
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = c.events;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+bool BookingServer::onReadable(Connection &c) {
+    size_t old = c.in.size();
+    c.in.resize(old + READ_CHUNK);
+    ssize_t n = recv(c.fd, &c.in[old], READ_CHUNK, 0);
+    c.in.resize(old + (n > 0 ? n : 0));
+    if (n == 0) c.peerClosed = true;
+    else if (n < 0 && errno != EAGAIN && errno != EINTR) return false;
+
+    if (!answerRequests(c)) return false;
+    return onWritable(c);
+}
+
+bool BookingServer::onWritable(Connection &c) {
+    while (c.outSent < c.out.size()) {
+        ssize_t n = send(c.fd, c.out.data() + c.outSent, c.out.size() - c.outSent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) break;
+            return false;
+        }
+        c.outSent += n;
+    }
+    if (c.outSent == c.out.size()) {
+        c.out.clear();
+        c.outSent = 0;
+        // requests may have been left in the input while the output was full
+        if (!c.in.empty()) {
+            if (!answerRequests(c)) return false;
+            if (!c.out.empty()) return onWritable(c);
+        }
+    }
+    return true;
+}
+
+bool BookingServer::answerRequests(Connection &c) {
+    FrameWriter response(c.out);
+    size_t pos = 0;
+    while (c.in.size() - pos >= FRAME_HEADER && c.out.size() - c.outSent < HIGH_WATER) {
+        uint32_t length = FrameReader::frameLength(c.in.data() + pos);
+        // the frame must at least hold the tag and the code
+        if (length < FRAME_HEADER - 4 + 1 || length > MAX_FRAME) return false;
+        if (c.in.size() - pos < 4 + (size_t) length) break;
+
+        FrameReader request(c.in.data() + pos + 4, length);
+        uint32_t tag = request.getU32();
+        uint8_t op = request.getU8();
+        answer(op, request, tag, response);
+        pos += 4 + length;
+    }
+    c.in.erase(0, pos);
+    return true;
+}
+
+void BookingServer::answer(uint8_t op, FrameReader &request, uint32_t tag, FrameWriter &response) {
+
+    response.begin(tag, SERVICE_OK);
+    service_status_t status = SERVICE_OK;
+
+    switch (op) {
+        case OP_SEARCH: {
+            string departure = request.getString();
+            string destination = request.getString();
+            if (!request.ok() || !request.atEnd()) break;
+            vector<Flight *> found = company.searchFlights(departure, destination);
+            response.putU32((uint32_t) found.size());
+            for (auto const f : found) {
+                uint32_t slot = f->getHandleSlot();
+                response.putU32(f->getId());
+                response.putU8((uint8_t) f->getKind());
+                response.putI64(FlightTable::getDeparture(slot));
+                response.putU32(FlightTable::getCapacity(slot));
+                response.putU32(FlightTable::getOccupancy(slot));
+                response.putU32(FlightTable::getBasePrice(slot));
+            }
+            break;
+        }
+        case OP_QUOTE: {
+            uint32_t passengerId = request.getU32();
+            uint32_t flightId = request.getU32();
+            if (!request.ok() || !request.atEnd()) break;
+            int64_t cents = 0;
+            status = company.quote(passengerId, flightId, cents);
+            if (status == SERVICE_OK) response.putI64(cents);
+            break;
+        }
+        case OP_BOOK: {
+            uint32_t passengerId = request.getU32();
+            uint32_t flightId = request.getU32();
+            string seat = request.getString();
+            if (!request.ok() || !request.atEnd()) break;
+            unsigned int bookingId = 0;
+            status = company.book(passengerId, flightId, seat, &bookingId);
+            if (status == SERVICE_OK) response.putU32(bookingId);
+            break;
+        }
+        case OP_RETURN: {
+            uint32_t bookingId = request.getU32();
+            if (!request.ok() || !request.atEnd()) break;
+            status = company.returnBooking(bookingId);
+            break;
+        }
+        case OP_ADVANCE: {
+            uint32_t minutes = request.getU32();
+            if (!request.ok() || !request.atEnd()) break;
+            company.advanceClock(minutes);
+            response.putI64(Application::currentDate.convertToMinutes());
+            break;
+        }
+        case OP_HOLD: {
+            uint32_t passengerId = request.getU32();
+            uint32_t flightId = request.getU32();
+            string seat = request.getString();
+            uint32_t minutes = request.getU32();
+            if (!request.ok() || !request.atEnd()) break;
+            int64_t expiry = 0;
+            status = company.holdSeat(passengerId, flightId, seat, minutes, &expiry);
+            if (status == SERVICE_OK) response.putI64(expiry);
+            break;
+        }
+        case OP_RELEASE: {
+            uint32_t passengerId = request.getU32();
+            uint32_t flightId = request.getU32();
+            string seat = request.getString();
+            if (!request.ok() || !request.atEnd()) break;
+            status = company.releaseHold(passengerId, flightId, seat);
+            break;
+        }
+        case OP_GROUP: {
+            uint32_t count = request.getU32();
+            vector<GroupRequest> requests;
+            for (uint32_t i = 0; i < count && request.ok(); i++) {
+                GroupRequest r;
+                r.passengerId = request.getU32();
+                r.flightId = request.getU32();
+                r.seat = request.getString();
+                requests.push_back(r);
+            }
+            if (!request.ok() || !request.atEnd()) break;
+            vector<unsigned int> bookingIds;
+            status = company.bookGroup(requests, &bookingIds);
+            if (status != SERVICE_OK) break;
+            response.putU32((uint32_t) bookingIds.size());
+            for (auto id : bookingIds) response.putU32(id);
+            break;
+        }
+        case OP_WAIT: {
+            uint32_t passengerId = request.getU32();
+            uint32_t flightId = request.getU32();
+            if (!request.ok() || !request.atEnd()) break;
+            size_t waiting = 0;
+            status = company.joinWaitlist(passengerId, flightId, &waiting);
+            if (status == SERVICE_OK) response.putU32((uint32_t) waiting);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (!request.ok() || !request.atEnd() || op < OP_SEARCH || op > OP_WAIT) {
+        response.cancel();
+        response.begin(tag, STATUS_BAD_REQUEST);
+    } else if (status != SERVICE_OK) {
+        response.cancel();
+        response.begin(tag, (uint8_t) status);
+    }
+    response.end();
+}
+
+void BookingServer::updateEvents(Connection &c) {
+    uint32_t events = 0;
+    if (!c.peerClosed && c.out.size() - c.outSent < HIGH_WATER && c.in.size() < HIGH_WATER) events |= EPOLLIN;
+    if (c.outSent < c.out.size()) events |= EPOLLOUT;
+    if (events == c.events) return;
+
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = c.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &event);
+    c.events = events;
+}
+
+void BookingServer::closeConnection(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    closeSocket(fd);
+    connections.erase(fd);
+}
+
+#endif //__linux__
@@ -0,0 +1,144 @@
+#ifndef AEDA_FEUP_PROJECT_BOOKINGSERVER_H
+#define AEDA_FEUP_PROJECT_BOOKINGSERVER_H
+
+#ifdef __linux__
+
+#include <string>
+#include <unordered_map>
+#include "Company.h"
+#include "Protocol.h"
+
+using namespace std;
+
+/**
+ * Single threaded server of the Company on a Unix domain socket, driven by an epoll event loop.
+ * It speaks the binary protocol of Protocol.h. Every connection has its own input and output buffers: all the
+ * complete frames of the input are answered in order (pipelining), and a connection whose peer does not read its
+ * responses stops being read (backpressure) until its output drains.
+ */
+class BookingServer {
+
+private:
+    /**
+     * State of a client connection
+     */
+    struct Connection {
+        /**
+         * @brief socket of the connection
+         */
+        int fd = -1;
+        /**
+         * @brief received bytes that were not answered yet
+         */
+        string in;
+        /**
+         * @brief responses that were not sent yet, starting at outSent
+         */
+        string out;
+        /**
+         * @brief bytes of out already sent
+         */
+        size_t outSent = 0;
+        /**
+         * @brief epoll events the connection is registered for
+         */
+        uint32_t events = 0;
+        /**
+         * @brief true when the peer closed its side, the connection is closed once out is sent
+         */
+        bool peerClosed = false;
+    };
+
+    /**
+     * @brief pending output above which a connection stops being read and its buffered requests wait
+     */
+    static const size_t HIGH_WATER = 1 << 20;
+    /**
+     * @brief bytes read from a connection per readable event
+     */
+    static const size_t READ_CHUNK = 1 << 16;
+    /**
+     * @brief events handled per call to epoll_wait
+     */
+    static const int MAX_EVENTS = 64;
+
+    /**
+     * @brief company served
+     */
+    Company &company;
+    /**
+     * @brief listening socket
+     */
+    int listenFd = -1;
+    /**
+     * @brief epoll instance
+     */
+    int epollFd = -1;
+    /**
+     * @brief connections by socket
+     */
+    unordered_map<int, Connection> connections;
+
+    /**
+     * @brief Accepts every pending connection
+     */
+    void acceptConnections();
+
+    /**
+     * @brief Reads from a connection and answers its complete requests
+     * @param c Connection &c
+     * @return false if the connection must be closed
+     */
+    bool onReadable(Connection &c);
+
+    /**
+     * @brief Sends the pending output of a connection and answers the requests that were waiting for room
+     * @param c Connection &c
+     * @return false if the connection must be closed
+     */
+    bool onWritable(Connection &c);
+
+    /**
+     * @brief Answers the complete requests of the input buffer while the output is under HIGH_WATER
+     * @param c Connection &c
+     * @return false if the peer sent an invalid frame
+     */
+    bool answerRequests(Connection &c);
+
+    /**
+     * @brief Writes the response of one request
+     * @param op uint8_t op
+     * @param request FrameReader &request (body of the request)
+     * @param tag uint32_t tag
+     * @param response FrameWriter &response
+     */
+    void answer(uint8_t op, FrameReader &request, uint32_t tag, FrameWriter &response);
+
+    /**
+     * @brief Registers the connection for reading while it is under HIGH_WATER and for writing while it has output
+     * @param c Connection &c
+     */
+    void updateEvents(Connection &c);
+
+    /**
+     * @brief Closes a connection and forgets it
+     * @param fd int fd
+     */
+    void closeConnection(int fd);
+
+public:
+    explicit BookingServer(Company &company);
+
+    ~BookingServer();
+
+    /**
+     * @brief Listens on the socket passed as argument and serves requests until SIGINT or SIGTERM
+     * @param socketPath const string &socketPath (replaced if it exists)
+     * @return int 0 on a clean stop and 1 if the socket could not be set up
+     */
+    int run(const string &socketPath);
+};
+
+#endif //__linux__
+
+#endif //AEDA_FEUP_PROJECT_BOOKINGSERVER_H
@@ -0,0 +1,121 @@
+#include "BookingStore.h"
+
+BookingStore::BookingStore(const BookingStore &s) : nextId(s.nextId.load()), shardOfId(s.shardOfId) {
+    for (size_t i = 0; i < ShardLocks::SHARDS; i++) shards[i] = s.shards[i];
+}
+
+BookingStore &BookingStore::operator=(const BookingStore &s) {
+    for (size_t i = 0; i < ShardLocks::SHARDS; i++) shards[i] = s.shards[i];
+    nextId.store(s.nextId.load());
+    shardOfId = s.shardOfId;
+    return *this;
+}
+
+BookingStore::Shard &BookingStore::shardOf(Booking *booking) {
+    return shards[ShardLocks::shardOf(booking->getPassenger()->getId())];
+}
+
+void BookingStore::insertSorted(vector<BookingId> &v, Booking *booking) {
+    unsigned int id = booking->getId();
+    if (v.empty() || v.back()->getId() < id) {
+        v.push_back(booking);
+        return;
+    }
+    auto it = upper_bound(v.begin(), v.end(), id, [](unsigned int i, const BookingId &b) { return i < b->getId(); });
+    v.insert(it, booking);
+}
+
+unsigned int BookingStore::takeId() {
+    return nextId.fetch_add(1);
+}
+
+void BookingStore::addDate(Shard &s, Booking *booking) {
+    s.dates[booking->getPassenger()->getId()].insert(booking->getFlight()->getDate());
+}
+
+void BookingStore::removeDate(Shard &s, Booking *booking) {
+    auto it = s.dates.find(booking->getPassenger()->getId());
+    if (it == s.dates.end()) return;
+    auto date = it->second.find(booking->getFlight()->getDate());
+    if (date != it->second.end()) it->second.erase(date);
+    if (it->second.empty()) s.dates.erase(it);
+}
+
+void BookingStore::insert(Booking *booking) {
+    Shard &s = shardOf(booking);
+    s.active.emplace(booking->getId(), booking);
+    {
+        lock_guard<mutex> lock(ids);
+        shardOfId[booking->getId()] = (uint8_t) ShardLocks::shardOf(booking->getPassenger()->getId());
+    }
+    addDate(s, booking);
+    // bookings made with an id of their own must not be reached by takeId
+    unsigned int next = nextId.load();
+    while (next <= booking->getId() && !nextId.compare_exchange_weak(next, booking->getId() + 1));
+}
+
+bool BookingStore::erase(Booking *booking) {
+    Shard &s = shardOf(booking);
+    auto it = s.active.find(booking->getId());
+    if (it == s.active.end() || it->second.get() != booking) return false;
+    s.active.erase(it);
+    {
+        lock_guard<mutex> lock(ids);
+        shardOfId.erase(booking->getId());
+    }
+    removeDate(s, booking);
+    return true;
+}
+
+bool BookingStore::locate(unsigned int id, size_t &shard) const {
+    lock_guard<mutex> lock(ids);
+    auto it = shardOfId.find(id);
+    if (it == shardOfId.end()) return false;
+    shard = it->second;
+    return true;
+}
+
+Booking *BookingStore::find(unsigned int id) const {
+    size_t shard;
+    return locate(id, shard) ? find(id, shard) : nullptr;
+}
+
+Booking *BookingStore::find(unsigned int id, size_t shard) const {
+    const map<unsigned int, BookingId> &active = shards[shard].active;
+    auto it = active.find(id);
+    return it == active.end() ? nullptr : (Booking *) it->second;
+}
+
+vector<Booking *> BookingStore::ofPassenger(const Passenger *passenger) const {
+    vector<Booking *> result;
+    for (auto const &b : shards[ShardLocks::shardOf(passenger->getId())].active)
+        if (b.second->getPassenger() == passenger) result.push_back(b.second);
+    return result;
+}
+
+Date BookingStore::lastReservation(const Passenger *passenger) const {
+    const Shard &s = shards[ShardLocks::shardOf(passenger->getId())];
+    auto it = s.dates.find(passenger->getId());
+    return it == s.dates.end() ? Date() : *it->second.rbegin();
+}
+
+void BookingStore::clear() {
+    for (auto &s : shards) {
+        for (auto const &b : s.active) delete (Booking *) b.second;
+        for (auto b : s.past) delete (Booking *) b;
+        s.active.clear();
+        s.past.clear();
+        s.dates.clear();
+    }
+    {
+        lock_guard<mutex> lock(ids);
+        shardOfId.clear();
+    }
+    nextId.store(0);
+}
+
+size_t BookingStore::size() const {
+    size_t n = 0;
+    for (auto const &s : shards) n += s.active.size();
+    return n;
+}
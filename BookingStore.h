@@ -0,0 +1,198 @@
+#ifndef AEDA_FEUP_PROJECT_BOOKINGSTORE_H
+#define AEDA_FEUP_PROJECT_BOOKINGSTORE_H
+
+#include <vector>
+#include <map>
+#include <set>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+#include <mutex>
+#include "Booking.h"
+#include "ShardLocks.h"
+
+using namespace std;
+
+/**
+ * Active and past bookings of the company, partitioned in the shards of ShardLocks by the id of their passenger.
+ * The bookings of a passenger are all in one shard, so a booking, a return or the tickets of a passenger only need
+ * the lock of that shard. Each shard keeps its bookings in increasing id order, and the shard of each active booking
+ * is kept by id, so a booking known only by its id is found in its shard without looking at the others. The dates of
+ * the flights booked by each passenger are counted as the bookings come and go, so the latest one is never searched.
+ */
+class BookingStore {
+
+private:
+    //! struct Shard
+    /*! Bookings of the passengers of a shard */
+    struct Shard {
+        map<unsigned int, BookingId> active; /*!< bookings of flights that did not land by id */
+        vector<BookingId> past;              /*!< bookings of flights that landed */
+        unordered_map<unsigned int, multiset<Date> > dates; /*!< dates of the flights booked by each passenger id */
+    };
+
+    /**
+     * @brief bookings of each shard
+     */
+    Shard shards[ShardLocks::SHARDS];
+    /**
+     * @brief id of the next booking, ids are never reused
+     */
+    atomic<unsigned int> nextId;
+    /**
+     * @brief shard of each active booking by id, changed by bookings of different shards at once
+     */
+    unordered_map<unsigned int, uint8_t> shardOfId;
+    /**
+     * @brief lock of shardOfId, taken with or without shards and held briefly
+     */
+    mutable mutex ids;
+
+    /**
+     * @brief Gets the shard of the passenger of a booking
+     * @param booking Booking *booking
+     * @return Shard &
+     */
+    Shard &shardOf(Booking *booking);
+
+    /**
+     * @brief Inserts a booking keeping the id order of a vector
+     * @param v vector<BookingId> &v
+     * @param booking Booking *booking
+     */
+    static void insertSorted(vector<BookingId> &v, Booking *booking);
+
+    /**
+     * @brief Counts the date of the flight of a booking for its passenger
+     * @param s Shard &s
+     * @param booking Booking *booking
+     */
+    static void addDate(Shard &s, Booking *booking);
+
+    /**
+     * @brief Stops counting the date of the flight of a booking for its passenger
+     * @param s Shard &s
+     * @param booking Booking *booking
+     */
+    static void removeDate(Shard &s, Booking *booking);
+
+public:
+    BookingStore() : nextId(0) {}
+
+    BookingStore(const BookingStore &s);
+
+    BookingStore &operator=(const BookingStore &s);
+
+    /**
+     * @brief Takes the id of a new booking, thread safe
+     * @return unsigned int
+     */
+    unsigned int takeId();
+
+    /**
+     * @brief Adds an active booking (the lock of the shard of its passenger must be held exclusive)
+     * @param booking Booking *booking
+     */
+    void insert(Booking *booking);
+
+    /**
+     * @brief Removes an active booking without deleting it
+     * @param booking Booking *booking
+     * @return true if the booking was removed and false if it was not active
+     */
+    bool erase(Booking *booking);
+
+    /**
+     * @brief Gets the shard of an active booking, thread safe (the booking may be returned before its shard is locked)
+     * @param id unsigned int id
+     * @param shard size_t &shard
+     * @return true if the booking is active and false otherwise
+     */
+    bool locate(unsigned int id, size_t &shard) const;
+
+    /**
+     * @brief Finds an active booking by id in the shard given by locate()
+     * @param id unsigned int id
+     * @return Booking *, nullptr if there is none
+     */
+    Booking *find(unsigned int id) const;
+
+    /**
+     * @brief Finds an active booking by id in one shard
+     * @param id unsigned int id
+     * @param shard size_t shard
+     * @return Booking *, nullptr if there is none
+     */
+    Booking *find(unsigned int id, size_t shard) const;
+
+    /**
+     * @brief Gets the active bookings of a passenger in id order
+     * @param passenger const Passenger *passenger
+     * @return vector<Booking *>
+     */
+    vector<Booking *> ofPassenger(const Passenger *passenger) const;
+
+    /**
+     * @brief Gets the date of the latest flight booked by a passenger, active or past
+     * @param passenger const Passenger *passenger
+     * @return Date (an empty Date if there is none)
+     */
+    Date lastReservation(const Passenger *passenger) const;
+
+    /**
+     * @brief Moves the active bookings that match a predicate to the past bookings
+     * @param landed Pred landed
+     */
+    template<class Pred>
+    void retire(Pred landed) {
+        lock_guard<mutex> lock(ids);
+        for (auto &s : shards) {
+            for (auto it = s.active.begin(); it != s.active.end();) {
+                if (landed((Booking *) it->second)) {
+                    insertSorted(s.past, it->second);
+                    shardOfId.erase(it->first);
+                    it = s.active.erase(it);
+                } else ++it;
+            }
+        }
+    }
+
+    /**
+     * @brief Deletes the bookings (active, and past if withPast is true) that match a predicate
+     * @param match Pred match
+     * @param withPast bool withPast
+     */
+    template<class Pred>
+    void eraseIf(Pred match, bool withPast) {
+        lock_guard<mutex> lock(ids);
+        for (auto &s : shards) {
+            auto matchAndDelete = [&s, &match](BookingId b) {
+                if (!match((Booking *) b)) return false;
+                removeDate(s, b);
+                delete (Booking *) b;
+                return true;
+            };
+            for (auto it = s.active.begin(); it != s.active.end();) {
+                unsigned int id = it->first;
+                if (matchAndDelete(it->second)) {
+                    shardOfId.erase(id);
+                    it = s.active.erase(it);
+                } else ++it;
+            }
+            if (withPast) s.past.erase(remove_if(s.past.begin(), s.past.end(), matchAndDelete), s.past.end());
+        }
+    }
+
+    /**
+     * @brief Deletes every booking and starts the ids again from 0
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of active bookings
+     * @return size_t
+     */
+    size_t size() const;
+};
+
+#endif //AEDA_FEUP_PROJECT_BOOKINGSTORE_H
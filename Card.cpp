@@ -1,4 +1,13 @@
 #include "Card.h"
+#include "ObjectPool.h"
+
+void *Card::operator new(size_t size) {
+    return ObjectPool<Card>::allocate(size);
+}
+
+void Card::operator delete(void *p, size_t size) {
+    ObjectPool<Card>::release(p, size);
+}
 
 int Card::getAvgYrFlights() const {
     return this->avgYrFlights;
@@ -6,7 +15,7 @@ int Card::getAvgYrFlights() const {
 
 string Card::getJob() const {
 
-    return job;
+    return job.str();
 }
 
 Card::Card(string job, int nYear = 0) {
@@ -3,13 +3,14 @@
 
 #include <iostream>
 #include <string>
+#include "Symbol.h"
 
 using namespace std;
 
 class Card {
 
 private:
-    string job;
+    Symbol job;
     int avgYrFlights = 0;
 
 public:
@@ -25,6 +26,20 @@ public:
      */
     Card(string job, int nYear);
 
+    /**
+     * @brief Allocates a Card from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a Card to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     /**
      * @brief Gets the job of the Card object
      * @return string job listed in the Card
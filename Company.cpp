@@ -1,6 +1,7 @@
 #include "Company.h"
 #include "Application.h"
 #include <queue>
+#include "ObjectPool.h"
 
 bool Company::passengersChanged = false;
 bool Company::airplanesChanged = false;
@@ -11,15 +12,17 @@ const string Company::AIRPLANE_IDENTIFIER = "airplane";
 const string Company::FLIGHT_IDENTIFIER = "flight";
 const string Company::PASSENGER_IDENTIFIER = "passenger";
 const string Company::TECHNICIAN_IDENTIFIER = "technician";
+const unsigned int Company::SEAT_HOLD_MINUTES;
+const unsigned int Company::OVERBOOKING_MARGIN;
+const string Company::ANY_SEAT = "ANY";
 
 
 Company::Company() {
 
     name = "";
     AirplanesSet a;
-    vector<Passenger *> p;
     fleet = a;
-    passengers = p;
+    setupViews();
 
 }
 
@@ -27,21 +30,24 @@ Company::Company(string name) {
 
     this->name = name;
     AirplanesSet fleet;
-    vector<Passenger *> passengers;
     this->fleet = fleet;
-    this->passengers = passengers;
+    setupViews();
 }
 
 string Company::getName() const {
     return this->name;
 }
 
-AirplanesSet Company::getFleet() const {
+const AirplanesSet &Company::getFleet() const {
     return this->fleet;
 }
 
-vector<Passenger *> Company::getPassengers() const {
-    return this->passengers;
+PassengerStore::Range Company::getPassengers() const {
+    return passengers.withStatus(PASSENGER_ACTIVE);
+}
+
+const PassengerStore &Company::getPassengerStore() const {
+    return passengers;
 }
 
 bool Company::getTechniciansChanged() const {
@@ -73,17 +79,30 @@ void Company::setFleet(AirplanesSet fleet) {
 }
 
 void Company::setPassengers(vector<Passenger *> passengers) {
-    this->passengers = passengers;
+    vector<Passenger *> inactive = this->passengers.withStatus(PASSENGER_INACTIVE).toVector();
+    this->passengers.clear();
+    for (auto const &p : passengers) this->passengers.insert(p, PASSENGER_ACTIVE);
+    for (auto const &p : inactive) this->passengers.insert(p, PASSENGER_INACTIVE);
+    passengersVersion++;
+    passengerNames.clear();
+    passengerBirths.clear();
+    SnapshotStore::Batch batch(snapshots);
+    snapshots.clearPassengers();
+    for (auto p : this->passengers.all()) {
+        passengerNames.insert(p);
+        passengerBirths.insert(p);
+        publishPassenger(p);
+    }
 }
 
 //Management methods
 
 void Company::removePassenger(Passenger *passenger) {
 
-    auto it = find(passengers.begin(), passengers.end(), passenger);
-    if (it != passengers.end()) passengers.erase(it);
-    auto ip = inactivePassengers.find(passenger);
-    if (ip != inactivePassengers.end()) inactivePassengers.erase(ip);
+    passengers.erase(passenger);
+    passengerViewsErase(passenger);
+    passengerNames.erase(passenger);
+    passengerBirths.erase(passenger);
 
 }
 
@@ -102,38 +121,645 @@ Flight *Company::flightById(unsigned int id) {
 }
 
 Passenger *Company::passengerById(unsigned int id) {
-    for (auto const &p: getAllPassengers()) {
-        if (p->getId() == id) return (Passenger *) p;
+    Passenger *p = passengers.find(id);
+    if (p == nullptr) throw InvalidPassenger(id);
+    return p;
+}
+
+Airplane *Company::airplaneById(unsigned int id) {
+    for (auto const &a: fleet) {
+        if (a->getId() == id) return a;
+    }
+    throw InvalidAirplane(id);
+}
+
+service_status_t Company::book(unsigned int passengerId, unsigned int flightId, const string &seat,
+                               unsigned int *bookingId) {
+    ShardLocks::Guard guard(shards, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+    Passenger *passenger = passengers.find(passengerId);
+    if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+    Flight *flight;
+    try {
+        flight = flightById(flightId);
+    }
+    catch (const InvalidFlight &) {
+        return SERVICE_NO_FLIGHT;
+    }
+
+    string place = "ALL";
+    bool held = false;
+    if (flight->getKind() == FLIGHT_COMMERCIAL) {
+        int index = SeatMap::index(seat, flight->getCapacity());
+        if (index < 0) return SERVICE_INVALID_SEAT;
+        place = seat;
+
+        // a seat held by the passenger is already claimed, the hold just becomes the booking
+        lock_guard<mutex> lock(shards.indexLock());
+        const SeatHolds::Hold *hold = holds.find(flightId, (uint32_t) index);
+        if (hold != nullptr) {
+            if (hold->passengerId != passengerId) return SERVICE_SEAT_HELD;
+            holds.erase(flightId, (uint32_t) index);
+            held = true;
+        }
+    }
+    if (!held && !flight->claim(place, passenger)) return SERVICE_SEAT_TAKEN;
+
+    unsigned int id = recordBooking(passenger, flight, place);
+    if (bookingId != nullptr) *bookingId = id;
+    updatePassenger(passenger);
+    return SERVICE_OK;
+}
+
+service_status_t Company::bookGroup(const vector<GroupRequest> &requests, vector<unsigned int> *bookingIds,
+                                    size_t *failed) {
+    uint32_t mask = 0;
+    for (auto const &r : requests) mask |= ShardLocks::maskOf(r.passengerId) | ShardLocks::maskOf(r.flightId);
+    ShardLocks::Guard guard(shards, mask);
+
+    // seat reserved for each request in the first phase: held is the index of a seat held by the passenger (its
+    // hold becomes the booking) and -1 for a seat claimed by the group
+    struct Reservation {
+        Passenger *passenger;
+        Flight *flight;
+        string place;
+        int held;
+        bool claimed;
+    };
+    vector<Reservation> reserved(requests.size(), Reservation{nullptr, nullptr, "", -1, false});
+
+    auto rollback = [&](service_status_t status, size_t position) {
+        for (auto const &r : reserved) {
+            if (r.claimed && r.held < 0) r.flight->release(r.place);
+        }
+        if (failed != nullptr) *failed = position;
+        return status;
+    };
+
+    // phase one: look everything up and claim the chosen seats, the seats left to choose are claimed per flight
+    vector<pair<Flight *, vector<size_t> > > any;
+    vector<Flight *> found; // a group usually books many seats of few flights, each flight is searched once
+    for (size_t i = 0; i < requests.size(); i++) {
+        const GroupRequest &request = requests[i];
+        Reservation &r = reserved[i];
+        r.passenger = passengers.find(request.passengerId);
+        if (r.passenger == nullptr) return rollback(SERVICE_NO_PASSENGER, i);
+        auto known = find_if(found.begin(), found.end(),
+                             [&request](Flight *f) { return f->getId() == request.flightId; });
+        if (known != found.end()) r.flight = *known;
+        else {
+            try {
+                r.flight = flightById(request.flightId);
+            }
+            catch (const InvalidFlight &) {
+                return rollback(SERVICE_NO_FLIGHT, i);
+            }
+            found.push_back(r.flight);
+        }
+
+        if (r.flight->getKind() != FLIGHT_COMMERCIAL) r.place = "ALL";
+        else if (request.seat == ANY_SEAT) {
+            auto it = find_if(any.begin(), any.end(),
+                              [&r](const pair<Flight *, vector<size_t> > &a) { return a.first == r.flight; });
+            if (it == any.end()) any.emplace_back(r.flight, vector<size_t>(1, i));
+            else it->second.push_back(i);
+            continue;
+        } else {
+            int index = SeatMap::index(request.seat, r.flight->getCapacity());
+            if (index < 0) return rollback(SERVICE_INVALID_SEAT, i);
+            r.place = request.seat;
+
+            lock_guard<mutex> lock(shards.indexLock());
+            const SeatHolds::Hold *hold = holds.find(request.flightId, (uint32_t) index);
+            if (hold != nullptr) {
+                if (hold->passengerId != request.passengerId) return rollback(SERVICE_SEAT_HELD, i);
+                for (size_t j = 0; j < i; j++) {
+                    if (reserved[j].flight == r.flight && reserved[j].held == index)
+                        return rollback(SERVICE_SEAT_TAKEN, i);
+                }
+                r.held = index;
+                r.claimed = true;
+                continue;
+            }
+        }
+        if (!r.flight->claim(r.place, r.passenger)) return rollback(SERVICE_SEAT_TAKEN, i);
+        r.claimed = true;
+    }
+
+    // the party of a flight sits together if it can (see SeatAllocator), in the order of the requests
+    vector<size_t> chosen;
+    for (auto const &a : any) {
+        Flight *flight = a.first;
+        if (!SeatAllocator::allocate(*flight->getSeatMap(), (unsigned int) a.second.size(), chosen))
+            return rollback(SERVICE_SEAT_TAKEN, a.second.front());
+        for (size_t j = 0; j < chosen.size(); j++) {
+            Reservation &r = reserved[a.second[j]];
+            r.place = SeatMap::name(chosen[j]);
+            if (!flight->claim(r.place, r.passenger)) return rollback(SERVICE_SEAT_TAKEN, a.second[j]);
+            r.claimed = true;
+        }
+    }
+
+    // phase two: every seat is ours, so the bookings are recorded without any failure; each flight is refreshed
+    // once and the whole group is published as one snapshot
+    SnapshotStore::Batch batch(snapshots);
+    if (bookingIds != nullptr) bookingIds->clear();
+    vector<Flight *> touched;
+    for (auto const &r : reserved) {
+        if (r.held >= 0) {
+            lock_guard<mutex> lock(shards.indexLock());
+            holds.erase(r.flight->getId(), (uint32_t) r.held);
+        }
+        unsigned int id = recordBooking(r.passenger, r.flight, r.place, false);
+        if (bookingIds != nullptr) bookingIds->push_back(id);
+        if (find(touched.begin(), touched.end(), r.flight) == touched.end()) touched.push_back(r.flight);
+    }
+    for (auto f : touched) {
+        if (f->getKind() == FLIGHT_COMMERCIAL) {
+            lock_guard<mutex> lock(shards.indexLock());
+            fares.updateFlight(f);
+        }
+        publishFlight(f);
+    }
+    unordered_set<Passenger *> updated;
+    for (auto const &r : reserved) {
+        if (updated.insert(r.passenger).second) updatePassenger(r.passenger);
+    }
+    return SERVICE_OK;
+}
+
+service_status_t Company::holdSeat(unsigned int passengerId, unsigned int flightId, const string &seat,
+                                   unsigned int minutes, int64_t *expiry) {
+    ShardLocks::Guard guard(shards, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+    Passenger *passenger = passengers.find(passengerId);
+    if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+    Flight *flight;
+    try {
+        flight = flightById(flightId);
+    }
+    catch (const InvalidFlight &) {
+        return SERVICE_NO_FLIGHT;
+    }
+    if (flight->getKind() != FLIGHT_COMMERCIAL) return SERVICE_INVALID_SEAT;
+    int index = SeatMap::index(seat, flight->getCapacity());
+    if (index < 0) return SERVICE_INVALID_SEAT;
+
+    uint64_t now = (uint64_t) Application::currentDate.convertToMinutes();
+    lock_guard<mutex> lock(shards.indexLock());
+    const SeatHolds::Hold *hold = holds.find(flightId, (uint32_t) index);
+    if (hold != nullptr && hold->passengerId != passengerId) return SERVICE_SEAT_HELD;
+    if (hold == nullptr && !flight->claim(seat, passenger)) return SERVICE_SEAT_TAKEN;
+    holds.hold(flight, (uint32_t) index, passengerId, now, now + minutes);
+    if (expiry != nullptr) *expiry = (int64_t) (now + minutes);
+    return SERVICE_OK;
+}
+
+service_status_t Company::releaseHold(unsigned int passengerId, unsigned int flightId, const string &seat) {
+    {
+        ShardLocks::Guard guard(shards, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+        Flight *flight;
+        try {
+            flight = flightById(flightId);
+        }
+        catch (const InvalidFlight &) {
+            return SERVICE_NO_FLIGHT;
+        }
+        if (flight->getKind() != FLIGHT_COMMERCIAL) return SERVICE_INVALID_SEAT;
+        int index = SeatMap::index(seat, flight->getCapacity());
+        if (index < 0) return SERVICE_INVALID_SEAT;
+
+        lock_guard<mutex> lock(shards.indexLock());
+        const SeatHolds::Hold *hold = holds.find(flightId, (uint32_t) index);
+        if (hold == nullptr || hold->passengerId != passengerId) return SERVICE_NO_HOLD;
+        holds.erase(flightId, (uint32_t) index);
+        flight->release(seat);
+    }
+    promoteWaiter(flightId, seat);
+    return SERVICE_OK;
+}
+
+service_status_t Company::joinWaitlist(unsigned int passengerId, unsigned int flightId, size_t *waiting) {
+    ShardLocks::Guard guard(shards, 0, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+    Passenger *passenger = passengers.find(passengerId);
+    if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+    Flight *flight;
+    try {
+        flight = flightById(flightId);
+    }
+    catch (const InvalidFlight &) {
+        return SERVICE_NO_FLIGHT;
+    }
+    if (flight->getKind() != FLIGHT_COMMERCIAL) return SERVICE_INVALID_SEAT;
+    // held seats count as taken, they are only waited for once their holds expire or are released
+    const SeatMap *seats = flight->getSeatMap();
+    if (seats->count() < seats->size()) return SERVICE_SEATS_LEFT;
+
+    int priority = passenger->getCard() == nullptr ? -1 : passenger->getCard()->getAvgYrFlights();
+    lock_guard<mutex> lock(shards.indexLock());
+    if (waitlist.size(flightId) >= waitlistLimit(flight) && !waitlist.contains(flightId, passengerId))
+        return SERVICE_WAITLIST_FULL;
+    waitlist.add(flightId, passengerId, priority);
+    if (waiting != nullptr) *waiting = waitlist.size(flightId);
+    return SERVICE_OK;
+}
+
+void Company::promoteWaiter(unsigned int flightId, const string &seat) {
+    Waitlist::Waiter next;
+    while (true) {
+        {
+            lock_guard<mutex> lock(shards.indexLock());
+            if (!waitlist.pop(flightId, next)) return;
+        }
+        service_status_t status = book(next.passengerId, flightId, seat);
+        // only a waiter that no longer exists is skipped, the next one may still book the seat
+        if (status == SERVICE_NO_PASSENGER) continue;
+        if (status != SERVICE_OK && status != SERVICE_NO_FLIGHT) {
+            // the seat cannot be booked (somebody else took or holds it, or it is not a seat of the flight any
+            // more), so the waiter keeps waiting in the same place
+            lock_guard<mutex> lock(shards.indexLock());
+            waitlist.restore(flightId, next);
+        }
+        return;
+    }
+}
+
+void Company::promoteWaiters(const FreedSeats &freed) {
+    for (auto const &f : freed) promoteWaiter(f.first, f.second);
+}
+
+unsigned int Company::recordBooking(Passenger *passenger, Flight *flight, const string &seat, bool refresh) {
+    if (flight->getKind() == FLIGHT_COMMERCIAL) flight->addPassenger(seat, passenger);
+    else flight->setBuyer(passenger);
+
+    unsigned int id = getNextBookingId();
+    Booking *booking;
+    {
+        lock_guard<mutex> lock(shards.indexLock());
+        if (refresh && flight->getKind() == FLIGHT_COMMERCIAL) fares.updateFlight(flight);
+        // a waiter that gets a seat of the flight some other way stops waiting
+        if (waitlist.size() != 0) waitlist.erase(flight->getId(), passenger->getId());
+        booking = new Booking(id, passenger, flight, seat);
+        flightsChanged = true;
+    }
+    bookings.insert(booking);
+    if (refresh) publishFlightSeat(flight, seat);
+    return id;
+}
+
+service_status_t Company::returnBooking(unsigned int bookingId) {
+    // the shard of the flight is only known once the booking is read in the shard of its passenger
+    unsigned int passengerId, flightId;
+    {
+        size_t shard;
+        if (!bookings.locate(bookingId, shard)) return SERVICE_NO_BOOKING;
+        ShardLocks::Guard guard(shards, 0, uint32_t(1) << shard);
+        Booking *booking = bookings.find(bookingId, shard);
+        if (booking == nullptr) return SERVICE_NO_BOOKING;
+        passengerId = booking->getPassenger()->getId();
+        flightId = booking->getFlight()->getId();
+    }
+
+    string seat;
+    {
+        ShardLocks::Guard guard(shards, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+        Booking *booking = bookings.find(bookingId, ShardLocks::shardOf(passengerId));
+        if (booking == nullptr) return SERVICE_NO_BOOKING;
+
+        Passenger *passenger = booking->getPassenger();
+        Flight *flight = booking->getFlight();
+        seat = booking->getSeat();
+        flight->release(seat);
+        bookings.erase(booking);
+        {
+            lock_guard<mutex> lock(shards.indexLock());
+            if (flight->getKind() == FLIGHT_COMMERCIAL) fares.updateFlight(flight);
+            delete booking;
+            flightsChanged = true;
+        }
+        publishFlightSeat(flight, seat);
+        updatePassenger(passenger);
+    }
+    promoteWaiter(flightId, seat);
+    return SERVICE_OK;
+}
+
+service_status_t Company::createFlight(unsigned int airplaneId, flight_type_t type, unsigned int id,
+                                       const string &departure, const string &destination, const Date &date,
+                                       const Date &duration, unsigned int basePrice) {
+    ShardLocks::Guard guard(shards, ShardLocks::ALL);
+    Airplane *airplane;
+    try {
+        airplane = airplaneById(airplaneId);
+        validFlight(id);
+    }
+    catch (const InvalidAirplane &) {
+        return SERVICE_NO_AIRPLANE;
+    }
+    catch (const InvalidFlight &) {
+        return SERVICE_DUPLICATE_ID;
+    }
+    if (!(Application::currentDate < date)) return SERVICE_PAST_DATE;
+
+    Flight *flight;
+    if (type == FLIGHT_RENTED)
+        flight = new RentedFlight(id, departure, destination, date, basePrice, duration, nullptr);
+    else
+        flight = new CommercialFlight(id, departure, destination, date, basePrice, duration);
+    flight->setCapacity(airplane->getCapacity());
+
+    try {
+        airplane->addFlight(flight);
     }
-    throw InvalidPassenger(id);
+    catch (const OverlappingFlight &) {
+        delete flight;
+        return SERVICE_OVERLAP;
+    }
+    addObject(flight);
+    // the flights stay sorted by id without a sort: the new one only moves back past the flights with greater ids
+    auto last = flights.end() - 1;
+    rotate(upper_bound(flights.begin(), last, flight, compFId), last, flights.end());
+    airplanesChanged = true;
+    return SERVICE_OK;
+}
+
+service_status_t Company::deleteFlight(unsigned int flightId) {
+    FreedSeats freed;
+    {
+        ShardLocks::Guard guard(shards, ShardLocks::ALL);
+        Flight *flight;
+        try {
+            flight = flightById(flightId);
+        }
+        catch (const InvalidFlight &) {
+            return SERVICE_NO_FLIGHT;
+        }
+
+        for (auto const &a: fleet) {
+            const vector<FlightId> &fv = a->getFlights();
+            if (find_if(fv.begin(), fv.end(), [flight](Flight *f) { return f == flight; }) == fv.end()) continue;
+            try {
+                a->removeFlight(flight);
+            }
+            catch (const ConnectionFlight &) {
+                return SERVICE_CONNECTION;
+            }
+            break;
+        }
+
+        freed = removeFlight(flight);
+        airplanesChanged = true;
+        flightsChanged = true;
+    }
+    promoteWaiters(freed);
+    return SERVICE_OK;
+}
+
+service_status_t Company::createPassenger(passenger_type_t type, unsigned int id, const string &name,
+                                          const Date &dateOfBirth, const string &job) {
+    ShardLocks::Guard guard(shards, ShardLocks::ALL);
+    if (passengers.find(id) != nullptr) return SERVICE_DUPLICATE_ID;
+
+    Passenger *passenger;
+    if (type == PASSENGER_CARD) passenger = new PassengerWithCard(id, name, dateOfBirth, job, 0);
+    else passenger = new Passenger(id, name, dateOfBirth);
+    addObject(passenger);
+    passengersChanged = true;
+    passengers.sortLast(PASSENGER_ACTIVE, compPID);
+    updatePassenger(passenger);
+    return SERVICE_OK;
+}
+
+service_status_t Company::deletePassenger(unsigned int passengerId) {
+    // the seats of the passenger go to the waiters of their flights once every shard is unlocked
+    FreedSeats freed;
+    {
+        ShardLocks::Guard guard(shards, ShardLocks::ALL);
+        Passenger *passenger = passengers.find(passengerId);
+        if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+
+        if (waitlist.size() != 0) {
+            for (auto const b : bookings.ofPassenger(passenger)) {
+                if (b->getFlight()->getKind() == FLIGHT_COMMERCIAL)
+                    freed.emplace_back(b->getFlight()->getId(), b->getSeat());
+            }
+            waitlist.erasePassenger(passengerId);
+        }
+        removePassengerFromFlights(passenger);
+        removePassengerFromBookings(passenger);
+        removePassenger(passenger);
+        delete passenger;
+        passengersChanged = true;
+        FreedSeats expired = updateTime();
+        freed.insert(freed.end(), expired.begin(), expired.end());
+    }
+    promoteWaiters(freed);
+    return SERVICE_OK;
+}
+
+service_status_t Company::performMaintenance(unsigned int airplaneId, Technician **technician) {
+    ShardLocks::Guard guard(shards, ShardLocks::ALL);
+    Airplane *airplane;
+    Technician *tech;
+    try {
+        airplane = airplaneById(airplaneId);
+        tech = chooseTechnician(airplane->getModel());
+    }
+    catch (const InvalidAirplane &) {
+        return SERVICE_NO_AIRPLANE;
+    }
+    catch (const UnavailableTechnician &) {
+        return SERVICE_NO_TECHNICIAN;
+    }
+
+    techRemovefromQueue(tech);
+    Date d = {0, 0, 0, 5, 0};
+    d = d + tech->getTimeWhenAvailable();
+    tech->setTimeWhenAvailable(d);
+    technicians.push(tech);
+    removeAirplane(airplane);
+    Date date = airplane->getMaintenance();
+    date = date + airplane->getMaintenancePeriod();
+    airplane->setMaintenance(date);
+    addObject(airplane);
+    airplanesChanged = true;
+    if (technician != nullptr) *technician = tech;
+    return SERVICE_OK;
+}
+
+void Company::advanceClock(const Date &period) {
+    FreedSeats freed;
+    {
+        ShardLocks::Guard guard(shards, ShardLocks::ALL);
+        Date next = Application::currentDate;
+        next.year += period.year;
+        next.month += period.month;
+        next.day += period.day;
+        next.hour += period.hour;
+        next.minute += period.minute;
+        Application::currentDate = next;
+        freed = updateTime();
+    }
+    promoteWaiters(freed);
+}
+
+void Company::advanceClock(unsigned int minutes) {
+    Date period;
+    period.minute = (int) minutes;
+    advanceClock(period);
+}
+
+vector<Flight *> Company::searchFlights(const string &departure, const string &destination) {
+    ShardLocks::Guard guard(shards, 0, ShardLocks::ALL);
+    // the cities are looked up without interning them, so concurrent searches only read the SymbolTable
+    uint32_t from = departure.empty() ? 0 : SymbolTable::find(SymbolTable::normalizedText(departure));
+    uint32_t to = destination.empty() ? 0 : SymbolTable::find(SymbolTable::normalizedText(destination));
+    if (from == SymbolTable::NONE || to == SymbolTable::NONE) return vector<Flight *>();
+    vector<uint8_t> commercial, rented;
+    FlightTable::selectAvailable(FLIGHT_COMMERCIAL, commercial);
+    FlightTable::selectAvailable(FLIGHT_RENTED, rented);
+
+    vector<Flight *> result;
+    for (auto const &f: flights) {
+        uint32_t slot = f->getHandleSlot();
+        if (!commercial[slot] && !rented[slot]) continue;
+        if (!departure.empty() && f->getDepartureSymbol().normalized().getId() != from) continue;
+        if (!destination.empty() && f->getDestinationSymbol().normalized().getId() != to) continue;
+        result.push_back(f);
+    }
+    return result;
+}
+
+service_status_t Company::quote(unsigned int passengerId, unsigned int flightId, int64_t &cents) {
+    ShardLocks::Guard guard(shards, 0, ShardLocks::maskOf(passengerId) | ShardLocks::maskOf(flightId));
+    Passenger *passenger = passengers.find(passengerId);
+    if (passenger == nullptr) return SERVICE_NO_PASSENGER;
+    try {
+        cents = pricing.priceOne(passenger, flightById(flightId), Application::currentDate.convertToMinutes());
+    }
+    catch (const InvalidFlight &) {
+        return SERVICE_NO_FLIGHT;
+    }
+    return SERVICE_OK;
+}
+
+string Company::describe(service_status_t status) {
+    switch (status) {
+        case SERVICE_OK:
+            return "ok";
+        case SERVICE_NO_PASSENGER:
+            return "no such passenger";
+        case SERVICE_NO_FLIGHT:
+            return "no such flight";
+        case SERVICE_NO_BOOKING:
+            return "no such booking";
+        case SERVICE_NO_AIRPLANE:
+            return "no such airplane";
+        case SERVICE_NO_TECHNICIAN:
+            return "no available technician";
+        case SERVICE_INVALID_SEAT:
+            return "invalid seat";
+        case SERVICE_SEAT_TAKEN:
+            return "seat already taken";
+        case SERVICE_DUPLICATE_ID:
+            return "id already in use";
+        case SERVICE_PAST_DATE:
+            return "date is not in the future";
+        case SERVICE_OVERLAP:
+            return "flight overlaps another flight of the airplane";
+        case SERVICE_CONNECTION:
+            return "flight connects two other flights";
+        case SERVICE_SEAT_HELD:
+            return "seat held by another passenger";
+        case SERVICE_NO_HOLD:
+            return "seat not held by the passenger";
+        case SERVICE_SEATS_LEFT:
+            return "flight still has free seats";
+        case SERVICE_WAITLIST_FULL:
+            return "waitlist of the flight is full";
+    }
+    return "unknown status";
 }
 
 void Company::printSummaryPassenger() {
 
+    // the summary is read from a snapshot, so concurrent bookings neither wait for it nor change it halfway
+    SnapshotStore::Reader snapshot(snapshots);
+    const RowTable<PassengerRow> &active = *snapshot->active;
+    const RowTable<PassengerRow> &inactive = *snapshot->inactive;
+
     cout << "PASSENGER SUMMARY\n\n";
-    if (getAllPassengers().empty()) cout << "No passengers to display.\n";
+    if (active.empty() && inactive.empty()) cout << "No passengers to display.\n";
     else {
         cout << std::left;
         cout << setw(12) << "Passenger ID" << setw(3) << " " << setw(30) << "Name" << setw(3) << " " << setw(13)
              << "Date of Birth\n";
 
         cout << "ACTIVE PASSENGERS\n";
-        if (passengers.empty()) cout << "There are no active passengers.\n";
-        else for (auto &passenger : passengers) passenger->printSummary();
-        if (passengers.empty()) cout << "There are no inactive passengers.\n\n";
+        if (active.empty()) cout << "There are no active passengers.\n";
+        else for (auto const &row : active) cout << row.summary;
+        if (active.empty()) cout << "There are no inactive passengers.\n\n";
         else {
             cout << "INACTIVE PASSENGERS\n";
 
-            if (getIncPassengers().empty())
+            if (inactive.empty())
                 cout << "There are no inactive passengers.\n";
             else
-                for (auto &passenger : getIncPassengers()) passenger->printSummary();
+                for (auto const &row : inactive) cout << row.summary;
 
         }
     }
     cout << endl;
 }
 
+vector<Passenger *> Company::searchPassengers(string query, size_t limit) const {
+    // the name index changes with the passengers, which lock every shard
+    ShardLocks::Guard guard(shards, 0, ShardLocks::ALL);
+    vector<Passenger *> result = passengerNames.prefix(query, limit);
+    if (result.empty()) result = passengerNames.substring(query, limit);
+    if (result.empty()) result = passengerNames.fuzzy(query, limit);
+    return result;
+}
+
+void Company::passengerSearch() {
+
+    if (passengers.empty()) {
+        cout << "There are no passengers.\n";
+        return;
+    }
+
+    string query;
+    do {
+        cout << "Insert the name (or part of the name) to search: ";
+        if (!validString(query)) continue;
+        else break;
+
+    } while (true);
+
+    vector<Passenger *> found = searchPassengers(query);
+    if (found.empty()) {
+        cout << "No passengers match '" << query << "'.\n";
+        return;
+    }
+
+    cout << found.size() << " passenger(s) found:\n";
+    cout << std::left;
+    cout << setw(12) << "Passenger ID" << setw(3) << " " << setw(30) << "Name" << setw(3) << " " << setw(13)
+         << "Date of Birth\n";
+    for (auto &passenger : found) passenger->printSummary();
+    cout << endl;
+}
+
+int Company::countPassengersBornBetween(Date from, Date to) const {
+    return passengerBirths.count(from, to);
+}
+
+vector<Passenger *> Company::getPassengersBornBetween(Date from, Date to) const {
+    return passengerBirths.list(from, to);
+}
+
+vector<int> Company::getAgeHistogram(int width, int groups) const {
+    return passengerBirths.ageHistogram(Application::currentDate, width, groups);
+}
+
 Passenger *Company::choosePassenger() {
 
     int pId;
@@ -144,12 +770,8 @@ Passenger *Company::choosePassenger() {
 
     } while (true);
 
-    for (auto &passenger : getAllPassengers()) {
-
-        if (passenger->getId() == pId) {
-            return passenger;
-        }
-    }
+    Passenger *passenger = passengers.find((unsigned int) pId);
+    if (passenger != nullptr) return passenger;
 
     throw InvalidPassenger(pId);
 }
@@ -225,7 +847,7 @@ void Company::printMaintenancePeriod() {
 
 void Company::passengerShow() {
 
-    if (getAllPassengers().empty()) {
+    if (passengers.empty()) {
         cout << "There are no passengers.\n";
         return;
     }
@@ -269,12 +891,7 @@ void Company::passengerShow() {
 
 void Company::validPassenger(int id) {
 
-    for (auto &passenger : getAllPassengers()) {
-
-        if (passenger->getId() == id)
-            throw InvalidPassenger(id);
-
-    }
+    if (passengers.find((unsigned int) id) != nullptr) throw InvalidPassenger(id);
 }
 
 Passenger *Company::passengerCreate() {
@@ -338,10 +955,7 @@ Passenger *Company::passengerCreate() {
 
     } while (true);
 
-    Passenger *newpassenger;
-
-    if (foo == "n") newpassenger = new Passenger(id, name, dobd);
-    else if (foo == "c") {
+    if (foo == "c") {
 
         do {
             cout << "Job: ";
@@ -350,20 +964,15 @@ Passenger *Company::passengerCreate() {
 
         } while (true);
         trimString(job);
-
-        newpassenger = new PassengerWithCard(id, name, dobd, job, 0);
     }
-    addObject(newpassenger);
-    passengersChanged = true;
-    this->sortPassengers();
-    updatePassengers();
+    createPassenger(foo == "c" ? PASSENGER_CARD : PASSENGER_REGULAR, id, name, dobd, job);
     cout << "Passenger successfully added\n";
-    return newpassenger;
+    return passengers.find(id);
 }
 
 void Company::passengerDelete() {
 
-    if (getAllPassengers().empty()) {
+    if (passengers.empty()) {
         cout << "There are no passengers.\n";
         return;
     }
@@ -381,12 +990,8 @@ void Company::passengerDelete() {
         break;
 
     } while (true);
-    removePassengerFromFlights(passenger);
-    removePassengerFromBookings(passenger);
-    removePassenger(passenger);
+    deletePassenger(passenger->getId());
     cout << "Passenger deleted successfully.\n ";
-    passengersChanged = true;
-    updateTime();
 
 }
 
@@ -402,6 +1007,8 @@ void Company::passengerUpdateName(Passenger *passenger) {
 
     } while (true);
     passenger->setName(newName);
+    passengerViewsKey(passenger, PNAME);
+    passengerNames.update(passenger);
     passengersChanged = true;
     cout << "Passenger name updated successfully.\n";
 
@@ -420,6 +1027,8 @@ void Company::passengerUpdateDateOfBirth(Passenger *passenger) {
 
     } while (true);
     passenger->setDateOfBirth(dobd);
+    passengerViewsKey(passenger, PAGE);
+    passengerBirths.update(passenger);
     passengersChanged = true;
     cout << "Passenger date of birth updated successfully.\n";
 }
@@ -439,6 +1048,7 @@ void Company::passengerUpdateJob(Passenger *passenger) {
 
     } while (true);
     card->setJob(newJob);
+    publishPassenger(passenger);
     passengersChanged = true;
     cout << "Passenger job updated successfully.\n";
 
@@ -459,6 +1069,7 @@ void Company::passengerUpdateNYear(Passenger *passenger) {
     } while (true);
 
     card->setAvgyrFlights(newN);
+    publishPassenger(passenger);
     passengersChanged = true;
     cout << "Passenger number of flights/year updated successfully.\n";
 
@@ -726,26 +1337,12 @@ void Company::airplanePerformMaintenance() {
 
     Technician *tech;
 
-    try {
-        tech = chooseTechnician(airplane->getModel());
-    }
-    catch (const UnavailableTechnician &t) {
-        t.print();
+    if (performMaintenance(airplane->getId(), &tech) == SERVICE_NO_TECHNICIAN) {
+        UnavailableTechnician(airplane->getModel()).print();
         return;
     }
 
-    techRemovefromQueue(tech);
-    Date d = {0, 0, 0, 5, 0};
-    d = d + tech->getTimeWhenAvailable();
-    tech->setTimeWhenAvailable(d);
-    technicians.push(tech);
-    removeAirplane(airplane);
     Date date = airplane->getMaintenance();
-    date = date + airplane->getMaintenancePeriod();
-    //addTime(date, airplane->getMaintenancePeriod());
-    airplane->setMaintenance(date);
-    addObject(airplane);
-    airplanesChanged = true;
     cout << "Maintenance session started successfully. Finished in 5 hours\n";
     cout << "Technician: Id-" << tech->getId() << " Name-" << tech->getName() << endl;
     cout << "Next maintenance session is scheduled to " << date.day << "/" << date.month << "/" << date.year << endl;
@@ -754,10 +1351,10 @@ void Company::airplanePerformMaintenance() {
 
 Technician *Company::chooseTechnician(string model) {
     techniciansPriorityQueue temp = technicians;
+    Symbol wanted(model);
 
     while (!temp.empty()) {
-        vector<string> aux = temp.top()->getModels();
-        if (find(aux.begin(), aux.end(), model) != aux.end()) {
+        if (temp.top()->hasModel(wanted)) {
             if (temp.top()->getTimeWhenAvailable() == Application::currentDate)
                 return temp.top();
         }
@@ -845,54 +1442,67 @@ void Company::bookFlight(Passenger *p) {
         }
     } while (true);
     cout << endl;
-    updateTime();
+    promoteWaiters(updateTime());
 }
 
-float Company::ticketPrice(Passenger *p, Flight *f, string type) {
-    float price;
-    Date priceDropDate;
-    priceDropDate.hour = 48;
-    priceDropDate.normalize();
-    if (p->getType() == "c") {
-        if (type == "r") {
-            price = f->getBasePrice() * (100 - p->getCard()->getAvgYrFlights()) / 100;
-        } else {
-            if (f->getPassengers().size() < f->getCapacity() && f->getTimeToFlight() < priceDropDate) {
-                price = 0.9 * f->getBasePrice() * (100 - p->getCard()->getAvgYrFlights()) / 100;
-            } else {
-                price = f->getBasePrice() * (100 - p->getCard()->getAvgYrFlights()) / 100;
-            }
-        }
+float Company::ticketPrice(Passenger *p, Flight *f) {
+    int64_t cents = pricing.priceOne(p, f, Application::currentDate.convertToMinutes());
+    return cents / 100.0f;
+}
 
-    } else {
-        if (type == "r") {
-            price = f->getBasePrice();
-        }
-        if (type == "c") {
-            if (f->getPassengers().size() < f->getCapacity() && f->getTimeToFlight() < priceDropDate) {
-                price = 0.9 * f->getBasePrice();
+void Company::printFareCalendar() {
 
-            } else {
-                price = f->getBasePrice();
-            }
+    string departure, destination, month;
+    int m, y;
+
+    do {
+        cout << "City of departure: ";
+        if (validString(departure)) break;
+    } while (true);
+
+    do {
+        cout << "City of arrival: ";
+        if (validString(destination)) break;
+    } while (true);
+
+    do {
+        cout << "Month (MM/YYYY): ";
+        if (!validString(month)) continue;
+        try {
+            next(m, month, "/");
+            next(y, month, "/");
+        } catch (InvalidFormat &i) {
+            cout << "Invalid input. Reenter.\n";
+            continue;
         }
-    }
+        if (m >= 1 && m <= 12) break;
+        cout << "Invalid input. Reenter.\n";
+    } while (true);
+
+    vector<FareDay> days = fares.month(departure, destination, m, y, 0);
 
-    price = trunc(round(price * 100.0)) / 100.0;
-    return price;
+    cout << "Fare calendar " << departure << " - " << destination << ":\n";
+    cout << std::left;
+    cout << setw(10) << "Day" << setw(3) << " " << setw(9) << "Flight ID" << setw(3) << " " << setw(10)
+         << "Price(€)" << endl;
+    for (auto const &d : days) {
+        cout << setw(10) << Date(y, m, d.day, 0, 0).print() << setw(3) << " ";
+        if (d.flight == nullptr) cout << "No flights.";
+        else
+            cout << setw(9) << d.flight->getId() << setw(3) << " " << setw(10) << std::fixed << setprecision(2)
+                 << d.cents / 100.0;
+        cout << endl;
+    }
 }
 
 vector<Flight *> Company::getFlightsWithType(string type) {
     vector<Flight *> f;
+    if (type != "c" && type != "r") return f;
 
-    if (type == "c")
-        for (auto const &fl: this->flights) {
-            if (fl->getType() == type && fl->getPassengers().size() < fl->getCapacity()) f.push_back(fl);
-        }
-    else if (type == "r")
-        for (auto const &fl: this->flights) {
-            if (fl->getType() == type && fl->getBuyer() == nullptr) f.push_back(fl);
-        }
+    vector<uint8_t> available;
+    FlightTable::selectAvailable(type == "c" ? FLIGHT_COMMERCIAL : FLIGHT_RENTED, available);
+    for (auto const &fl: this->flights)
+        if (available[fl->getHandleSlot()]) f.push_back(fl);
     return f;
 
 }
@@ -901,6 +1511,10 @@ vector<Flight *> Company::getFlightsWithType(string type) {
 void Company::printFlightsByType(Passenger *p, string type, vector<Flight *> &fvector) {
 
     if (!fvector.empty()) {
+        vector<int64_t> prices;
+        pricing.load(fvector, Application::currentDate.convertToMinutes());
+        pricing.price(PricingEngine::cardDiscount(p), prices);
+
         cout << std::left;
         cout << setw(9) << "Flight ID" << setw(3) << " " << setw(15) << "Departure" << setw(3) << " " << setw(15)
              << "Destination" << setw(3) << " " << setw(18) << "Time to flight(h)"
@@ -908,12 +1522,13 @@ void Company::printFlightsByType(Passenger *p, string type, vector<Flight *> &fv
         if (type == "c") cout << std::left << setw(3) << " " << setw(20) << "Occupancy";
         cout << endl;
 
-        for (auto const &fl: fvector) {
+        for (size_t i = 0; i < fvector.size(); i++) {
+            Flight *fl = fvector[i];
             cout << std::left;
             cout << setw(9) << fl->getId() << setw(3) << " " << setw(15) << fl->getDeparture() << setw(3) << " "
                  << setw(15) << fl->getDestination() << setw(3) << " " << setw(18) << fl->getDate().printFullDate()
                  << setw(3) << " " << setw(10) << std::fixed
-                 << setprecision(2) << ticketPrice(p, fl, type);
+                 << setprecision(2) << prices[i] / 100.0;
             if (type == "c")
                 cout << std::left << setw(3) << " " << setw(20)
                      << to_string(fl->getPassengers().size()) + "/" + to_string(fl->getCapacity());
@@ -952,12 +1567,10 @@ void Company::bookFlightWithType(Passenger *p, string type) {
     if (type == "c")
         flightAddPassenger(flight, p);
     else {
-        flight->setBuyer(p);
-        bookings.push_back(new Booking(getNextBookingId(), p, flight, "ALL"));
+        book(p->getId(), flight->getId(), "ALL");
         cout << "You have rented the flight " << id << ".\n";
     }
-    flightsChanged = true;
-    updateTime();
+    promoteWaiters(updateTime());
 }
 
 void Company::returnTicket(Passenger *p) {
@@ -974,34 +1587,20 @@ void Company::returnTicket(Passenger *p) {
     id--;
     auto selectedTicket = v.at(id);
 
-    for (auto bit = bookings.begin(); bit != bookings.end(); bit++) {
-        if ((*bit)->getSeat() == selectedTicket.first &&
-            (*bit)->getFlight()->getId() == selectedTicket.second->getId()) {
-            bookings.erase(bit);
+    for (auto const &b: bookings.ofPassenger(p)) {
+        if (b->getSeat() == selectedTicket.first && b->getFlight()->getId() == selectedTicket.second->getId()) {
+            returnBooking(b->getId());
             break;
         }
     }
 
-    if (selectedTicket.second->getType() == "c") {
-
-        auto it = selectedTicket.second->getPassengers().find(selectedTicket.first);
-
-        selectedTicket.second->getPassengers().erase(it);
-
+    if (selectedTicket.second->getKind() == FLIGHT_COMMERCIAL)
         cout << "Your ticket for seat " << selectedTicket.first << " from ";
-
-    } else {
-
-        selectedTicket.second->setBuyer(nullptr);
-
+    else
         cout << "Your full reservation of";
 
-    }
-
-    flightsChanged = true;
-
     cout << " Flight " << selectedTicket.second->getId() << " was successfully removed.\n";
-    updateTime();
+    promoteWaiters(updateTime());
 
 }
 
@@ -1179,7 +1778,6 @@ void Company::flightCreate(Airplane *airplane) {
 
     string departure, destination, foo;
     int price, id;
-    Flight *flight;
     Date date, duration;
 
     while (true) {
@@ -1252,28 +1850,12 @@ void Company::flightCreate(Airplane *airplane) {
     } while (true);
 
 
-    if (foo == "r") {
-
-        flight = new RentedFlight(id, departure, destination, date, price, duration, nullptr);
-
-    } else
-        flight = new CommercialFlight(id, departure, destination, date, price, duration);
-
-    flight->setCapacity(airplane->getCapacity());
-
-    try {
-
-        airplane->addFlight(flight);
-        addObject(flight);
-
-    } catch (const OverlappingFlight &f) {
-
-        f.print();
+    if (createFlight(airplane->getId(), foo == "r" ? FLIGHT_RENTED : FLIGHT_COMMERCIAL, id, departure, destination,
+                     date, duration, price) == SERVICE_OVERLAP) {
+        OverlappingFlight().print();
         return;
     }
 
-    sortFlights();
-    airplanesChanged = true;
     cout << "Flight added successfully\n";
 
 }
@@ -1304,19 +1886,12 @@ void Company::flightDelete(Airplane *airplane) {
 
     } while (true);
 
-    try {
-        airplane->removeFlight(flight);
-    }
-    catch (const ConnectionFlight &f) {
-        f.print();
+    if (deleteFlight(flight->getId()) == SERVICE_CONNECTION) {
+        ConnectionFlight().print();
         return;
     }
 
-    removeFlight(flight);
-
     cout << "Flight deleted sucessfully.\n";
-    airplanesChanged = true;
-    flightsChanged = true;
 }
 
 
@@ -1332,6 +1907,8 @@ void Company::flightUpdatePrice(Flight *flight) {
     } while (true);
 
     flight->setBasePrice(newPrice);
+    fares.updateFlight(flight);
+    flightViewsKey(flight, FPRICEL);
     flightsChanged = true;
     cout << "Flight base price updated successfully.\n";
 }
@@ -1339,55 +1916,36 @@ void Company::flightUpdatePrice(Flight *flight) {
 vector<string> Company::availableSeats(Flight *flight, unsigned int capacity) {
 
     vector<string> seats;
-    string line;
-    string place;
-    PassengerMap &passengers = flight->getPassengers();
-
-    for (size_t i = 0; i < capacity / 6; i++) {
-
-
-        line = to_string(i + 1);
-
-        for (size_t j = 0; j < 6; j++) {
-
-            string seat = "A";
-
-            seat.at(0) += j;
-
-
-            place = line + seat;
-
-            if (flight->getPassengers().empty()) {
-
-                seats.push_back(place);
-                continue;
-            }
+    const SeatMap *taken = flight->getSeatMap();
 
-            if (passengers.find(place) != passengers.end()) {
-                continue;
-            } else {
-                seats.push_back(place);
-            }
+    // the seat map has the seats of the passengers, of the holds and of the claims not recorded yet, a row at a time
+    for (size_t i = 0; i < capacity / SeatMap::ROW_SEATS; i++) {
+        uint32_t row = taken == nullptr ? 0 : taken->rowMask(i);
+        for (size_t j = 0; j < SeatMap::ROW_SEATS; j++) {
+            if (!((row >> j) & 1)) seats.push_back(SeatMap::name(i * SeatMap::ROW_SEATS + j));
         }
     }
 
-
     return seats;
 }
 
 
+bool Company::validSeat(const string &seat, unsigned int capacity) {
+    return SeatMap::index(seat, capacity) >= 0;
+}
+
 void Company::printSeats(unsigned int capacity, vector<string> seats) {
 
     string na = "N/A";
 
     string line;
 
-    for (size_t i = 0; i < capacity / 6; i++) {
+    for (size_t i = 0; i < capacity / SeatMap::ROW_SEATS; i++) {
 
 
         line = to_string(i + 1);
 
-        for (size_t j = 0; j < 6; j++) {
+        for (size_t j = 0; j < SeatMap::ROW_SEATS; j++) {
 
             string seat = "A";
 
@@ -1425,23 +1983,16 @@ string Company::chooseSeat(vector<string> seats) {
 
 void Company::flightAddPassenger(Flight *flight, Passenger *passenger) {
     vector<string> seats;
-    unsigned int capacity;
+    unsigned int capacity = flight->getCapacity();
     string seat;
 
-    for (auto const &a : fleet) {
-        for (auto const &f : a->getFlights()) {
-            if (*f == *flight) {
-                capacity = a->getCapacity();
-            }
-        }
-    }
-
     cout << "Available seats: \n";
 
     seats = availableSeats(flight, capacity);
 
     if (seats.empty()) {
         cout << "There are no available seats.\n";
+        offerWaitlist(flight, passenger);
         return;
     }
 
@@ -1456,29 +2007,65 @@ void Company::flightAddPassenger(Flight *flight, Passenger *passenger) {
             continue;
         }
 
+        // the seat is held while it is booked, so a concurrent booking of the server cannot take it in between
+        if (holdSeat(passenger->getId(), flight->getId(), seat) != SERVICE_OK) {
+            cout << "Seat " << seat << " was just taken.\n";
+            seats.erase(find(seats.begin(), seats.end(), seat));
+            if (seats.empty()) {
+                cout << "There are no available seats.\n";
+                offerWaitlist(flight, passenger);
+                return;
+            }
+            continue;
+        }
+
         break;
 
     } while (true);
-    flight->addPassenger(seat, passenger);
-    bookings.push_back(new Booking(getNextBookingId(), passenger, flight, seat));
+    book(passenger->getId(), flight->getId(), seat);
     cout << "Booking for seat " << seat << " on flight " << flight->getId() << " successful.\n";
-    flightsChanged = true;
+}
+
+void Company::offerWaitlist(Flight *flight, Passenger *passenger) {
+    {
+        lock_guard<mutex> lock(shards.indexLock());
+        if (waitlist.contains(flight->getId(), passenger->getId())) {
+            cout << "The passenger is already on the waitlist of this flight.\n";
+            return;
+        }
+        if (waitlist.size(flight->getId()) >= waitlistLimit(flight)) return;
+    }
+
+    string answer;
+    do {
+        cout << "Do you wish to join the waitlist of this flight (Y/N)?: ";
+        if (!validString(answer)) continue;
+        else break;
+
+    } while (true);
+
+    normalize(answer);
+    if (answer != "y") return;
+    size_t waiting = 0;
+    service_status_t status = joinWaitlist(passenger->getId(), flight->getId(), &waiting);
+    if (status == SERVICE_OK)
+        cout << "Added to the waitlist of flight " << flight->getId() << " (" << waiting
+             << " waiting), the first seat freed will be booked automatically.\n";
+    else cout << "Could not join the waitlist: " << describe(status) << ".\n";
 }
 
 vector<pair<string, Flight *> > Company::getTickets(Passenger *p) {
+    ShardLocks::Guard guard(shards, 0, ShardLocks::maskOf(p->getId()));
     vector<pair<string, Flight *> > tickets;
 
-    for_each(bookings.begin(), bookings.end(), [p, &tickets](Booking *b) {
-        if (b->getPassenger()->getId() == p->getId())
-            tickets.emplace_back(b->getSeat(), b->getFlight());
-    });
+    for (auto const &b: bookings.ofPassenger(p)) tickets.emplace_back(b->getSeat(), b->getFlight());
 
     return tickets;
 
 }
 
 void Company::sortPassengers() {
-    sort(passengers.begin(), passengers.end(), compPID);
+    passengers.sort(PASSENGER_ACTIVE, compPID);
 }
 
 void Company::passengerCreateWrapper() {
@@ -1492,13 +2079,59 @@ void Company::sortFlights() {
 
 void Company::clearData(string identifier) {
 
+    SnapshotStore::Batch batch(snapshots);
     if (identifier == Company::PASSENGER_IDENTIFIER) {
+        // the flights and bookings must not keep pointers to the deleted passengers, and the seats of the flights are
+        // rebuilt from their (now empty) passengers, which also drops the seats of the holds
+        holds.clear();
+        waitlist.clear();
+        for (auto f : flights) {
+            f->setPassengers(PassengerMap());
+            f->setBuyer(nullptr);
+            fares.updateFlight(f);
+            publishFlight(f);
+        }
+        for (auto f : pastFlights) {
+            f->setPassengers(PassengerMap());
+            f->setBuyer(nullptr);
+        }
+        bookings.clear();
+        flightsVersion++;
+
+        vector<Passenger *> old = passengers.all().toVector();
         passengers.clear();
-        inactivePassengers.clear();
+        passengerNames.clear();
+        passengerBirths.clear();
+        passengersVersion++;
+        snapshots.clearPassengers();
+        for (auto p : old) delete p;
+        ObjectPool<Passenger>::trim();
+        ObjectPool<PassengerWithCard>::trim();
+        ObjectPool<Card>::trim();
+        ObjectPool<Booking>::trim();
     } else if (identifier == Company::FLIGHT_IDENTIFIER) {
+        holds.clear();
+        waitlist.clear();
+        bookings.clear();
+        for (auto a : fleet) a->setFlights(vector<FlightId>());
+        for (auto f : flights) delete f;
+        for (auto f : pastFlights) delete f;
         flights.clear();
+        fares.clear();
+        flightsVersion++;
+        snapshots.clearFlights();
         pastFlights.clear();
+        ObjectPool<CommercialFlight>::trim();
+        ObjectPool<RentedFlight>::trim();
+        ObjectPool<Booking>::trim();
     } else if (identifier == Company::AIRPLANE_IDENTIFIER) fleet.clear();
+    else if (identifier == Company::TECHNICIAN_IDENTIFIER) {
+        while (!technicians.empty()) {
+            delete technicians.top();
+            technicians.pop();
+        }
+        ObjectPool<Technician>::trim();
+    }
 
 }
 
@@ -1507,26 +2140,34 @@ void Company::showAllTicketsWrapper(Passenger *p) {
 }
 
 void Company::addObject(Passenger *passenger) {
-    this->passengers.push_back(passenger);
+    if (!passengers.insert(passenger)) return;
+    passengerViewsInsert(passenger);
+    passengerNames.insert(passenger);
+    passengerBirths.insert(passenger);
 }
 
 void Company::addObject(Flight *flight) {
     this->flights.push_back(flight);
+    fares.addFlight(flight);
+    flightViewsInsert(flight);
 }
 
 void Company::addObject(Airplane *airplane) {
     this->fleet.insert(airplane);
 }
 
-void Company::removeFlight(Flight *flight) {
+FreedSeats Company::removeFlight(Flight *flight) {
 
-    bookings.erase(
-            remove_if(bookings.begin(), bookings.end(), [flight](Booking *b) { return b->getFlight() == flight; }),
-            bookings.end());
+    bookings.eraseIf([flight](Booking *b) { return b->getFlight() == flight; }, false);
+    holds.eraseFlight(flight->getId());
+    waitlist.eraseFlight(flight->getId());
 
     auto it = find(flights.begin(), flights.end(), flight);
     if (it != flights.end()) flights.erase(it);
-    updateTime();
+    fares.removeFlight(flight);
+    flightViewsErase(flight);
+    delete flight;
+    return updateTime();
 
 }
 
@@ -1604,9 +2245,12 @@ void Company::removePassengerFromFlights(Passenger *passenger) {
 
     for (auto &f : flights) {
 
+        unsigned int before = FlightTable::getOccupancy(f->getHandleSlot());
         f->removePassenger(passenger);
+        if (FlightTable::getOccupancy(f->getHandleSlot()) != before) publishFlight(f);
 
     }
+    for (auto &f : pastFlights) f->removePassenger(passenger);
 }
 
 
@@ -1671,7 +2315,7 @@ void Company::technicianCreate() {
 
 }
 
-techniciansPriorityQueue Company::getTechnicians() const {
+const techniciansPriorityQueue &Company::getTechnicians() const {
     return technicians;
 }
 
@@ -1780,6 +2424,7 @@ void Company::technicianDelete() {
 
 
     techRemovefromQueue(technician);
+    delete technician;
     cout << "Technician deleted sucessfully.\n ";
     techniciansChanged = true;
 
@@ -1812,9 +2457,7 @@ void Company::technicianAddModel(Technician *technician) {
 
     } while (true);
 
-    vector<string> models = technician->getModels();
-    models.push_back(newModel);
-    technician->setModels(models);
+    technician->addModel(newModel);
     techniciansChanged = true;
     cout << "Technician new model added successfully.\n";
 
@@ -1831,19 +2474,10 @@ void Company::technicianDeleteModel(Technician *technician) {
 
     } while (true);
 
-    vector<string> models = technician->getModels();
-    bool found = false;
-    for (unsigned int i = 0; i < models.size(); i++) {
-        if (models.at(i) == model) {
-            models.erase(models.begin() + i);
-            found = true;
-            techniciansChanged = true;
-            cout << "Technician model removed successfully.\n";
-            break;
-        }
-    }
-    if (found) technician->setModels(models);
-    else cout << "Technician model was not found.\n";
+    if (technician->removeModel(model)) {
+        techniciansChanged = true;
+        cout << "Technician model removed successfully.\n";
+    } else cout << "Technician model was not found.\n";
 }
 
 void Company::addObject(Technician *technician) {
@@ -1858,26 +2492,16 @@ void Company::setFlag() {
 }
 
 unsigned int Company::getNextBookingId() {
-    unsigned int id = 0;
-    if (!bookings.empty()) {
-        size_t idx = bookings.size() - 1;
-        id = bookings.at(idx)->getId() + 1;
-    }
-    if (!pastBookings.empty()) {
-        size_t idx = pastBookings.size() - 1;
-        unsigned int newId = pastBookings.at(idx)->getId();
-        if (newId >= id) id = newId + 1;
-    }
-    return id;
+    return bookings.takeId();
 }
 
 void Company::addBooking(Booking *booking) {
-    bookings.push_back(booking);
+    bookings.insert(booking);
 }
 
 void Company::addBookingsFromFlight(Flight *flight) {
-    if (flight->getType() == "c") {
-        auto pm = flight->getPassengers();
+    if (flight->getKind() == FLIGHT_COMMERCIAL) {
+        const PassengerMap &pm = flight->getPassengers();
         if (!pm.empty()) {
             for (auto const &b: pm) this->addBooking(new Booking(getNextBookingId(), b.second, flight, b.first));
 
@@ -1889,72 +2513,93 @@ void Company::addBookingsFromFlight(Flight *flight) {
 }
 
 void Company::addInactivePassenger(Passenger *passenger) {
-    inactivePassengers.insert(passenger);
+    passengers.setStatus(passenger, PASSENGER_INACTIVE);
 }
 
 void Company::removeInactivePassenger(Passenger *passenger) {
-    auto it = inactivePassengers.find(passenger);
-    if (it != inactivePassengers.end()) inactivePassengers.erase(it);
+    passengers.setStatus(passenger, PASSENGER_ACTIVE);
 }
 
 bool Company::pastFlight(Flight *f) {
-    return ((f->getDate() + f->getDuration()) < Application::currentDate);
+    return FlightTable::getArrival(f->getHandleSlot()) < Application::currentDate.convertToMinutes();
 }
 
 void Company::updateFlights() {
+    vector<uint8_t> landed;
+    FlightTable::selectLanded(Application::currentDate.convertToMinutes(), landed);
     vector<Flight *> activeFlights;
     for (auto const &f: flights) {
-        if (pastFlight(f)) pastFlights.push_back(f);
-        else activeFlights.push_back(f);
+        if (landed[f->getHandleSlot()]) {
+            if (holds.size() != 0) holds.eraseFlight(f->getId());
+            if (waitlist.size() != 0) waitlist.eraseFlight(f->getId());
+            pastFlights.push_back(f);
+            fares.removeFlight(f);
+            flightViewsErase(f);
+        } else activeFlights.push_back(f);
     }
     this->flights = activeFlights;
 }
 
-void Company::updateBookings() {
-    vector<Booking *> activeBookings;
-    for (auto const &b: bookings) {
-        if (pastFlight(b->getFlight())) pastBookings.push_back(b);
-        else activeBookings.push_back(b);
+FreedSeats Company::expireHolds() {
+    FreedSeats freed;
+    vector<SeatHolds::Hold> expired;
+    {
+        lock_guard<mutex> lock(shards.indexLock());
+        holds.expire((uint64_t) Application::currentDate.convertToMinutes(), expired);
+    }
+    for (auto const &h : expired) {
+        string seat = SeatMap::name(h.seat);
+        // a hold only expires if its seat was not booked meanwhile
+        if (h.flight->getPassengers().find(seat) != h.flight->getPassengers().end()) continue;
+        h.flight->release(seat);
+        if (waitlist.size() != 0) freed.emplace_back(h.flight->getId(), seat);
     }
-    this->bookings = activeBookings;
+    return freed;
+}
+
+void Company::updateBookings() {
+    bookings.retire([this](Booking *b) { return pastFlight(b->getFlight()); });
 }
 
 void Company::updatePassengers() {
     vector<Passenger *> activeToInactive;
     vector<Passenger *> inactiveToActive;
-    for (auto const &p: passengers) {
+    for (auto p: passengers.withStatus(PASSENGER_ACTIVE)) {
         if (inactivePassenger(p)) activeToInactive.push_back(p);
     }
-    for (auto const &p: inactivePassengers) {
+    for (auto p: passengers.withStatus(PASSENGER_INACTIVE)) {
         if (!inactivePassenger(p)) inactiveToActive.push_back(p);
     }
     for (auto const &p: activeToInactive) {
         this->addInactivePassenger(p);
-        passengers.erase(find(passengers.begin(), passengers.end(), p));
+        passengerViewsStatus(p, false);
     }
     for (auto const &p: inactiveToActive) {
-        passengers.push_back(p);
         this->removeInactivePassenger(p);
+        passengerViewsStatus(p, true);
     }
 }
 
-void Company::updateTime() {
+void Company::updatePassenger(Passenger *p) {
+    bool active = !inactivePassenger(p);
+    lock_guard<mutex> lock(shards.indexLock());
+    if (passengers.setStatus(p, active ? PASSENGER_ACTIVE : PASSENGER_INACTIVE)) passengerViewsStatus(p, active);
+}
+
+FreedSeats Company::updateTime() {
+    SnapshotStore::Batch batch(snapshots);
+    FreedSeats freed = expireHolds();
     updateFlights();
     updateBookings();
     updatePassengers();
     updateAirplanesDate();
     updateTechniciansDate();
+    fares.refresh(Application::currentDate.convertToMinutes());
+    return freed;
 }
 
 Date Company::getLastReservation(Passenger *p) {
-    Date d;
-    for (auto const &b: bookings)
-        if (b->getPassenger() == p && b->getFlight()->getDate() > d) d = b->getFlight()->getDate();
-
-    for (auto const &b: pastBookings)
-        if (b->getPassenger() == p && b->getFlight()->getDate() > d) d = b->getFlight()->getDate();
-
-    return d;
+    return bookings.lastReservation(p);
 }
 
 bool Company::inactivePassenger(Passenger *p) {
@@ -1963,27 +2608,146 @@ bool Company::inactivePassenger(Passenger *p) {
     return (getLastReservation(p) - Application::currentDate) > inactivePeriod;
 }
 
-vector<Passenger *> Company::getAllPassengers() {
-    vector<Passenger *> pass;
-    for (auto const &p: passengers) pass.push_back(p);
-    for (auto const &p: inactivePassengers) pass.push_back(p);
-    return pass;
+vector<Passenger *> Company::getAllPassengers() const {
+    return passengers.all().toVector();
 }
 
 void Company::removePassengerFromBookings(Passenger *passenger) {
-    bookings.erase(remove_if(bookings.begin(), bookings.end(),
-                             [passenger](Booking *b) { return b->getPassenger() == passenger; }), bookings.end());
+    bookings.eraseIf([passenger](Booking *b) { return b->getPassenger() == passenger; }, true);
 
 }
 
-vector<Passenger *> Company::getIncPassengers() {
-    vector<Passenger *> pass;
-    for (auto const &p: inactivePassengers) pass.push_back(p);
+vector<Passenger *> Company::getIncPassengers() const {
+    vector<Passenger *> pass = passengers.withStatus(PASSENGER_INACTIVE).toVector();
     if (!pass.empty())
         sort(pass.begin(), pass.end(), compPID);
     return pass;
 }
 
+void Company::setupViews() {
+    passengerViews.clear();
+    passengerViews.emplace(PID, SortedView<Passenger>(compPID, keyPID));
+    passengerViews.emplace(PNAME, SortedView<Passenger>(compPNAME, keyPNAME));
+    passengerViews.emplace(PAGE, SortedView<Passenger>(compPAGE, keyPAGE));
+    passengerViews.emplace(PACT, SortedView<Passenger>(compPID, keyPID));
+    passengerViews.emplace(PINC, SortedView<Passenger>(compPID, keyPID));
+
+    flightViews.clear();
+    flightViews.emplace(FID, SortedView<Flight>(compFId, keyFId));
+    flightViews.emplace(FPRICEL, SortedView<Flight>(compFPriceL, keyFPrice));
+    flightViews.emplace(FDEST, SortedView<Flight>(compFDest, keyFDest));
+    flightViews.emplace(FTIME, SortedView<Flight>(compFTime, keyFTime));
+}
+
+const vector<Passenger *> &Company::getSortedPassengers(type t) {
+    SortedView<Passenger> &view = passengerViews.at(t);
+    if (!view.current(passengersVersion)) {
+        if (t == PACT) view.rebuild(passengers.withStatus(PASSENGER_ACTIVE).toVector(), passengersVersion);
+        else if (t == PINC) view.rebuild(passengers.withStatus(PASSENGER_INACTIVE).toVector(), passengersVersion);
+        else view.rebuild(getAllPassengers(), passengersVersion);
+    }
+    return view.get();
+}
+
+const vector<Flight *> &Company::getSortedFlights(type t) {
+    if (t == FPRICEH) t = FPRICEL;
+    SortedView<Flight> &view = flightViews.at(t);
+    if (!view.current(flightsVersion)) view.rebuild(flights, flightsVersion);
+    return view.get();
+}
+
+vector<Passenger *> Company::getPassengersPage(type t, size_t page, size_t pageSize) {
+    SortedView<Passenger> &view = passengerViews.at(t);
+    if (view.current(passengersVersion)) return slicePage(view.get(), page, pageSize);
+
+    vector<Passenger *> source;
+    if (t == PACT) source = passengers.withStatus(PASSENGER_ACTIVE).toVector();
+    else if (t == PINC) source = passengers.withStatus(PASSENGER_INACTIVE).toVector();
+    else source = getAllPassengers();
+    return selectPage(source, view.getCompare(), page, pageSize);
+}
+
+vector<Flight *> Company::getFlightsPage(type t, size_t page, size_t pageSize) {
+    SortedView<Flight> &view = flightViews.at(t == FPRICEH ? FPRICEL : t);
+    if (t == FPRICEH) {
+        if (view.current(flightsVersion)) return sliceReversedPage(view.get(), page, pageSize);
+        return selectPage(flights, compFPriceH, page, pageSize);
+    }
+    if (view.current(flightsVersion)) return slicePage(view.get(), page, pageSize);
+    return selectPage(flights, view.getCompare(), page, pageSize);
+}
+
+void Company::passengerViewsInsert(Passenger *passenger) {
+    unsigned int from = passengersVersion++;
+    for (auto &v : passengerViews) {
+        if (v.first == PINC) v.second.touch(from, passengersVersion);
+        else v.second.insert(passenger, from, passengersVersion);
+    }
+    publishPassenger(passenger);
+}
+
+void Company::passengerViewsErase(Passenger *passenger) {
+    unsigned int from = passengersVersion++;
+    for (auto &v : passengerViews) v.second.erase(passenger, from, passengersVersion);
+    snapshots.erasePassenger(passenger->getId());
+}
+
+void Company::passengerViewsStatus(Passenger *passenger, bool active) {
+    unsigned int from = passengersVersion++;
+    for (auto &v : passengerViews) {
+        if (v.first == PACT) {
+            if (active) v.second.insert(passenger, from, passengersVersion);
+            else v.second.erase(passenger, from, passengersVersion);
+        } else if (v.first == PINC) {
+            if (active) v.second.erase(passenger, from, passengersVersion);
+            else v.second.insert(passenger, from, passengersVersion);
+        } else v.second.touch(from, passengersVersion);
+    }
+    snapshots.putPassenger(passenger, active);
+}
+
+void Company::passengerViewsKey(Passenger *passenger, type t) {
+    unsigned int from = passengersVersion++;
+    for (auto &v : passengerViews) {
+        if (v.first == t) v.second.reposition(passenger, from, passengersVersion);
+        else v.second.touch(from, passengersVersion);
+    }
+    publishPassenger(passenger);
+}
+
+void Company::flightViewsInsert(Flight *flight) {
+    unsigned int from = flightsVersion++;
+    for (auto &v : flightViews) v.second.insert(flight, from, flightsVersion);
+    publishFlight(flight);
+}
+
+void Company::flightViewsErase(Flight *flight) {
+    unsigned int from = flightsVersion++;
+    for (auto &v : flightViews) v.second.erase(flight, from, flightsVersion);
+    snapshots.eraseFlight(flight->getId());
+}
+
+void Company::flightViewsKey(Flight *flight, type t) {
+    unsigned int from = flightsVersion++;
+    for (auto &v : flightViews) {
+        if (v.first == t) v.second.reposition(flight, from, flightsVersion);
+        else v.second.touch(from, flightsVersion);
+    }
+    publishFlight(flight);
+}
+
+void Company::publishPassenger(Passenger *passenger) {
+    snapshots.putPassenger(passenger, passengers.getStatus(passenger) == PASSENGER_ACTIVE);
+}
+
+void Company::publishFlight(Flight *flight) {
+    snapshots.putFlight(flight);
+}
+
+void Company::publishFlightSeat(Flight *flight, const string &seat) {
+    snapshots.putFlightSeat(flight, seat);
+}
+
 void Company::updateAirplanesDate() {
 
     vector<Airplane *> airplanes;
@@ -15,6 +15,18 @@
 #include "exceptions.h"
 #include "Airplane.h"
 #include "Technician.h"
+#include "PricingEngine.h"
+#include "FareCalendar.h"
+#include "SortedView.h"
+#include "NameIndex.h"
+#include "BirthIndex.h"
+#include "PassengerStore.h"
+#include "BookingStore.h"
+#include "ShardLocks.h"
+#include "Snapshot.h"
+#include "SeatHolds.h"
+#include "SeatAllocator.h"
+#include "Waitlist.h"
 #include <queue>
 #include <cmath>
 #include <unordered_set>
@@ -40,19 +52,44 @@ struct TechnicianCompare {
 
 typedef std::set<Airplane *, AirplaneCompare> AirplanesSet;
 
-struct InactivePassengerHash {
-    int operator()(const Passenger *p1) const {
-        return static_cast<int>(hash<int>()(p1->getId()));
-    }
+typedef priority_queue<Technician *, vector<Technician *>, TechnicianCompare> techniciansPriorityQueue;
 
-    bool operator()(const Passenger *p1, const Passenger *p2) const {
-        return p1->getId() == p2->getId();
-    }
-};
+typedef map<type, SortedView<Passenger> > PassengerViews;
 
-typedef unordered_set<Passenger *, InactivePassengerHash, InactivePassengerHash> inactivePassengersHT;
+typedef map<type, SortedView<Flight> > FlightViews;
 
-typedef priority_queue<Technician *, vector<Technician *>, TechnicianCompare> techniciansPriorityQueue;
+/**
+ * seats freed by the Company (flight id and seat name) that go to the waiters of their flights once no shard is locked
+ */
+typedef vector<pair<unsigned int, string> > FreedSeats;
+
+/*! result of the non-interactive operations of the Company (service API) */
+enum service_status_t {
+    SERVICE_OK = 0,             /*!< operation done */
+    SERVICE_NO_PASSENGER = 1,   /*!< there is no passenger with the id */
+    SERVICE_NO_FLIGHT = 2,      /*!< there is no future flight with the id */
+    SERVICE_NO_BOOKING = 3,     /*!< there is no active booking with the id */
+    SERVICE_NO_AIRPLANE = 4,    /*!< there is no airplane with the id */
+    SERVICE_NO_TECHNICIAN = 5,  /*!< no technician of the airplane model is available */
+    SERVICE_INVALID_SEAT = 6,   /*!< the seat does not exist on the flight */
+    SERVICE_SEAT_TAKEN = 7,     /*!< the seat (or the whole rented flight) is already sold */
+    SERVICE_DUPLICATE_ID = 8,   /*!< the id is already used */
+    SERVICE_PAST_DATE = 9,      /*!< the date is not after the current date */
+    SERVICE_OVERLAP = 10,       /*!< the flight overlaps another flight of the airplane */
+    SERVICE_CONNECTION = 11,    /*!< the flight cannot be removed from its airplane */
+    SERVICE_SEAT_HELD = 12,     /*!< the seat is held by another passenger */
+    SERVICE_NO_HOLD = 13,       /*!< the passenger does not hold the seat */
+    SERVICE_SEATS_LEFT = 14,    /*!< the flight still has free seats, so there is nothing to wait for */
+    SERVICE_WAITLIST_FULL = 15  /*!< the waitlist of the flight is as long as the overbooking margin allows */
+};
+
+//! struct GroupRequest
+/*! One seat of a group booking (see Company::bookGroup) */
+struct GroupRequest {
+    unsigned int passengerId; /*!< passenger of the seat */
+    unsigned int flightId;    /*!< flight of the seat */
+    string seat;              /*!< seat, Company::ANY_SEAT for any seat next to the group, ignored for a rented flight */
+};
 
 /**
 *	The Company class is the one that countains all the passengers, airplanes and flights information
@@ -71,9 +108,9 @@ private:
     */
     AirplanesSet fleet;
     /**
-    * @brief vector with pointers to all the Passengers of the company
+    * @brief store with all the Passengers of the company, active and inactive
     */
-    vector<Passenger *> passengers;
+    PassengerStore passengers;
     /**
      * @brief vector with pointers to all the Flights of the company
      */
@@ -87,17 +124,61 @@ private:
      */
     techniciansPriorityQueue technicians;
     /**
-     * @brief vector with pointers to all of the Bookings of the company
+     * @brief active and past Bookings of the company, sharded by passenger
      */
-    vector<Booking *> bookings;
+    BookingStore bookings;
     /**
-     * @brief vector with pointers to all of the past Bookings of the company
+     * @brief locks of the shards of passengers, flights and bookings used by the service API
      */
-    vector<Booking *> pastBookings;
+    mutable ShardLocks shards;
     /**
-     * @brief Hash Table that holds all the inactive Passengers of the company
+     * @brief snapshots of the passengers and flights read by the reports and the saves without locking
      */
-    inactivePassengersHT inactivePassengers;
+    SnapshotStore snapshots;
+    /**
+     * @brief seats held before their booking, guarded by the index lock of the shards
+     */
+    SeatHolds holds;
+    /**
+     * @brief passengers waiting for a seat of a full flight, guarded by the index lock of the shards
+     */
+    Waitlist waitlist;
+    /**
+     * @brief waiters a full flight accepts, in percent of its capacity
+     */
+    unsigned int overbookingMargin = OVERBOOKING_MARGIN;
+    /**
+     * @brief Engine used to price the flights shown to the passengers
+     */
+    PricingEngine pricing;
+    /**
+     * @brief Cheapest fare per day of every route of the company
+     */
+    FareCalendar fares;
+    /**
+     * @brief Sorted views of the passengers used by the lists menu, one per passenger list order
+     */
+    PassengerViews passengerViews;
+    /**
+     * @brief Sorted views of the flights used by the lists menu, one per flight list order
+     */
+    FlightViews flightViews;
+    /**
+     * @brief Name search index of all the passengers of the company
+     */
+    NameIndex passengerNames;
+    /**
+     * @brief Birth day index of all the passengers of the company
+     */
+    BirthIndex passengerBirths;
+    /**
+     * @brief Version of the passenger containers, incremented on every change
+     */
+    unsigned int passengersVersion = 0;
+    /**
+     * @brief Version of the flights vector, incremented on every change
+     */
+    unsigned int flightsVersion = 0;
     /**
     * @brief bool passengersChanged is true when Passengers vector has changed and false otherwise
     */
@@ -144,6 +225,18 @@ public:
      * @brief identifier for a Technician
      */
     static const string TECHNICIAN_IDENTIFIER;
+    /**
+     * @brief default time to live of a seat hold, in minutes
+     */
+    static const unsigned int SEAT_HOLD_MINUTES = 15;
+    /**
+     * @brief default overbooking margin, the waiters a full flight accepts in percent of its capacity
+     */
+    static const unsigned int OVERBOOKING_MARGIN = 10;
+    /**
+     * @brief seat of a GroupRequest that lets the group booking choose the seat
+     */
+    static const string ANY_SEAT;
 
     //get methods
     /**
@@ -153,22 +246,28 @@ public:
     string getName() const;
 
     /**
-    * @brief Gets the fleet of the company
-    * @return vector <Airplane*> with the pointers to the Airplanes of the company
+    * @brief Gets the fleet of the company, without copying it
+    * @return const AirplanesSet & with the pointers to the Airplanes of the company
+    */
+    const AirplanesSet &getFleet() const;
+
+    /**
+    * @brief Gets a view of the active passengers of the company, without copying them
+    * @return PassengerStore::Range with the active Passengers of the company
     */
-    AirplanesSet getFleet() const;
+    PassengerStore::Range getPassengers() const;
 
     /**
-    * @brief Gets a vector of pointers to the passengers of the company
-    * @return vector <Passenger*> with the pointers to the Passengers of the company
+    * @brief Gets the store with all the passengers of the company
+    * @return const PassengerStore&
     */
-    vector<Passenger *> getPassengers() const;
+    const PassengerStore &getPassengerStore() const;
 
     /**
-     * @brief Gets the priority queue with all the technicians in the Company object
-     * @return techniciansPriorityQueue
+     * @brief Gets the priority queue with all the technicians in the Company object, without copying it
+     * @return const techniciansPriorityQueue &
      */
-    techniciansPriorityQueue getTechnicians() const;
+    const techniciansPriorityQueue &getTechnicians() const;
 
     /**
      * @brief Gets if the priority queue of technicians has changed or not
@@ -239,11 +338,196 @@ public:
     */
     Passenger *passengerById(unsigned int id);
 
+    /**
+    * @brief Searches the fleet for the passed argument id and return pointer to the desired Airplane object
+    * @param id unsigned int id
+    * @return Airplane * pointer to the Airplane object
+    */
+    Airplane *airplaneById(unsigned int id);
+
+    /**
+     * @brief Books a seat of a commercial flight, or the whole of a rented flight, without any input or output
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param seat const string &seat (ignored for a rented flight)
+     * @param bookingId unsigned int *bookingId (if not null, gets the id of the new Booking)
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT, SERVICE_SEAT_TAKEN or
+     * SERVICE_SEAT_HELD (a seat held by the passenger is booked and its hold removed)
+     */
+    service_status_t book(unsigned int passengerId, unsigned int flightId, const string &seat,
+                          unsigned int *bookingId = nullptr);
+
+    /**
+     * @brief Books the seats of a group, possibly on several flights, all or nothing. Every seat is claimed first
+     * (the shards of all the passengers and flights are locked in increasing order, so concurrent groups never
+     * deadlock); if one of them cannot be claimed, the claimed ones are released and nothing is booked
+     * @param requests const vector<GroupRequest> &requests
+     * @param bookingIds vector<unsigned int> *bookingIds (if not null, gets the ids of the new Bookings in the order
+     * of the requests)
+     * @param failed size_t *failed (if not null and the group is not booked, gets the position of the request that
+     * failed)
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT, SERVICE_SEAT_TAKEN or
+     * SERVICE_SEAT_HELD
+     */
+    service_status_t bookGroup(const vector<GroupRequest> &requests, vector<unsigned int> *bookingIds = nullptr,
+                               size_t *failed = nullptr);
+
+    /**
+     * @brief Holds a seat of a commercial flight for a passenger, so nobody else can book it until the hold expires,
+     * is released or becomes a booking. Holding a seat already held by the same passenger moves its expiry
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param seat const string &seat
+     * @param minutes unsigned int minutes (time to live of the hold)
+     * @param expiry int64_t *expiry (if not null, gets the minute of the expiry, Date::convertToMinutes)
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT, SERVICE_SEAT_TAKEN or
+     * SERVICE_SEAT_HELD
+     */
+    service_status_t holdSeat(unsigned int passengerId, unsigned int flightId, const string &seat,
+                              unsigned int minutes = SEAT_HOLD_MINUTES, int64_t *expiry = nullptr);
+
+    /**
+     * @brief Releases a seat held by a passenger before its expiry
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param seat const string &seat
+     * @return SERVICE_OK, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT or SERVICE_NO_HOLD
+     */
+    service_status_t releaseHold(unsigned int passengerId, unsigned int flightId, const string &seat);
+
+    /**
+     * @brief Adds a passenger to the waitlist of a full commercial flight. A seat freed by a returned booking, a
+     * released hold or a deleted passenger is booked for the next waiter: card holders first, by their avgYrFlights,
+     * and then in the order of the requests. Waiting again for the same flight keeps the place in the waitlist
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param waiting size_t *waiting (if not null, gets the number of waiters of the flight)
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER, SERVICE_NO_FLIGHT, SERVICE_INVALID_SEAT (rented flight),
+     * SERVICE_SEATS_LEFT or SERVICE_WAITLIST_FULL
+     */
+    service_status_t joinWaitlist(unsigned int passengerId, unsigned int flightId, size_t *waiting = nullptr);
+
+    /**
+     * @brief Sets the overbooking margin
+     * @param percent unsigned int percent (waiters a full flight accepts, in percent of its capacity)
+     */
+    void setOverbookingMargin(unsigned int percent) { overbookingMargin = percent; }
+
+    /**
+     * @brief Gets the overbooking margin
+     * @return unsigned int percent of the capacity of a flight
+     */
+    unsigned int getOverbookingMargin() const { return overbookingMargin; }
+
+    /**
+     * @brief Records a Booking of a seat already claimed with Flight::claim, adding the passenger to the flight
+     * @param passenger Passenger *passenger
+     * @param flight Flight *flight
+     * @param seat const string &seat ("ALL" for a rented flight)
+     * @param refresh bool refresh (if false, the caller updates the fare calendar and publishes the flight once all
+     * its bookings are recorded)
+     * @return unsigned int id of the new Booking
+     */
+    unsigned int recordBooking(Passenger *passenger, Flight *flight, const string &seat, bool refresh = true);
+
+    /**
+     * @brief Returns an active Booking, freeing its seat (or its rented flight), without any input or output
+     * @param bookingId unsigned int bookingId
+     * @return SERVICE_OK or SERVICE_NO_BOOKING
+     */
+    service_status_t returnBooking(unsigned int bookingId);
+
+    /**
+     * @brief Creates a Flight on an Airplane without any input or output
+     * @param airplaneId unsigned int airplaneId
+     * @param type flight_type_t type
+     * @param id unsigned int id of the new Flight
+     * @param departure const string &departure
+     * @param destination const string &destination
+     * @param date const Date &date
+     * @param duration const Date &duration
+     * @param basePrice unsigned int basePrice
+     * @return SERVICE_OK, SERVICE_NO_AIRPLANE, SERVICE_DUPLICATE_ID, SERVICE_PAST_DATE or SERVICE_OVERLAP
+     */
+    service_status_t createFlight(unsigned int airplaneId, flight_type_t type, unsigned int id, const string &departure,
+                                  const string &destination, const Date &date, const Date &duration,
+                                  unsigned int basePrice);
+
+    /**
+     * @brief Deletes a future Flight and its bookings without any input or output
+     * @param flightId unsigned int flightId
+     * @return SERVICE_OK, SERVICE_NO_FLIGHT or SERVICE_CONNECTION
+     */
+    service_status_t deleteFlight(unsigned int flightId);
+
+    /**
+     * @brief Creates a Passenger without any input or output
+     * @param type passenger_type_t type (PASSENGER_CARD also creates the Card)
+     * @param id unsigned int id
+     * @param name const string &name
+     * @param dateOfBirth const Date &dateOfBirth
+     * @param job const string &job (only used with a card)
+     * @return SERVICE_OK or SERVICE_DUPLICATE_ID
+     */
+    service_status_t createPassenger(passenger_type_t type, unsigned int id, const string &name,
+                                     const Date &dateOfBirth, const string &job = "");
+
+    /**
+     * @brief Deletes a Passenger, its tickets and its bookings without any input or output
+     * @param passengerId unsigned int passengerId
+     * @return SERVICE_OK or SERVICE_NO_PASSENGER
+     */
+    service_status_t deletePassenger(unsigned int passengerId);
+
+    /**
+     * @brief Starts the maintenance of an Airplane with the first available Technician of its model
+     * @param airplaneId unsigned int airplaneId
+     * @param technician Technician **technician (if not null, gets the Technician assigned to the session)
+     * @return SERVICE_OK, SERVICE_NO_AIRPLANE or SERVICE_NO_TECHNICIAN
+     */
+    service_status_t performMaintenance(unsigned int airplaneId, Technician **technician = nullptr);
+
+    /**
+     * @brief Advances the current date and updates flights, bookings, passengers, airplanes and technicians
+     * @param period const Date &period
+     */
+    void advanceClock(const Date &period);
+
+    /**
+     * @brief Advances the current date by the minutes passed as argument (see advanceClock(const Date &))
+     * @param minutes unsigned int minutes
+     */
+    void advanceClock(unsigned int minutes);
+
+    /**
+     * @brief Gets the future flights of a route that can still be sold, without any input or output
+     * @param departure const string &departure (empty matches any city, compared normalized)
+     * @param destination const string &destination (empty matches any city, compared normalized)
+     * @return vector<Flight *>
+     */
+    vector<Flight *> searchFlights(const string &departure, const string &destination);
+
+    /**
+     * @brief Gets the price of a ticket of a Flight for a Passenger at the current date, without any input or output
+     * @param passengerId unsigned int passengerId
+     * @param flightId unsigned int flightId
+     * @param cents int64_t &cents
+     * @return SERVICE_OK, SERVICE_NO_PASSENGER or SERVICE_NO_FLIGHT
+     */
+    service_status_t quote(unsigned int passengerId, unsigned int flightId, int64_t &cents);
+
+    /**
+     * @brief Gets a short description of a service_status_t
+     * @param status service_status_t status
+     * @return string
+     */
+    static string describe(service_status_t status);
+
     /**
     * @brief Gets the flights of the Company
     * @return vector<Flight *> flights of the Company object
     */
-    vector<Flight *> getFlights() const { return flights; }
+    const vector<Flight *> &getFlights() const { return flights; }
 
     /**
    * @brief Prints the total information of a desired Passenger
@@ -265,6 +549,44 @@ public:
  */
     void printSummaryPassenger();
 
+    /**
+     * @brief Gets the passengers matching a name query: prefix matches, or substring matches if there are none,
+     * or similar names if there are neither
+     * @param query string query
+     * @param limit size_t maximum number of results (0 for no limit)
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> searchPassengers(string query, size_t limit = 0) const;
+
+    /**
+     * @brief Asks the user for a name and prints a summary of the passengers that match it
+     */
+    void passengerSearch();
+
+    /**
+     * @brief Counts the passengers born between the dates passed as argument (both inclusive)
+     * @param from Date from
+     * @param to Date to
+     * @return int
+     */
+    int countPassengersBornBetween(Date from, Date to) const;
+
+    /**
+     * @brief Gets the passengers born between the dates passed as argument (both inclusive), oldest first
+     * @param from Date from
+     * @param to Date to
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> getPassengersBornBetween(Date from, Date to) const;
+
+    /**
+     * @brief Counts the passengers of each age group at the current date
+     * @param width int number of years of each group
+     * @param groups int number of groups, the last one also counts every older passenger
+     * @return vector<int>
+     */
+    vector<int> getAgeHistogram(int width, int groups) const;
+
     /**
      * @brief Searches the passengers vector for the id inserted by the user and returns the pretended Passenger
      * @return Passenger*
@@ -423,6 +745,14 @@ public:
     */
     void flightAddPassenger(Flight *flight, Passenger *passenger);
 
+    /**
+    * @brief Offers the Passenger passed as argument a place in the waitlist of the full Flight passed as argument, if
+    * it still has room
+    * @param flight Flight* flight
+    * @param passenger Passenger* passenger
+    */
+    void offerWaitlist(Flight *flight, Passenger *passenger);
+
     /**
     * @brief Returns the seat chosen by the user on the Flight passed as argument
     * @param vector <string> seats
@@ -438,6 +768,14 @@ public:
     */
     vector<string> availableSeats(Flight *flight, unsigned int capacity);
 
+    /**
+    * @brief Checks if a seat (row number followed by a letter from A to F) exists on a Flight with the capacity passed
+    * @param seat const string &seat
+    * @param capacity unsigned int capacity
+    * @return true if the seat exists and false otherwise
+    */
+    static bool validSeat(const string &seat, unsigned int capacity);
+
     /**
     * @brief Prints the seats on the screen to show the User a more graphic layout of the seats avaiable on the Flight
     * @param capacity unsigned int capacity
@@ -458,6 +796,37 @@ public:
     */
     vector<pair<string, Flight *> > getTickets(Passenger *p);
 
+    /**
+     * @brief Gets the number of active bookings
+     * @return size_t
+     */
+    size_t getBookingCount() const { return bookings.size(); }
+
+    /**
+     * @brief Gets the snapshots of the company, read with SnapshotStore::Reader
+     * @return SnapshotStore &
+     */
+    SnapshotStore &getSnapshots() { return snapshots; }
+
+    /**
+     * @brief Publishes the current state of a passenger to the snapshots
+     * @param passenger Passenger *passenger
+     */
+    void publishPassenger(Passenger *passenger);
+
+    /**
+     * @brief Publishes the current state of a flight to the snapshots
+     * @param flight Flight *flight
+     */
+    void publishFlight(Flight *flight);
+
+    /**
+     * @brief Publishes a flight in which only the passenger of one seat changed, rendering only its seat row
+     * @param flight Flight *flight
+     * @param seat const string &seat
+     */
+    void publishFlightSeat(Flight *flight, const string &seat);
+
     /**
     * @brief Auxiliar function that manages the buying of a ticket
     * @param p Passenger *p
@@ -488,13 +857,17 @@ public:
     Flight *chooseFlight(unsigned int id, vector<Flight *> &fvector);
 
     /**
-    * @brief Calculates and returns the ticket price based on the Passenger, Flight and the type passed as argument
+    * @brief Calculates and returns the ticket price based on the Passenger and Flight passed as argument
     * @param p Passenger *p
     * @param f Flight *f
-    * @param type string type
     * @return float
     */
-    float ticketPrice(Passenger *p, Flight *f, string type);
+    float ticketPrice(Passenger *p, Flight *f);
+
+    /**
+     * @brief Prints the cheapest fare of each day of a month for a route inserted by the user
+     */
+    void printFareCalendar();
 
     /**
     * @brief Gets a vector of flights based on just the type of the Flight (commercial or rented) to let the user pick the one he wants afterwards
@@ -551,8 +924,9 @@ public:
     /**
      * @brief Removes form the vector flights the flight passed as argument
      * @param flight Flight * flight
+     * @return FreedSeats seats of other flights freed by the update of the time (see updateTime)
      */
-    void removeFlight(Flight *flight);
+    FreedSeats removeFlight(Flight *flight);
 
     /**
      * @brief Prints time restrictions to ensure connection flights
@@ -666,13 +1040,13 @@ public:
     void addBookingsFromFlight(Flight *flight);
 
     /**
-     * @brief Adds a Passenger * to the Hash Table of inactive passengers of the class Company
+     * @brief Marks the Passenger * passed as argument as inactive
      * @param passenger Passenger* passenger
      */
     void addInactivePassenger(Passenger *passenger);
 
     /**
-     * @brief Removes the desired Passenger passed as parameter from the inactivePassengers hash table
+     * @brief Marks the Passenger * passed as argument as active
      * @param passenger Passenger * passenger
      */
     void removeInactivePassenger(Passenger *passenger);
@@ -700,8 +1074,39 @@ public:
 
     /**
      *  @brief Update the Time of the program
+     *  @return FreedSeats seats freed by expired holds, for promoteWaiters once the caller holds no shard
+     */
+    FreedSeats updateTime();
+
+    /**
+     * @brief Releases the seats of the holds that expired at the current date
+     * @return FreedSeats seats released
      */
-    void updateTime();
+    FreedSeats expireHolds();
+
+    /**
+     * @brief Books a freed seat of a flight for its next waiter, skipping the waiters whose passenger was removed. If
+     * the seat itself cannot be booked the waiter is put back in its place. It takes the shards itself, so the caller
+     * must not hold any
+     * @param flightId unsigned int flightId
+     * @param seat const string &seat
+     */
+    void promoteWaiter(unsigned int flightId, const string &seat);
+
+    /**
+     * @brief Books each freed seat for the next waiter of its flight (see promoteWaiter)
+     * @param freed const FreedSeats &freed
+     */
+    void promoteWaiters(const FreedSeats &freed);
+
+    /**
+     * @brief Gets the waiters a flight accepts with the overbooking margin
+     * @param flight const Flight *flight
+     * @return size_t
+     */
+    size_t waitlistLimit(const Flight *flight) const {
+        return (size_t) flight->getCapacity() * overbookingMargin / 100;
+    }
 
     /**
      * @brief Updates the bookings according to the time
@@ -719,10 +1124,16 @@ public:
     void updatePassengers();
 
     /**
-     * @brief Gets all the passengers that are registered in the system
+     * @brief Updates the status (active or inactive) of the passenger passed as argument according to the time
+     * @param p Passenger *p
+     */
+    void updatePassenger(Passenger *p);
+
+    /**
+     * @brief Gets a copy of all the passengers that are registered in the system, active first
      * @return vector <Passenger*>
      */
-    vector<Passenger *> getAllPassengers();
+    vector<Passenger *> getAllPassengers() const;
 
     /**
      * @brief Removes the passenger passed as argument from the bookings vector
@@ -731,10 +1142,94 @@ public:
     void removePassengerFromBookings(Passenger *passenger);
 
     /**
-     * @brief Gets all the inactive Passengers
+     * @brief Gets a copy of all the inactive Passengers sorted by id
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> getIncPassengers() const;
+
+    /**
+     * @brief Creates the sorted views of the passengers and flights
+     */
+    void setupViews();
+
+    /**
+     * @brief Gets the passengers sorted by the list order passed as argument, rebuilding the view only if it is stale
+     * @param t type t (PID, PNAME, PAGE, PACT or PINC)
+     * @return const vector<Passenger *>&
+     */
+    const vector<Passenger *> &getSortedPassengers(type t);
+
+    /**
+     * @brief Gets the flights sorted by the list order passed as argument, rebuilding the view only if it is stale
+     * @param t type t (FID, FPRICEL, FDEST or FTIME, FPRICEH is FPRICEL read backwards)
+     * @return const vector<Flight *>&
+     */
+    const vector<Flight *> &getSortedFlights(type t);
+
+    /**
+     * @brief Gets a page of the passengers in the list order passed as argument, sliced from the view if it is up to
+     * date and otherwise selected with a partial heap sort of the first pages, without sorting the whole list. The list
+     * orders break their ties by id, so both ways give the same pages
+     * @param t type t (PID, PNAME, PAGE, PACT or PINC)
+     * @param page size_t page (starting at 0)
+     * @param pageSize size_t pageSize
      * @return vector<Passenger *>
      */
-    vector<Passenger *> getIncPassengers();
+    vector<Passenger *> getPassengersPage(type t, size_t page, size_t pageSize);
+
+    /**
+     * @brief Gets a page of the flights in the list order passed as argument (see getPassengersPage)
+     * @param t type t (FID, FPRICEL, FPRICEH, FDEST or FTIME)
+     * @param page size_t page (starting at 0)
+     * @param pageSize size_t pageSize
+     * @return vector<Flight *>
+     */
+    vector<Flight *> getFlightsPage(type t, size_t page, size_t pageSize);
+
+    /**
+     * @brief Updates the passenger views and the snapshots after a Passenger was added
+     * @param passenger Passenger *passenger
+     */
+    void passengerViewsInsert(Passenger *passenger);
+
+    /**
+     * @brief Updates the passenger views and the snapshots after a Passenger was removed
+     * @param passenger Passenger *passenger
+     */
+    void passengerViewsErase(Passenger *passenger);
+
+    /**
+     * @brief Updates the passenger views and the snapshots after a Passenger became active or inactive
+     * @param passenger Passenger *passenger
+     * @param active bool active
+     */
+    void passengerViewsStatus(Passenger *passenger, bool active);
+
+    /**
+     * @brief Updates the passenger views and the snapshots after the sort key of a Passenger changed
+     * @param passenger Passenger *passenger
+     * @param t type t of the view whose key changed
+     */
+    void passengerViewsKey(Passenger *passenger, type t);
+
+    /**
+     * @brief Updates the flight views and the snapshots after a Flight was added
+     * @param flight Flight *flight
+     */
+    void flightViewsInsert(Flight *flight);
+
+    /**
+     * @brief Updates the flight views and the snapshots after a Flight was removed
+     * @param flight Flight *flight
+     */
+    void flightViewsErase(Flight *flight);
+
+    /**
+     * @brief Updates the flight views and the snapshots after the sort key of a Flight changed
+     * @param flight Flight *flight
+     * @param t type t of the view whose key changed
+     */
+    void flightViewsKey(Flight *flight, type t);
 
     /**
      * @brief Updates the Date on the Airplanes
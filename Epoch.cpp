@@ -0,0 +1,62 @@
+#include "Epoch.h"
+#include <thread>
+#include <algorithm>
+
+const size_t EpochDomain::READERS;
+
+EpochDomain::Guard::Guard(EpochDomain &domain) : domain(domain), slot(0) {
+    // the slot holds an epoch read before the reader loads any shared pointer, an older value is only conservative
+    for (uint64_t free = 0;; free = 0) {
+        uint64_t now = domain.epoch.load();
+        if (domain.readers[slot].compare_exchange_strong(free, now)) return;
+        if (++slot == READERS) {
+            slot = 0;
+            this_thread::yield();
+        }
+    }
+}
+
+EpochDomain::Guard::~Guard() {
+    domain.readers[slot].store(0);
+}
+
+EpochDomain::EpochDomain() : epoch(1) {
+    for (auto &r : readers) r.store(0);
+}
+
+EpochDomain::~EpochDomain() {
+    for (auto const &r : retired) r.destroy(r.object);
+}
+
+uint64_t EpochDomain::oldestPinned() const {
+    uint64_t oldest = UINT64_MAX;
+    for (auto const &r : readers) {
+        uint64_t e = r.load();
+        if (e != 0 && e < oldest) oldest = e;
+    }
+    return oldest;
+}
+
+void EpochDomain::retire(void *object, void (*destroy)(void *)) {
+    lock_guard<mutex> lock(retiredLock);
+    retired.push_back({object, destroy, epoch.fetch_add(1)});
+}
+
+size_t EpochDomain::reclaim() {
+    vector<Retired> expired;
+    {
+        lock_guard<mutex> lock(retiredLock);
+        uint64_t oldest = oldestPinned();
+        // a reader that pinned an epoch after the retirement cannot reach the object
+        auto it = partition(retired.begin(), retired.end(), [oldest](const Retired &r) { return r.epoch >= oldest; });
+        expired.assign(it, retired.end());
+        retired.erase(it, retired.end());
+    }
+    for (auto const &r : expired) r.destroy(r.object);
+    return expired.size();
+}
+
+size_t EpochDomain::pending() {
+    lock_guard<mutex> lock(retiredLock);
+    return retired.size();
+}
@@ -0,0 +1,124 @@
+#ifndef AEDA_FEUP_PROJECT_EPOCH_H
+#define AEDA_FEUP_PROJECT_EPOCH_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Epoch based reclamation of the objects shared with lock free readers.
+ * A reader pins the current epoch for as long as it uses the shared objects. A writer that unlinks an object retires
+ * it, stamping it with the epoch of the retirement and advancing the epoch; the object is deleted once every pinned
+ * reader pinned a later epoch, because those readers could only reach the objects that replaced it.
+ */
+class EpochDomain {
+
+public:
+    /**
+     * @brief number of readers that can be pinned at the same time, further readers wait for a free slot
+     */
+    static const size_t READERS = 64;
+
+    /**
+     * Pins the epoch of a domain while it is in scope
+     */
+    class Guard {
+
+    private:
+        /**
+         * @brief domain pinned
+         */
+        EpochDomain &domain;
+        /**
+         * @brief slot of the reader in the domain
+         */
+        size_t slot;
+
+    public:
+        explicit Guard(EpochDomain &domain);
+
+        Guard(const Guard &) = delete;
+
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard();
+    };
+
+private:
+    //! struct Retired
+    /*! Object unlinked by a writer and not deleted yet */
+    struct Retired {
+        void *object;            /*!< object retired */
+        void (*destroy)(void *); /*!< deletes the object */
+        uint64_t epoch;          /*!< epoch of the retirement */
+    };
+
+    /**
+     * @brief current epoch, starts at 1 because a slot holding 0 is free
+     */
+    atomic<uint64_t> epoch;
+    /**
+     * @brief epoch pinned by each reader slot, 0 if the slot is free
+     */
+    atomic<uint64_t> readers[READERS];
+    /**
+     * @brief guards retired
+     */
+    mutex retiredLock;
+    /**
+     * @brief objects waiting for the readers that may still use them
+     */
+    vector<Retired> retired;
+
+    /**
+     * @brief Gets the oldest epoch pinned by a reader
+     * @return uint64_t UINT64_MAX if there are no readers
+     */
+    uint64_t oldestPinned() const;
+
+    /**
+     * @brief Retires an object with the function that deletes it
+     * @param object void *object
+     * @param destroy void (*destroy)(void *)
+     */
+    void retire(void *object, void (*destroy)(void *));
+
+public:
+    EpochDomain();
+
+    EpochDomain(const EpochDomain &) = delete;
+
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    /**
+     * @brief Deletes every retired object, there must be no pinned readers
+     */
+    ~EpochDomain();
+
+    /**
+     * @brief Retires an object that is no longer reachable by new readers, it is deleted by a later reclaim()
+     * @param object const T *object
+     */
+    template<class T>
+    void retire(const T *object) {
+        retire((void *) object, [](void *p) { delete (T *) p; });
+    }
+
+    /**
+     * @brief Deletes the retired objects that no pinned reader can use anymore
+     * @return size_t number of objects deleted
+     */
+    size_t reclaim();
+
+    /**
+     * @brief Gets the number of retired objects not deleted yet
+     * @return size_t
+     */
+    size_t pending();
+};
+
+#endif //AEDA_FEUP_PROJECT_EPOCH_H
@@ -0,0 +1,157 @@
+#include "FareCalendar.h"
+#include <algorithm>
+#include <limits>
+
+static const int64_t NO_FARE = numeric_limits<int64_t>::max();
+
+static bool compDeparture(const RouteIndex::Entry &a, const RouteIndex::Entry &b) {
+    if (a.minute != b.minute) return a.minute < b.minute;
+    return a.id < b.id;
+}
+
+int RouteIndex::position(Flight *f) const {
+    Entry key{f->getDate().convertToMinutes(), f->getId(), f};
+    auto it = lower_bound(flights.begin(), flights.end(), key, compDeparture);
+    if (it == flights.end() || it->flight != f) return -1;
+    return (int) (it - flights.begin());
+}
+
+void RouteIndex::insert(Flight *f) {
+    Entry key{f->getDate().convertToMinutes(), f->getId(), f};
+    auto it = lower_bound(flights.begin(), flights.end(), key, compDeparture);
+    // a flight removed and added again (same id and departure) takes back its tombstone
+    if (it != flights.end() && it->flight == nullptr && it->minute == key.minute && it->id == key.id) {
+        it->flight = f;
+        removed--;
+    } else flights.insert(it, key);
+    stale = true;
+}
+
+bool RouteIndex::erase(Flight *f) {
+    int pos = position(f);
+    if (pos < 0) return false;
+    flights[pos].flight = nullptr;
+    removed++;
+    stale = true;
+    return true;
+}
+
+void RouteIndex::set(size_t pos, int64_t scaled) {
+    size_t i = pos + flights.size();
+    tree[i] = make_pair(scaled, (int) pos);
+    for (i /= 2; i >= 1; i /= 2) tree[i] = min(tree[2 * i], tree[2 * i + 1]);
+}
+
+void RouteIndex::rebuild(PricingEngine &engine, int now) {
+    if (removed != 0) {
+        flights.erase(remove_if(flights.begin(), flights.end(), [](const Entry &e) { return e.flight == nullptr; }),
+                      flights.end());
+        removed = 0;
+    }
+    stale = false;
+
+    size_t n = flights.size();
+    vector<Flight *> route;
+    vector<int64_t> scaled;
+
+    for (auto const &f : flights) route.push_back(f.flight);
+    engine.load(route, now);
+    engine.scale(scaled);
+
+    tree.assign(2 * n, make_pair(NO_FARE, -1));
+    for (size_t i = 0; i < n; i++) {
+        Flight *f = route[i];
+        bool bookable = flights[i].minute > now && f->getPassengers().size() < f->getCapacity();
+        tree[n + i] = make_pair(bookable ? scaled[i] : NO_FARE, (int) i);
+    }
+    for (size_t i = n - 1; i >= 1 && i < n; i--) tree[i] = min(tree[2 * i], tree[2 * i + 1]);
+}
+
+void RouteIndex::update(Flight *f, PricingEngine &engine, int now) {
+    if (stale) return;
+    int pos = position(f);
+    if (pos < 0) return;
+
+    vector<Flight *> single(1, f);
+    vector<int64_t> scaled;
+    engine.load(single, now);
+    engine.scale(scaled);
+
+    bool bookable = flights[pos].minute > now && f->getPassengers().size() < f->getCapacity();
+    set((size_t) pos, bookable ? scaled[0] : NO_FARE);
+}
+
+pair<int64_t, Flight *> RouteIndex::cheapest(int from, int to) const {
+    size_t n = flights.size();
+    Entry lo{from, 0, nullptr}, hi{to, 0, nullptr};
+    auto byMinute = [](const Entry &a, const Entry &b) { return a.minute < b.minute; };
+    size_t l = lower_bound(flights.begin(), flights.end(), lo, byMinute) - flights.begin() + n;
+    size_t r = lower_bound(flights.begin(), flights.end(), hi, byMinute) - flights.begin() + n;
+
+    pair<int64_t, int> best(NO_FARE, -1);
+    for (; l < r; l /= 2, r /= 2) {
+        if (l & 1) best = min(best, tree[l++]);
+        if (r & 1) best = min(best, tree[--r]);
+    }
+
+    if (best.first == NO_FARE) return make_pair(NO_FARE, (Flight *) nullptr);
+    return make_pair(best.first, flights[best.second].flight);
+}
+
+bool RouteIndex::empty() const {
+    return flights.size() == removed;
+}
+
+pair<uint32_t, uint32_t> FareCalendar::routeOf(Flight *f) {
+    return make_pair(f->getDepartureSymbol().normalized().getId(), f->getDestinationSymbol().normalized().getId());
+}
+
+void FareCalendar::addFlight(Flight *f) {
+    if (f->getKind() != FLIGHT_COMMERCIAL) return;
+    routes[routeOf(f)].insert(f);
+}
+
+void FareCalendar::removeFlight(Flight *f) {
+    auto it = routes.find(routeOf(f));
+    if (it == routes.end() || !it->second.erase(f)) return;
+    if (it->second.empty()) routes.erase(it);
+}
+
+void FareCalendar::updateFlight(Flight *f) {
+    auto it = routes.find(routeOf(f));
+    if (it != routes.end()) it->second.update(f, engine, now);
+}
+
+void FareCalendar::refresh(int now) {
+    this->now = now;
+    for (auto &r : routes) r.second.invalidate();
+}
+
+void FareCalendar::clear() {
+    routes.clear();
+}
+
+vector<FareDay> FareCalendar::month(string departure, string destination, int month, int year, int cardDiscount) {
+    vector<FareDay> days;
+    if (month < 1 || month > 12) return days;
+
+    // the cities are only looked up: a text that was never interned has no flights and is not added to the table
+    auto it = routes.find(make_pair(SymbolTable::find(SymbolTable::normalizedText(departure)),
+                                    SymbolTable::find(SymbolTable::normalizedText(destination))));
+    if (it != routes.end() && it->second.isStale()) it->second.rebuild(engine, now);
+
+    for (int d = 1; d <= monthdays[month]; d++) {
+        FareDay fare;
+        fare.day = d;
+        if (it != routes.end()) {
+            int from = Date(year, month, d, 0, 0).convertToMinutes();
+            pair<int64_t, Flight *> best = it->second.cheapest(from, from + 24 * 60);
+            if (best.second != nullptr) {
+                fare.cents = engine.finish(best.first, cardDiscount);
+                fare.flight = best.second;
+            }
+        }
+        days.push_back(fare);
+    }
+    return days;
+}
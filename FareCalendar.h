@@ -0,0 +1,197 @@
+#ifndef AEDA_FEUP_PROJECT_FARECALENDAR_H
+#define AEDA_FEUP_PROJECT_FARECALENDAR_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include "Flight.h"
+#include "PricingEngine.h"
+
+using namespace std;
+
+//! struct FareDay
+/*! Cheapest fare of a route on a given day */
+struct FareDay {
+    int day = 0;              /*!< day of the month */
+    int64_t cents = -1;       /*!< cheapest price in cents, -1 if there are no bookable flights on that day */
+    Flight *flight = nullptr; /*!< flight with the cheapest price */
+};
+
+/**
+ * Index of the bookable commercial flights of a single route ordered by departure time.
+ * A segment tree over the current scaled prices answers the cheapest flight of any time window in O(log n).
+ * Inserting or removing a flight or advancing the clock only marks the tree as stale (a removed flight is left as a
+ * tombstone), so a load or a clock advance that changes many flights of the route rebuilds it once, when it is next
+ * read.
+ */
+class RouteIndex {
+
+public:
+    //! struct Entry
+    /*! A flight of the route */
+    struct Entry {
+        int minute;         /*!< departure time in minutes */
+        unsigned int id;    /*!< id of the flight, orders the flights departing at the same minute */
+        Flight *flight;     /*!< flight, nullptr once it was removed (the flight may have been deleted) */
+    };
+
+private:
+    /**
+     * @brief flights ordered by departure minute and flight id, with the tombstones of the removed ones
+     */
+    vector<Entry> flights;
+    /**
+     * @brief number of tombstones in flights
+     */
+    size_t removed = 0;
+    /**
+     * @brief true if flights changed after the last rebuild of the tree
+     */
+    bool stale = false;
+    /**
+     * @brief segment tree of (scaled price, position) pairs, leaves start at flights.size()
+     */
+    vector<pair<int64_t, int> > tree;
+
+    /**
+     * @brief Gets the position of the flight passed as argument (-1 if it is not indexed)
+     * @param f Flight *f
+     * @return int
+     */
+    int position(Flight *f) const;
+
+    /**
+     * @brief Sets the leaf of the position passed as argument and updates its ancestors
+     * @param pos size_t pos
+     * @param scaled int64_t scaled
+     */
+    void set(size_t pos, int64_t scaled);
+
+public:
+    /**
+     * @brief Inserts the flight passed as argument in departure order (the tree is rebuilt when next used)
+     * @param f Flight *f
+     */
+    void insert(Flight *f);
+
+    /**
+     * @brief Removes the flight passed as argument leaving a tombstone (the tree is rebuilt when next used)
+     * @param f Flight *f
+     * @return true if the flight was indexed and false otherwise
+     */
+    bool erase(Flight *f);
+
+    /**
+     * @brief Checks if flights were inserted or removed or the clock advanced after the last rebuild
+     * @return bool
+     */
+    bool isStale() const { return stale; }
+
+    /**
+     * @brief Marks the tree as stale so that every flight is repriced when it is next read
+     */
+    void invalidate() { stale = true; }
+
+    /**
+     * @brief Drops the tombstones and rebuilds the segment tree pricing every flight of the route
+     * @param engine PricingEngine &engine
+     * @param now int current time in minutes
+     */
+    void rebuild(PricingEngine &engine, int now);
+
+    /**
+     * @brief Reprices a single flight of the route in O(log n), nothing if the route is stale (it is repriced whole
+     * when it is next read)
+     * @param f Flight *f
+     * @param engine PricingEngine &engine
+     * @param now int current time in minutes
+     */
+    void update(Flight *f, PricingEngine &engine, int now);
+
+    /**
+     * @brief Gets the cheapest flight departing in [from, to), the route must not be stale
+     * @param from int first minute of the window
+     * @param to int first minute after the window
+     * @return pair<int64_t, Flight *> scaled price and flight, the flight is nullptr if there is none
+     */
+    pair<int64_t, Flight *> cheapest(int from, int to) const;
+
+    /**
+     * @brief Checks if the route has no flights
+     * @return true if it is empty and false otherwise
+     */
+    bool empty() const;
+};
+
+/**
+ * The FareCalendar keeps a RouteIndex for every (departure, destination) pair of the company flights
+ * and answers the cheapest fare of each day of a month for a route.
+ */
+class FareCalendar {
+
+private:
+    /**
+     * @brief route indexes by the symbol ids of the normalized (departure, destination)
+     */
+    map<pair<uint32_t, uint32_t>, RouteIndex> routes;
+    /**
+     * @brief engine used to price the flights of the calendar
+     */
+    PricingEngine engine;
+    /**
+     * @brief time used for the last pricing, in minutes
+     */
+    int now = 0;
+
+    /**
+     * @brief Gets the normalized route key of a flight
+     * @param f Flight *f
+     * @return pair<uint32_t, uint32_t>
+     */
+    static pair<uint32_t, uint32_t> routeOf(Flight *f);
+
+public:
+    /**
+     * @brief Adds a flight to the calendar, rented flights are ignored
+     * @param f Flight *f
+     */
+    void addFlight(Flight *f);
+
+    /**
+     * @brief Removes a flight from the calendar
+     * @param f Flight *f
+     */
+    void removeFlight(Flight *f);
+
+    /**
+     * @brief Reprices a flight after a seat was sold or returned or its price changed
+     * @param f Flight *f
+     */
+    void updateFlight(Flight *f);
+
+    /**
+     * @brief Sets the time of the pricing and marks every route as stale, each one is repriced when it is next read
+     * @param now int current time in minutes
+     */
+    void refresh(int now);
+
+    /**
+     * @brief Removes every flight from the calendar
+     */
+    void clear();
+
+    /**
+     * @brief Gets the cheapest fare of each day of a month for a route
+     * @param departure string departure city
+     * @param destination string destination city
+     * @param month int month
+     * @param year int year
+     * @param cardDiscount int card discount of the passenger (0 if there is no card)
+     * @return vector<FareDay> one entry per day of the month
+     */
+    vector<FareDay> month(string departure, string destination, int month, int year, int cardDiscount);
+};
+
+#endif //AEDA_FEUP_PROJECT_FARECALENDAR_H
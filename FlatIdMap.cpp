@@ -0,0 +1,177 @@
+#include "FlatIdMap.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const uint32_t FlatIdMap::NOT_FOUND;
+const size_t FlatIdMap::GROUP;
+const uint8_t FlatIdMap::EMPTY;
+
+/**
+ * @brief Gets a bitmask of the control bytes of a group equal to c (bit i is set if group[i] == c)
+ * @param group const uint8_t *group
+ * @param c uint8_t c
+ * @return unsigned int
+ */
+static inline unsigned int matchGroup(const uint8_t *group, uint8_t c) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128((const __m128i *) group);
+    return (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char) c)));
+#else
+    unsigned int bits = 0;
+    for (unsigned int i = 0; i < 16; i++)
+        if (group[i] == c) bits |= 1u << i;
+    return bits;
+#endif
+}
+
+/**
+ * @brief Gets the position of the lowest set bit
+ * @param bits unsigned int bits (not 0)
+ * @return unsigned int
+ */
+static inline unsigned int lowestBit(unsigned int bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctz(bits);
+#else
+    unsigned int i = 0;
+    while (!(bits & 1u)) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+uint64_t FlatIdMap::hash(uint32_t key) {
+    // Fibonacci hashing, the low 7 bits go to the control byte and the rest selects the slot
+    uint64_t h = (uint64_t) key * 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 32);
+}
+
+void FlatIdMap::setCtrl(size_t slot, uint8_t c) {
+    ctrl[slot] = c;
+    if (slot < GROUP) ctrl[mask + 1 + slot] = c;
+}
+
+size_t FlatIdMap::locate(uint32_t key) const {
+    if (count == 0) return mask + 1;
+
+    uint64_t h = hash(key);
+    uint8_t tag = (uint8_t) (h & 0x7F);
+    size_t pos = home(h);
+
+    // an id is always found before the first empty slot of its probe sequence
+    for (size_t probed = 0; probed <= mask; probed += GROUP) {
+        const uint8_t *group = &ctrl[pos];
+        unsigned int empty = matchGroup(group, EMPTY);
+        unsigned int match = matchGroup(group, tag);
+        if (empty) match &= (1u << lowestBit(empty)) - 1;
+
+        while (match) {
+            size_t slot = (pos + lowestBit(match)) & mask;
+            if (keys[slot] == key) return slot;
+            match &= match - 1;
+        }
+        if (empty) break;
+        pos = (pos + GROUP) & mask;
+    }
+    return mask + 1;
+}
+
+void FlatIdMap::rehash(size_t slots) {
+    vector<uint8_t> oldCtrl;
+    vector<uint32_t> oldKeys, oldValues;
+    oldCtrl.swap(ctrl);
+    oldKeys.swap(keys);
+    oldValues.swap(values);
+    size_t oldSlots = oldKeys.size();
+
+    mask = slots - 1;
+    count = 0;
+    ctrl.assign(slots + GROUP, EMPTY);
+    keys.assign(slots, 0);
+    values.assign(slots, 0);
+
+    for (size_t i = 0; i < oldSlots; i++)
+        if (oldCtrl[i] != EMPTY) insert(oldKeys[i], oldValues[i]);
+}
+
+bool FlatIdMap::insert(uint32_t key, uint32_t value) {
+    size_t slot = locate(key);
+    if (slot <= mask) {
+        values[slot] = value;
+        return false;
+    }
+
+    // at most 7/8 of the slots are used so the probe sequences stay short
+    if (keys.empty() || (count + 1) * 8 > keys.size() * 7) rehash(keys.empty() ? GROUP : keys.size() * 2);
+
+    uint64_t h = hash(key);
+    size_t pos = home(h);
+    while (true) {
+        unsigned int empty = matchGroup(&ctrl[pos], EMPTY);
+        if (empty) {
+            slot = (pos + lowestBit(empty)) & mask;
+            break;
+        }
+        pos = (pos + GROUP) & mask;
+    }
+
+    setCtrl(slot, (uint8_t) (h & 0x7F));
+    keys[slot] = key;
+    values[slot] = value;
+    count++;
+    return true;
+}
+
+uint32_t FlatIdMap::find(uint32_t key) const {
+    size_t slot = locate(key);
+    if (slot > mask) return NOT_FOUND;
+    return values[slot];
+}
+
+bool FlatIdMap::contains(uint32_t key) const {
+    return find(key) != NOT_FOUND;
+}
+
+bool FlatIdMap::erase(uint32_t key) {
+    size_t hole = locate(key);
+    if (hole > mask) return false;
+
+    // backward shift: move every following entry of the run that may live in the hole
+    for (size_t next = (hole + 1) & mask; ctrl[next] != EMPTY; next = (next + 1) & mask) {
+        size_t start = home(hash(keys[next]));
+        if (((next - start) & mask) < ((next - hole) & mask)) continue;
+        setCtrl(hole, ctrl[next]);
+        keys[hole] = keys[next];
+        values[hole] = values[next];
+        hole = next;
+    }
+    setCtrl(hole, EMPTY);
+    count--;
+    return true;
+}
+
+void FlatIdMap::reserve(size_t n) {
+    size_t slots = GROUP;
+    while (slots * 7 < n * 8) slots *= 2;
+    if (slots > keys.size()) rehash(slots);
+}
+
+void FlatIdMap::clear() {
+    ctrl.clear();
+    keys.clear();
+    values.clear();
+    mask = 0;
+    count = 0;
+}
+
+size_t FlatIdMap::size() const {
+    return count;
+}
+
+bool FlatIdMap::empty() const {
+    return count == 0;
+}
@@ -0,0 +1,143 @@
+#ifndef AEDA_FEUP_PROJECT_FLATIDMAP_H
+#define AEDA_FEUP_PROJECT_FLATIDMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Open addressing hash map from 32-bit ids to 32-bit values, stored in flat arrays.
+ * Collisions are resolved with linear probing. Every slot has a control byte with 7 bits of the hash (or EMPTY),
+ * and lookups compare 16 control bytes at a time with SSE2 (a scalar loop is used when SSE2 is not available).
+ * Erasing shifts the following entries of the probe sequence back, so the table never holds tombstones.
+ */
+class FlatIdMap {
+
+public:
+    /**
+     * @brief value returned by find() when the id is not in the map
+     */
+    static const uint32_t NOT_FOUND = UINT32_MAX;
+
+private:
+    /**
+     * @brief number of control bytes compared at once
+     */
+    static const size_t GROUP = 16;
+    /**
+     * @brief control byte of an empty slot
+     */
+    static const uint8_t EMPTY = 0x80;
+
+    /**
+     * @brief control byte of every slot, followed by a copy of the first GROUP bytes so a group never wraps
+     */
+    vector<uint8_t> ctrl;
+    /**
+     * @brief id of every slot
+     */
+    vector<uint32_t> keys;
+    /**
+     * @brief value of every slot
+     */
+    vector<uint32_t> values;
+    /**
+     * @brief number of slots minus one (the number of slots is a power of 2)
+     */
+    size_t mask = 0;
+    /**
+     * @brief number of entries
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Hashes an id
+     * @param key uint32_t key
+     * @return uint64_t
+     */
+    static uint64_t hash(uint32_t key);
+
+    /**
+     * @brief Gets the first slot of the probe sequence of a hash
+     * @param h uint64_t h
+     * @return size_t
+     */
+    size_t home(uint64_t h) const { return (size_t) (h >> 7) & mask; }
+
+    /**
+     * @brief Sets the control byte of a slot and of its copy
+     * @param slot size_t slot
+     * @param c uint8_t c
+     */
+    void setCtrl(size_t slot, uint8_t c);
+
+    /**
+     * @brief Gets the slot of an id
+     * @param key uint32_t key
+     * @return size_t slot, or the number of slots if the id is not in the map
+     */
+    size_t locate(uint32_t key) const;
+
+    /**
+     * @brief Rehashes every entry into a table with the number of slots passed as argument
+     * @param slots size_t slots (power of 2)
+     */
+    void rehash(size_t slots);
+
+public:
+    /**
+     * @brief Inserts an id or replaces its value
+     * @param key uint32_t key
+     * @param value uint32_t value (must not be NOT_FOUND)
+     * @return true if the id was inserted and false if its value was replaced
+     */
+    bool insert(uint32_t key, uint32_t value);
+
+    /**
+     * @brief Gets the value of an id
+     * @param key uint32_t key
+     * @return uint32_t value, NOT_FOUND if the id is not in the map
+     */
+    uint32_t find(uint32_t key) const;
+
+    /**
+     * @brief Checks if an id is in the map
+     * @param key uint32_t key
+     * @return true if it is and false otherwise
+     */
+    bool contains(uint32_t key) const;
+
+    /**
+     * @brief Removes an id from the map
+     * @param key uint32_t key
+     * @return true if it was removed and false if it was not in the map
+     */
+    bool erase(uint32_t key);
+
+    /**
+     * @brief Reserves room for the number of entries passed as argument without rehashing
+     * @param n size_t n
+     */
+    void reserve(size_t n);
+
+    /**
+     * @brief Removes every entry and frees the table
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of entries
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks if the map has no entries
+     * @return true if it is empty and false otherwise
+     */
+    bool empty() const;
+};
+
+#endif //AEDA_FEUP_PROJECT_FLATIDMAP_H
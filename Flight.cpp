@@ -1,22 +1,67 @@
 #include "Flight.h"
 #include "Application.h"
 #include <iomanip>
+#include "RadixSort.h"
+#include "ObjectPool.h"
 
 Flight::Flight(unsigned int id, string departure, string destination, Date date,
                unsigned int basePrice, Date duration) : id(id), departure(departure),
                                                         destination(destination), date(date),
-                                                        basePrice(basePrice), duration(duration) {}
+                                                        duration(duration) {
+    FlightTable::reset(getHandleSlot());
+    FlightTable::setBasePrice(getHandleSlot(), basePrice);
+    updateSchedule();
+}
+
+Flight::Flight(const Flight &f) : Handled<Flight>(f), id(f.id), departure(f.departure),
+                                  destination(f.destination), date(f.date), duration(f.duration), kind(f.kind) {
+    FlightTable::copy(f.getHandleSlot(), getHandleSlot());
+}
+
+Flight &Flight::operator=(const Flight &f) {
+    id = f.id;
+    departure = f.departure;
+    destination = f.destination;
+    date = f.date;
+    duration = f.duration;
+    kind = f.kind;
+    FlightTable::copy(f.getHandleSlot(), getHandleSlot());
+    return *this;
+}
+
+void Flight::updateSchedule() {
+    int64_t departureMinute = date.convertToMinutes();
+    FlightTable::setSchedule(getHandleSlot(), departureMinute, departureMinute + duration.convertToMinutes());
+}
+
+void Flight::setKind(flight_type_t k) {
+    kind = (uint8_t) k;
+    FlightTable::setKind(getHandleSlot(), k);
+}
+
+void Flight::updateOccupancy() {
+    size_t seats = kind == FLIGHT_COMMERCIAL ? getPassengers().size() : (getBuyer() == nullptr ? 0 : 1);
+    FlightTable::setOccupancy(getHandleSlot(), (uint32_t) seats);
+}
 
 string Flight::getDeparture() const {
-    return this->departure;
+    return this->departure.str();
 }
 
 string Flight::getDestination() const {
+    return this->destination.str();
+}
+
+Symbol Flight::getDepartureSymbol() const {
+    return this->departure;
+}
+
+Symbol Flight::getDestinationSymbol() const {
     return this->destination;
 }
 
 unsigned int Flight::getBasePrice() const {
-    return this->basePrice;
+    return FlightTable::getBasePrice(getHandleSlot());
 }
 
 Date Flight::getDuration() const {
@@ -24,7 +69,7 @@ Date Flight::getDuration() const {
 }
 
 unsigned int Flight::getCapacity() const {
-    return this->capacity;
+    return FlightTable::getCapacity(getHandleSlot());
 }
 
 void Flight::setDeparture(string departure) {
@@ -37,37 +82,53 @@ void Flight::setDestination(string destination) {
 
 void Flight::setDate(Date date) {
     this->date = date;
+    updateSchedule();
 }
 
 void Flight::setBasePrice(unsigned int basePrice) {
-    this->basePrice = basePrice;
+    FlightTable::setBasePrice(getHandleSlot(), basePrice);
 }
 
 void Flight::setDuration(Date duration) {
     this->duration = duration;
+    updateSchedule();
 }
 
 void Flight::printSummary() const {
 
-    cout << setw(9) << id << setw(3) << " " << setw(15) << departure << setw(3) << " " << setw(15) << destination
+    cout << setw(9) << id << setw(3) << " " << setw(15) << departure.str() << setw(3) << " " << setw(15) << destination.str()
          << setw(3) << " " << setw(18) << this->getDate().printFullDate() << endl;
 
 }
 
 void Flight::printList() const {
 
-    cout << setw(9) << id << setw(3) << " " << setw(15) << departure << setw(3) << " " << setw(15) << destination
-         << setw(3) << " " << setw(18) << this->getDate().printFullDate() << setw(3) << " " << setw(9) << basePrice
+    cout << setw(9) << id << setw(3) << " " << setw(15) << departure.str() << setw(3) << " " << setw(15) << destination.str()
+         << setw(3) << " " << setw(18) << this->getDate().printFullDate() << setw(3) << " " << setw(9) << getBasePrice()
          << endl;
 }
 
+void Flight::formatList(string &out) const {
+
+    appendColumn(out, to_string(id), 9);
+    out += "   ";
+    appendColumn(out, departure.str(), 15);
+    out += "   ";
+    appendColumn(out, destination.str(), 15);
+    out += "   ";
+    appendColumn(out, this->getDate().printFullDate(), 18);
+    out += "   ";
+    appendColumn(out, to_string(getBasePrice()), 9);
+    out += '\n';
+}
+
 void Flight::print() const {
 
     cout << "Id: " << id << endl;
-    cout << "Departure: " << departure << endl;
-    cout << "Destination: " << destination << endl;
+    cout << "Departure: " << departure.str() << endl;
+    cout << "Destination: " << destination.str() << endl;
     cout << "Date:  " << this->getDate().printFullDate() << endl;
-    cout << "Base Price: " << basePrice << "€" << endl;
+    cout << "Base Price: " << getBasePrice() << "€" << endl;
     cout << "Flight duration: " << this->getDuration().printTime() << endl;
 }
 
@@ -88,11 +149,28 @@ void Flight::setId(unsigned int id) {
     this->id = id;
 }
 
+void Flight::formatHead(string &out) const {
+    out += getType() + to_string(id) + "; " + departure.str() + "; " + destination.str() + "; " +
+           getDate().printFullDate() + "; " + to_string(getBasePrice()) + "; " + getDuration().printTime() + "; ";
+}
+
+void Flight::formatSeatRow(string &out, const string &seat) const {
+    // the seats of a row are consecutive in the map, from its seat A to its last seat
+    string row = seat.substr(0, seat.size() - 1), last = row + (char) ('A' + SeatMap::ROW_SEATS - 1);
+    const PassengerMap &seats = getPassengers();
+    bool first = true;
+    for (auto it = seats.lower_bound(row + 'A'); it != seats.end() && it->first <= last; ++it) {
+        if (!first) out += ", ";
+        out += it->first + "-" + to_string(it->second->getId());
+        first = false;
+    }
+}
+
 ostream &operator<<(ostream &o, Flight *f) {
-    o << f->getType() << to_string(f->id) << "; " << f->departure << "; " << f->destination << "; "
-      << f->getDate().printFullDate() << "; " << to_string(f->basePrice) << "; " << f->getDuration().printTime()
-      << "; ";
-    if (f->getType() == "c") {
+    string head;
+    f->formatHead(head);
+    o << head;
+    if (f->getKind() == FLIGHT_COMMERCIAL) {
         size_t i = f->getPassengers().size();
         if (i > 0) {
             for (auto const &p: f->getPassengers()) {
@@ -110,7 +188,8 @@ ostream &operator<<(ostream &o, Flight *f) {
 }
 
 void Flight::setCapacity(unsigned int capacity) {
-    this->capacity = capacity;
+    FlightTable::setCapacity(getHandleSlot(), capacity);
+    resizeSeats(capacity);
 }
 
 Date Flight::getDate() const {
@@ -121,13 +200,17 @@ Date Flight::getTimeToFlight() {
     return this->getDate() - Application::currentDate;
 }
 
-Flight::Flight() : id(0), departure(""), destination(""), basePrice(0) {
+Flight::Flight() : id(0), departure(""), destination("") {
     Date d1;
     date = d1;
     duration = d1;
+    FlightTable::reset(getHandleSlot());
+    updateSchedule();
 }
 
-RentedFlight::RentedFlight() : Flight(), buyer(nullptr) {}
+RentedFlight::RentedFlight() : Flight(), buyer(PassengerId::NIL) {
+    setKind(FLIGHT_RENTED);
+}
 
 RentedFlight::RentedFlight(unsigned int id, string departure, string destination, Date date,
                            unsigned int basePrice, Date duration, Passenger *buyer) : Flight(id, departure,
@@ -135,28 +218,55 @@ RentedFlight::RentedFlight(unsigned int id, string departure, string destination
                                                                                              date,
                                                                                              basePrice,
                                                                                              duration),
-                                                                                      buyer(buyer) {}
+                                                                                      buyer(PassengerId(buyer).getValue()) {
+    setKind(FLIGHT_RENTED);
+    updateOccupancy();
+}
+
+RentedFlight::RentedFlight(const RentedFlight &f) : Flight(f), buyer(f.buyer.load()) {}
 
 Passenger *RentedFlight::getBuyer() const {
 
-    return this->buyer;
+    uint32_t handle = buyer.load(memory_order_acquire);
+    return handle == PassengerId::NIL ? nullptr : HandleTable<Passenger>::resolve(handle);
 }
 
-PassengerMap &RentedFlight::getPassengers() {
+const PassengerMap &RentedFlight::getPassengers() const {
+
+    static const PassengerMap none;
+    return none;
 
-    PassengerMap *c = new PassengerMap;
-    return *c;
+}
+
+void *RentedFlight::operator new(size_t size) {
+    return ObjectPool<RentedFlight>::allocate(size);
+}
 
+void RentedFlight::operator delete(void *p, size_t size) {
+    ObjectPool<RentedFlight>::release(p, size);
 }
 
 void RentedFlight::setBuyer(Passenger *buyer) {
 
-    this->buyer = buyer;
+    this->buyer.store(PassengerId(buyer).getValue(), memory_order_release);
+    updateOccupancy();
+}
+
+bool RentedFlight::claim(const string &, Passenger *passenger) {
+
+    uint32_t none = PassengerId::NIL;
+    return buyer.compare_exchange_strong(none, PassengerId(passenger).getValue(), memory_order_acq_rel);
+}
+
+void RentedFlight::release(const string &) {
+
+    setBuyer(nullptr);
 }
 
 void RentedFlight::print() const {
 
     Flight::print();
+    Passenger *buyer = getBuyer();
     cout << "Buyer: " << buyer->getName() << " - " << buyer->getId();
     cout << endl;
 }
@@ -165,22 +275,30 @@ void RentedFlight::setPassengers(PassengerMap passengers) {}
 
 void RentedFlight::removePassenger(Passenger *passenger) {
 
-    if (buyer == nullptr) return;
-    if (buyer == passenger)
+    if (getBuyer() == nullptr) return;
+    if (getBuyer() == passenger)
         setBuyer(nullptr);
 }
 
-CommercialFlight::CommercialFlight() : Flight() {
-    PassengerMap *passengers = new PassengerMap;
-    this->passengers = *passengers;
+CommercialFlight::CommercialFlight() : Flight() {}
+
+void *CommercialFlight::operator new(size_t size) {
+    return ObjectPool<CommercialFlight>::allocate(size);
+}
+
+void CommercialFlight::operator delete(void *p, size_t size) {
+    ObjectPool<CommercialFlight>::release(p, size);
 }
 
 CommercialFlight::CommercialFlight(unsigned int id, string departure, string destination, Date date,
                                    unsigned int basePrice, Date duration, PassengerMap passengers)
-        : Flight(id, departure, destination, date, basePrice, duration), passengers(passengers) {}
+        : Flight(id, departure, destination, date, basePrice, duration), passengers(passengers) {
+    claimPassengerSeats();
+    updateOccupancy();
+}
 
 
-PassengerMap &CommercialFlight::getPassengers() {
+const PassengerMap &CommercialFlight::getPassengers() const {
 
     return passengers;
 }
@@ -193,7 +311,38 @@ Passenger *CommercialFlight::getBuyer() const {
 
 void CommercialFlight::setPassengers(PassengerMap passengers) {
 
-    this->passengers = passengers;
+    this->passengers = move(passengers);
+    seats.clear();
+    claimPassengerSeats();
+    updateOccupancy();
+}
+
+void CommercialFlight::claimPassengerSeats() {
+
+    for (auto const &p : passengers) {
+        int seat = SeatMap::index(p.first, getCapacity());
+        if (seat >= 0) seats.claim((size_t) seat);
+    }
+}
+
+void CommercialFlight::resizeSeats(unsigned int capacity) {
+
+    seats.resize(capacity / SeatMap::ROW_SEATS * SeatMap::ROW_SEATS);
+    claimPassengerSeats();
+}
+
+bool CommercialFlight::claim(const string &seat, Passenger *) {
+
+    int index = SeatMap::index(seat, getCapacity());
+    return index >= 0 && seats.claim((size_t) index);
+}
+
+void CommercialFlight::release(const string &seat) {
+
+    passengers.erase(seat);
+    int index = SeatMap::index(seat, getCapacity());
+    if (index >= 0) seats.release((size_t) index);
+    updateOccupancy();
 }
 
 
@@ -225,15 +374,14 @@ void CommercialFlight::print() const {
 CommercialFlight::CommercialFlight(unsigned int id, string departure, string destination, Date date,
                                    unsigned int basePrice, Date duration) : Flight(id, departure, destination,
                                                                                    date, basePrice,
-                                                                                   duration) {
-
-    PassengerMap *passengers = new PassengerMap;
-    this->passengers = *passengers;
-}
+                                                                                   duration) {}
 
 void CommercialFlight::addPassenger(string seat, Passenger *passenger) {
 
     passengers[seat] = passenger;
+    int index = SeatMap::index(seat, getCapacity());
+    if (index >= 0) seats.claim((size_t) index);
+    updateOccupancy();
 }
 
 void CommercialFlight::removePassenger(Passenger *passenger) {
@@ -241,11 +389,14 @@ void CommercialFlight::removePassenger(Passenger *passenger) {
     if (passengers.empty()) return;
     for (auto it = passengers.begin(); it != passengers.end();) {
 
-        if ((*it).second == passenger)
+        if ((*it).second == passenger) {
+            int index = SeatMap::index(it->first, getCapacity());
+            if (index >= 0) seats.release((size_t) index);
             passengers.erase(it++);
-        else
+        } else
             it++;
     }
+    updateOccupancy();
 }
 
 bool compFId(Flight *f1, Flight *f2) {
@@ -256,20 +407,44 @@ bool compFId(Flight *f1, Flight *f2) {
 
 bool compFPriceL(Flight *f1, Flight *f2) {
 
-    return f1->getBasePrice() < f2->getBasePrice();
+    if (f1->getBasePrice() != f2->getBasePrice()) return f1->getBasePrice() < f2->getBasePrice();
+    return f1->getId() < f2->getId();
 }
 
 bool compFPriceH(Flight *f1, Flight *f2) {
 
-    return f1->getBasePrice() > f2->getBasePrice();
+    return compFPriceL(f2, f1);
 }
 
 bool compFTime(Flight *f1, Flight *f2) {
 
-    return f1->getDate() < f2->getDate();
+    if (!(f1->getDate() == f2->getDate())) return f1->getDate() < f2->getDate();
+    return f1->getId() < f2->getId();
 }
 
 bool compFDest(Flight *f1, Flight *f2) {
 
-    return f1->getDestination() < f2->getDestination();
+    if (!(f1->getDestinationSymbol() == f2->getDestinationSymbol()))
+        return f1->getDestinationSymbol() < f2->getDestinationSymbol();
+    return f1->getId() < f2->getId();
+}
+
+uint64_t keyFId(Flight *f) {
+
+    return f->getId();
+}
+
+uint64_t keyFPrice(Flight *f) {
+
+    return (uint64_t) f->getBasePrice() * 100;
+}
+
+uint64_t keyFTime(Flight *f) {
+
+    return dateKey(f->getDate());
+}
+
+uint64_t keyFDest(Flight *f) {
+
+    return prefixKey(f->getDestination());
 }
\ No newline at end of file
@@ -5,29 +5,59 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
+#include <atomic>
 #include "Passenger.h"
+#include "FlightTable.h"
+#include "Symbol.h"
+#include "SeatMap.h"
 
 
 using namespace std;
 
-typedef std::map<string, Passenger *, std::less<string> > PassengerMap;
+typedef std::map<string, PassengerId, std::less<string> > PassengerMap;
 
 
-class Flight {
+class Flight : public Handled<Flight> {
 
 private:
     unsigned int id;
-    string departure;
-    string destination;
+    Symbol departure;
+    Symbol destination;
     Date date;
-    unsigned int basePrice;
     Date duration;
-    unsigned int capacity = 0;
+    /**
+     * @brief flight_type_t of the object
+     */
+    uint8_t kind = FLIGHT_COMMERCIAL;
+
+    /**
+     * @brief Writes the departure and arrival minutes of the Flight to the FlightTable
+     */
+    void updateSchedule();
+
+protected:
+    /**
+     * @brief Sets the type tag of the Flight and of its row of the FlightTable, used by the subclass constructors
+     * @param k flight_type_t k
+     */
+    void setKind(flight_type_t k);
+
+    /**
+     * @brief Called when the capacity of the Flight changes, redefined by the flights that keep a seat map
+     * @param capacity unsigned int capacity
+     */
+    virtual void resizeSeats(unsigned int) {}
 
 public:
 
     Flight();
 
+    /**
+     * @brief Destructor of a Flight object, virtual so flights can be deleted through a Flight pointer
+     */
+    virtual ~Flight() {}
+
     /**
      * @brief Constructor of a Flight object with all of its data members
      * @param id
@@ -40,6 +70,19 @@ public:
     Flight(unsigned int id, string departure, string destination, Date date, unsigned int basePrice,
            Date duration);
 
+    /**
+     * @brief Copy constructor of a Flight object, the copy gets its own row of the FlightTable
+     * @param f const Flight &f
+     */
+    Flight(const Flight &f);
+
+    /**
+     * @brief Copies the data of a Flight object, including its row of the FlightTable
+     * @param f const Flight &f
+     * @return Flight &
+     */
+    Flight &operator=(const Flight &f);
+
     /**
      * @brief Gets the ID of the Flight object
      * @return unsigned int id of the Flight
@@ -58,6 +101,18 @@ public:
      */
     string getDestination() const;
 
+    /**
+     * @brief Gets the interned departure location of the Flight object
+     * @return Symbol departure location of the Flight
+     */
+    Symbol getDepartureSymbol() const;
+
+    /**
+     * @brief Gets the interned destination location of the Flight object
+     * @return Symbol destination location of the Flight
+     */
+    Symbol getDestinationSymbol() const;
+
     /**
      * @brief Gets the base price of the Flight object
      * @return unsigned int base price of the Flight
@@ -71,10 +126,16 @@ public:
     Date getDuration() const;
 
     /**
-     * @brief Purely Virtual function that gets the type of the Flight, "c" if commercial and "r" if rented
+     * @brief Gets the type of the Flight, "c" if commercial and "r" if rented
      * @return string
      */
-    virtual string getType() const = 0;
+    string getType() const { return kind == FLIGHT_RENTED ? "r" : "c"; }
+
+    /**
+     * @brief Gets the type tag of the Flight
+     * @return flight_type_t
+     */
+    flight_type_t getKind() const { return (flight_type_t) kind; }
 
     /**
      * @brief returns capacity of flight
@@ -124,6 +185,11 @@ public:
      */
     void setCapacity(unsigned int capacity);
 
+    /**
+     * @brief Writes the number of seats sold of the Flight to the FlightTable, must be called after the seats change
+     */
+    void updateOccupancy();
+
     /**
      * @brief Prints a summary of a Flight object
      */
@@ -139,6 +205,26 @@ public:
     */
     void printList() const;
 
+    /**
+    * @brief Appends the same row as printList() to the buffer passed as argument
+    * @param out string &out
+    */
+    void formatList(string &out) const;
+
+    /**
+    * @brief Appends the line of the flights file up to the passengers to the buffer passed as argument
+    * @param out string &out
+    */
+    void formatHead(string &out) const;
+
+    /**
+    * @brief Appends the passengers of the seat row of a seat as the flights file writes them
+    * ("1B-10009322, 1C-15091119"), nothing if no passenger sits in the row
+    * @param out string &out
+    * @param seat const string &seat (any seat of the row)
+    */
+    void formatSeatRow(string &out, const string &seat) const;
+
     /**
      * @brief gets the Date of the Flight object
      * @return Date
@@ -159,9 +245,9 @@ public:
 
     /**
      * @brief Purely virtual function redefined in the Commercial Flight subclass
-     * @return PassengerMap & (reference to a PassengerMap)
+     * @return const PassengerMap & (reference to a PassengerMap)
      */
-    virtual PassengerMap &getPassengers() = 0;
+    virtual const PassengerMap &getPassengers() const = 0;
 
     /**
      * @brief Purely virtual function redefined in the Rented Flight subclass
@@ -187,6 +273,27 @@ public:
      * @param passenger Passenger * passenger
      */
     virtual void removePassenger(Passenger *passenger) = 0;
+
+    /**
+     * @brief Takes a seat of a CommercialFlight, or the whole RentedFlight, for a passenger. Thread safe: of many
+     * concurrent claims of the same seat exactly one succeeds. The booking itself is recorded later by the caller
+     * @param seat const string &seat (ignored by a RentedFlight)
+     * @param passenger Passenger *passenger
+     * @return true if the seat was free and is now taken and false otherwise
+     */
+    virtual bool claim(const string &seat, Passenger *passenger) = 0;
+
+    /**
+     * @brief Frees a booked seat of a CommercialFlight, or the buyer of a RentedFlight
+     * @param seat const string &seat (ignored by a RentedFlight)
+     */
+    virtual void release(const string &seat) = 0;
+
+    /**
+     * @brief Gets the taken seats of the Flight, redefined by the flights that keep a seat map
+     * @return const SeatMap * (nullptr if the Flight has no seats)
+     */
+    virtual const SeatMap *getSeatMap() const { return nullptr; }
 /** @name Flight functions to overload operators*/
     /** @{
     *
@@ -218,7 +325,10 @@ public:
 class RentedFlight : public Flight {
 
 private:
-    Passenger *buyer;
+    /**
+     * @brief handle of the buyer, PassengerId::NIL if the flight was not rented, set by compare-and-swap
+     */
+    atomic<uint32_t> buyer;
 
 public:
     /**
@@ -239,6 +349,26 @@ public:
     RentedFlight(unsigned int id, string departure, string destination, Date date,
                  unsigned int basePrice, Date duration, Passenger *buyer);
 
+    /**
+     * @brief Copy constructor of a RentedFlight object
+     * @param f const RentedFlight &f
+     */
+    RentedFlight(const RentedFlight &f);
+
+    /**
+     * @brief Allocates a RentedFlight from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a RentedFlight to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     /**
      * @brief Gets a pointer to the buyer of the RentedFlight
      * @return Passenger* pointer to a Passenger object
@@ -247,15 +377,9 @@ public:
 
     /**
      * @brief Inherited from the superclass to be used in CommercialFlight
-     * @return PassengerMap& (reference to a PassengerMap)
+     * @return const PassengerMap& (reference to an empty PassengerMap shared by every RentedFlight, which has no seats)
      */
-    PassengerMap &getPassengers();
-
-    /**
-     * @brief Used to know if a Flight object is Rented or Commercial
-     * @return "r" string "r"
-     */
-    string getType() const { return "r"; }
+    const PassengerMap &getPassengers() const;
 
     /**
      * @brief Sets the buyer of a RentedFlight to the one passed as a parameter
@@ -287,12 +411,42 @@ public:
      */
     void removePassenger(Passenger *passenger);
 
+    /**
+     * @brief Sets the buyer if the flight has none, with a compare-and-swap
+     * @param seat const string &seat (ignored)
+     * @param passenger Passenger *passenger
+     * @return true if the passenger is now the buyer and false if the flight was already rented
+     */
+    bool claim(const string &seat, Passenger *passenger);
+
+    /**
+     * @brief Removes the buyer
+     * @param seat const string &seat (ignored)
+     */
+    void release(const string &seat);
 };
 
 class CommercialFlight : public Flight {
 
 private:
     PassengerMap passengers;
+    /**
+     * @brief taken seats: the seats of passengers plus the seats claimed and not recorded yet
+     */
+    SeatMap seats;
+
+    /**
+     * @brief Claims the seats of the passengers that fit in the seat map, the seats already claimed keep their bit
+     */
+    void claimPassengerSeats();
+
+protected:
+    /**
+     * @brief Resizes the seat map to the capacity passed as argument, keeping the seats that remain claimed (so the
+     * held seats keep their bit) and claiming the seats of the passengers that now fit
+     * @param capacity unsigned int capacity
+     */
+    void resizeSeats(unsigned int capacity);
 
 public:
 
@@ -323,6 +477,20 @@ public:
     CommercialFlight(unsigned int id, string departure, string destination, Date date,
                      unsigned int basePrice, Date duration, PassengerMap passengers);
 
+    /**
+     * @brief Allocates a CommercialFlight from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a CommercialFlight to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     /**
      * @brief Inherited from the superclass used in RentedFlight
      * @return Passenger * passenger
@@ -331,15 +499,9 @@ public:
 
     /**
      * @ Gets the PassengerMap(map with the seats and the passengers) of a CommercialFlight
-     * @return PassengerMap PassengerMap&
+     * @return const PassengerMap&
      */
-    PassengerMap &getPassengers();
-
-    /**
-      * @brief Used to know if a Flight object is Rented or Commercial
-      * @return string "c"
-      */
-    string getType() const { return "c"; }
+    const PassengerMap &getPassengers() const;
 
     /**
     * @brief Inherited from the super class used in RentedFlight class
@@ -348,7 +510,8 @@ public:
     void setBuyer(Passenger *buyer);
 
     /**
-     * @brief Sets the PassengersMap data member of a Commercial Flight to the map passed as parameter
+     * @brief Sets the PassengersMap data member of a Commercial Flight to the map passed as parameter and rebuilds the
+     * seat map from it, so the seats held on the flight are freed too
      * @param passengers  PassengerMap passengers
      */
     void setPassengers(PassengerMap passengers);
@@ -366,6 +529,26 @@ public:
      */
     void removePassenger(Passenger *passenger);
 
+    /**
+     * @brief Claims a free seat in the seat map
+     * @param seat const string &seat
+     * @param passenger Passenger *passenger
+     * @return true if the seat exists and was free and false otherwise
+     */
+    bool claim(const string &seat, Passenger *passenger);
+
+    /**
+     * @brief Removes the passenger of a seat and frees the seat
+     * @param seat const string &seat
+     */
+    void release(const string &seat);
+
+    /**
+     * @brief Gets the seat map of the CommercialFlight
+     * @return const SeatMap *
+     */
+    const SeatMap *getSeatMap() const { return &seats; }
+
     /**
      * @brief Prints the Information of the RentedFlight. Data-members inherited from the Flight class and the passengers from the PassengerMap
      */
@@ -384,7 +567,7 @@ bool compFId(Flight *f1, Flight *f2);
  * @brief Compares two objects of class Flight based on their price (low to high)
  * @param f1 Flight* f1
  * @param f2 Flight* f2
- * @return returns true if f1's price is less than f2's price
+ * @return returns true if f1's price is less than f2's price (or the prices are equal and f1's id is less)
  */
 bool compFPriceL(Flight *f1, Flight *f2);
 
@@ -392,7 +575,7 @@ bool compFPriceL(Flight *f1, Flight *f2);
  * @brief Compares two objects of class Flight based on their price (high to low)
  * @param f1 Flight* f1
  * @param f2 Flight* f2
- * @return returns true is f1's price is greater than f2's price
+ * @return returns true if compFPriceL(f2, f1), the exact reverse of the low to high order
  */
 bool compFPriceH(Flight *f1, Flight *f2);
 
@@ -400,7 +583,7 @@ bool compFPriceH(Flight *f1, Flight *f2);
  * @brief Compares two objects of class Flight based on their Time to flight
  * @param f1 Flight* f1
  * @param f2 Flight* f2
- * @return returns true if f1's time to flight is less than f2's time to flight
+ * @return returns true if f1's time to flight is less than f2's time to flight (ties by id)
  */
 bool compFTime(Flight *f1, Flight *f2);
 
@@ -408,8 +591,39 @@ bool compFTime(Flight *f1, Flight *f2);
  * @brief Compares two objects of class Flight based on their destination
  * @param f1 Flight* f1
  * @param f2 Flight* f2
- * @return returns true if f1's destination is less than f2's destination
+ * @return returns true if f1's destination is less than f2's destination (ties by id)
  */
 bool compFDest(Flight *f1, Flight *f2);
 
+/**
+ * @brief Sort key consistent with compFId
+ * @param f Flight* f
+ * @return uint64_t
+ */
+uint64_t keyFId(Flight *f);
+
+/**
+ * @brief Sort key consistent with compFPriceL (price in cents)
+ * @param f Flight* f
+ * @return uint64_t
+ */
+uint64_t keyFPrice(Flight *f);
+
+/**
+ * @brief Sort key consistent with compFTime (departure time)
+ * @param f Flight* f
+ * @return uint64_t
+ */
+uint64_t keyFTime(Flight *f);
+
+/**
+ * @brief Sort key consistent with compFDest (destination prefix, ties are settled by compFDest)
+ * @param f Flight* f
+ * @return uint64_t
+ */
+uint64_t keyFDest(Flight *f);
+
+/*! 32-bit handle of a Flight */
+typedef Handle<Flight> FlightId;
+
 #endif //AEDA_FEUP_PROJECT_FLIGHT_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "FlightTable.h"
+
+FlightTable &FlightTable::instance() {
+    static FlightTable *table = new FlightTable;
+    return *table;
+}
+
+void FlightTable::grow(uint32_t slot) {
+    if (slot < kind.size()) return;
+    size_t n = slot + 1;
+    departure.resize(n, 0);
+    arrival.resize(n, 0);
+    basePrice.resize(n, 0);
+    capacity.resize(n, 0);
+    occupancy.resize(n, 0);
+    kind.resize(n, FLIGHT_COMMERCIAL);
+}
+
+void FlightTable::reset(uint32_t slot) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.departure[slot] = t.arrival[slot] = 0;
+    t.basePrice[slot] = t.capacity[slot] = t.occupancy[slot] = 0;
+    t.kind[slot] = FLIGHT_COMMERCIAL;
+}
+
+void FlightTable::copy(uint32_t from, uint32_t to) {
+    FlightTable &t = instance();
+    t.grow(from > to ? from : to);
+    t.departure[to] = t.departure[from];
+    t.arrival[to] = t.arrival[from];
+    t.basePrice[to] = t.basePrice[from];
+    t.capacity[to] = t.capacity[from];
+    t.occupancy[to] = t.occupancy[from];
+    t.kind[to] = t.kind[from];
+}
+
+void FlightTable::setSchedule(uint32_t slot, int64_t departureMinute, int64_t arrivalMinute) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.departure[slot] = departureMinute;
+    t.arrival[slot] = arrivalMinute;
+}
+
+void FlightTable::setBasePrice(uint32_t slot, uint32_t price) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.basePrice[slot] = price;
+}
+
+void FlightTable::setCapacity(uint32_t slot, uint32_t seats) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.capacity[slot] = seats;
+}
+
+void FlightTable::setOccupancy(uint32_t slot, uint32_t seats) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.occupancy[slot] = seats;
+}
+
+void FlightTable::setKind(uint32_t slot, flight_type_t k) {
+    FlightTable &t = instance();
+    t.grow(slot);
+    t.kind[slot] = (uint8_t) k;
+}
+
+int64_t FlightTable::getDeparture(uint32_t slot) {
+    return instance().departure[slot];
+}
+
+int64_t FlightTable::getArrival(uint32_t slot) {
+    return instance().arrival[slot];
+}
+
+uint32_t FlightTable::getBasePrice(uint32_t slot) {
+    return instance().basePrice[slot];
+}
+
+uint32_t FlightTable::getCapacity(uint32_t slot) {
+    return instance().capacity[slot];
+}
+
+uint32_t FlightTable::getOccupancy(uint32_t slot) {
+    return instance().occupancy[slot];
+}
+
+void FlightTable::selectLanded(int64_t now, vector<uint8_t> &mask) {
+    const FlightTable &t = instance();
+    size_t n = t.arrival.size();
+    mask.resize(n);
+    const int64_t *arr = t.arrival.data();
+    uint8_t *out = mask.data();
+    // branch-free so the compiler can vectorize the loop
+    for (size_t i = 0; i < n; i++) out[i] = (uint8_t) (arr[i] < now);
+}
+
+void FlightTable::selectAvailable(flight_type_t k, vector<uint8_t> &mask) {
+    const FlightTable &t = instance();
+    size_t n = t.kind.size();
+    mask.resize(n);
+    const uint8_t *kd = t.kind.data();
+    const uint32_t *occ = t.occupancy.data();
+    const uint32_t *cap = t.capacity.data();
+    uint8_t *out = mask.data();
+    // a rented flight can be sold while it has no buyer, a commercial one while it has free seats
+    if (k == FLIGHT_RENTED)
+        for (size_t i = 0; i < n; i++) out[i] = (uint8_t) ((kd[i] == FLIGHT_RENTED) & (occ[i] == 0));
+    else
+        for (size_t i = 0; i < n; i++) out[i] = (uint8_t) ((kd[i] == FLIGHT_COMMERCIAL) & (occ[i] < cap[i]));
+}
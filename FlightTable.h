@@ -0,0 +1,162 @@
+#ifndef AEDA_FEUP_PROJECT_FLIGHTTABLE_H
+#define AEDA_FEUP_PROJECT_FLIGHTTABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/*! type of a flight in the FlightTable */
+enum flight_type_t {
+    FLIGHT_COMMERCIAL = 0, /*!< CommercialFlight, sold by seat */
+    FLIGHT_RENTED = 1      /*!< RentedFlight, sold as a whole */
+};
+
+/**
+ * Hot fields of every flight, kept in parallel arrays indexed by the slot of the flight handle.
+ * The Flight objects keep the cold data (names, dates for printing, seat maps); scans that only need the
+ * schedule, price, capacity or occupancy of the flights run over these arrays, so the loops are contiguous and
+ * can be vectorized by the compiler.
+ */
+class FlightTable {
+
+private:
+    /**
+     * @brief departure of each flight, in minutes (Date::convertToMinutes)
+     */
+    vector<int64_t> departure;
+    /**
+     * @brief arrival of each flight, in minutes
+     */
+    vector<int64_t> arrival;
+    /**
+     * @brief base price of each flight
+     */
+    vector<uint32_t> basePrice;
+    /**
+     * @brief capacity of each flight
+     */
+    vector<uint32_t> capacity;
+    /**
+     * @brief number of seats sold of each flight (1 for a rented flight with a buyer)
+     */
+    vector<uint32_t> occupancy;
+    /**
+     * @brief flight_type_t of each flight
+     */
+    vector<uint8_t> kind;
+
+    /**
+     * @brief Gets the table (never destroyed, so flights may be deleted at any point of the exit)
+     * @return FlightTable &
+     */
+    static FlightTable &instance();
+
+    /**
+     * @brief Makes room for the slot passed as argument
+     * @param slot uint32_t slot
+     */
+    void grow(uint32_t slot);
+
+public:
+    /**
+     * @brief Clears the row of a new flight
+     * @param slot uint32_t slot
+     */
+    static void reset(uint32_t slot);
+
+    /**
+     * @brief Copies the row of a flight to the row of another one
+     * @param from uint32_t from
+     * @param to uint32_t to
+     */
+    static void copy(uint32_t from, uint32_t to);
+
+    /**
+     * @brief Sets the departure and the arrival of a flight
+     * @param slot uint32_t slot
+     * @param departureMinute int64_t departureMinute
+     * @param arrivalMinute int64_t arrivalMinute
+     */
+    static void setSchedule(uint32_t slot, int64_t departureMinute, int64_t arrivalMinute);
+
+    /**
+     * @brief Sets the base price of a flight
+     * @param slot uint32_t slot
+     * @param price uint32_t price
+     */
+    static void setBasePrice(uint32_t slot, uint32_t price);
+
+    /**
+     * @brief Sets the capacity of a flight
+     * @param slot uint32_t slot
+     * @param seats uint32_t seats
+     */
+    static void setCapacity(uint32_t slot, uint32_t seats);
+
+    /**
+     * @brief Sets the occupancy of a flight
+     * @param slot uint32_t slot
+     * @param seats uint32_t seats
+     */
+    static void setOccupancy(uint32_t slot, uint32_t seats);
+
+    /**
+     * @brief Sets the type of a flight
+     * @param slot uint32_t slot
+     * @param k flight_type_t k
+     */
+    static void setKind(uint32_t slot, flight_type_t k);
+
+    /**
+     * @brief Gets the departure of a flight in minutes
+     * @param slot uint32_t slot
+     * @return int64_t
+     */
+    static int64_t getDeparture(uint32_t slot);
+
+    /**
+     * @brief Gets the arrival of a flight in minutes
+     * @param slot uint32_t slot
+     * @return int64_t
+     */
+    static int64_t getArrival(uint32_t slot);
+
+    /**
+     * @brief Gets the base price of a flight
+     * @param slot uint32_t slot
+     * @return uint32_t
+     */
+    static uint32_t getBasePrice(uint32_t slot);
+
+    /**
+     * @brief Gets the capacity of a flight
+     * @param slot uint32_t slot
+     * @return uint32_t
+     */
+    static uint32_t getCapacity(uint32_t slot);
+
+    /**
+     * @brief Gets the occupancy of a flight
+     * @param slot uint32_t slot
+     * @return uint32_t
+     */
+    static uint32_t getOccupancy(uint32_t slot);
+
+    /**
+     * @brief Marks the flights that landed before the minute passed as argument
+     * @param now int64_t now
+     * @param mask vector<uint8_t> &mask (mask[slot] is 1 if the flight of the slot landed)
+     */
+    static void selectLanded(int64_t now, vector<uint8_t> &mask);
+
+    /**
+     * @brief Marks the flights of a type that can still be sold (free seats, or no buyer for a rented flight)
+     * @param k flight_type_t k
+     * @param mask vector<uint8_t> &mask (mask[slot] is 1 if the flight of the slot can be sold)
+     */
+    static void selectAvailable(flight_type_t k, vector<uint8_t> &mask);
+};
+
+#endif //AEDA_FEUP_PROJECT_FLIGHTTABLE_H
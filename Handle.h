@@ -0,0 +1,271 @@
+#ifndef AEDA_FEUP_PROJECT_HANDLE_H
+#define AEDA_FEUP_PROJECT_HANDLE_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+template<class T>
+class Handled;
+
+/**
+ * Dense table of the live objects of type T, indexed by their handle.
+ * Every Handled<T> takes a slot when it is constructed and frees it when it is destroyed; freed slots are
+ * reused, so the table stays as small as the number of live objects. A handle packs the slot with the generation
+ * of the slot, which is bumped on every release, so a handle kept past the death of its object resolves to nullptr
+ * instead of to the next object of the slot (until the generation wraps, after GENERATIONS reuses of the slot).
+ * The slots live in blocks that never move, so a thread can resolve the handles it holds while another thread
+ * creates objects. acquire() and release() are not thread safe: the callers must serialize them, and no thread may
+ * resolve the handle of an object while it is destroyed (the Company creates and deletes objects holding every
+ * shard exclusive).
+ */
+template<class T>
+class HandleTable {
+
+private:
+    /**
+     * @brief log2 of the number of slots of a block
+     */
+    static const uint32_t BLOCK_BITS = 12;
+    /**
+     * @brief number of slots of a block
+     */
+    static const uint32_t BLOCK_SLOTS = 1u << BLOCK_BITS;
+    /**
+     * @brief largest number of blocks (64M objects of each type)
+     */
+    static const uint32_t MAX_BLOCKS = 1u << 14;
+
+public:
+    /**
+     * @brief number of bits of a handle that hold the slot, the others hold the generation of the slot
+     */
+    static const uint32_t SLOT_BITS = 26;
+    /**
+     * @brief mask of the slot of a handle
+     */
+    static const uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+    /**
+     * @brief number of generations of a slot before a handle of the slot is reused
+     */
+    static const uint32_t GENERATIONS = 1u << (32 - SLOT_BITS);
+
+private:
+    //! struct Slot
+    /*! Slot of the table */
+    struct Slot {
+        Handled<T> *object;  /*!< object of the slot, nullptr if it is free */
+        uint32_t generation; /*!< times the slot was released, modulo GENERATIONS */
+    };
+
+    /**
+     * @brief blocks of slots
+     */
+    unique_ptr<atomic<Slot *>[]> blocks;
+    /**
+     * @brief number of slots in use or freed
+     */
+    uint32_t used = 0;
+    /**
+     * @brief free slots
+     */
+    vector<uint32_t> freeSlots;
+
+    HandleTable() : blocks(new atomic<Slot *>[MAX_BLOCKS]) {
+        for (uint32_t i = 0; i < MAX_BLOCKS; i++) blocks[i].store(nullptr, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the slot of the table
+     * @param slot uint32_t slot (inside a block that exists)
+     * @return Slot &
+     */
+    Slot &at(uint32_t slot) {
+        return blocks[slot >> BLOCK_BITS].load(memory_order_acquire)[slot & (BLOCK_SLOTS - 1)];
+    }
+
+    /**
+     * @brief Gets the table of type T (never destroyed, so objects may be deleted at any point of the exit)
+     * @return HandleTable &
+     */
+    static HandleTable &instance() {
+        static HandleTable *table = new HandleTable;
+        return *table;
+    }
+
+public:
+    /**
+     * @brief Gives a slot to an object, not thread safe (see HandleTable)
+     * @param object Handled<T> *object
+     * @return uint32_t handle (slot and generation)
+     * @throw length_error if MAX_BLOCKS * BLOCK_SLOTS objects of the type are alive, a handle cannot hold more slots
+     */
+    static uint32_t acquire(Handled<T> *object) {
+        HandleTable &table = instance();
+        uint32_t slot;
+        if (table.freeSlots.empty()) {
+            if (table.used == MAX_BLOCKS * BLOCK_SLOTS)
+                throw length_error("HandleTable: more than " + to_string(MAX_BLOCKS * BLOCK_SLOTS) +
+                                   " live objects of one type");
+            slot = table.used++;
+            if ((slot & (BLOCK_SLOTS - 1)) == 0) {
+                Slot *block = new Slot[BLOCK_SLOTS]();
+                table.blocks[slot >> BLOCK_BITS].store(block, memory_order_release);
+            }
+        } else {
+            slot = table.freeSlots.back();
+            table.freeSlots.pop_back();
+        }
+        Slot &s = table.at(slot);
+        s.object = object;
+        return s.generation << SLOT_BITS | slot;
+    }
+
+    /**
+     * @brief Frees the slot of a destroyed object and bumps its generation, not thread safe (see HandleTable)
+     * @param handle uint32_t handle
+     */
+    static void release(uint32_t handle) {
+        HandleTable &table = instance();
+        uint32_t slot = handle & SLOT_MASK;
+        Slot &s = table.at(slot);
+        s.object = nullptr;
+        s.generation = (s.generation + 1) % GENERATIONS;
+        table.freeSlots.push_back(slot);
+    }
+
+    /**
+     * @brief Gets the object of a handle
+     * @param handle uint32_t handle
+     * @return T *, nullptr if the slot is free, was reused since the handle was taken or is out of the table
+     */
+    static T *resolve(uint32_t handle) {
+        HandleTable &table = instance();
+        uint32_t slot = handle & SLOT_MASK;
+        Slot *block = table.blocks[slot >> BLOCK_BITS].load(memory_order_acquire);
+        if (block == nullptr) return nullptr;
+        const Slot &s = block[slot & (BLOCK_SLOTS - 1)];
+        if (s.generation != handle >> SLOT_BITS) return nullptr;
+        return static_cast<T *>(s.object);
+    }
+
+    /**
+     * @brief Gets the number of slots of the table
+     * @return size_t
+     */
+    static size_t capacity() {
+        return instance().used;
+    }
+};
+
+template<class T>
+const uint32_t HandleTable<T>::BLOCK_BITS;
+
+template<class T>
+const uint32_t HandleTable<T>::BLOCK_SLOTS;
+
+template<class T>
+const uint32_t HandleTable<T>::MAX_BLOCKS;
+
+template<class T>
+const uint32_t HandleTable<T>::SLOT_BITS;
+
+template<class T>
+const uint32_t HandleTable<T>::SLOT_MASK;
+
+template<class T>
+const uint32_t HandleTable<T>::GENERATIONS;
+
+/**
+ * Base class of the objects that can be referenced by a Handle<T>.
+ * The slot belongs to the object: a copy gets a slot of its own and assignment keeps the slot of the target.
+ */
+template<class T>
+class Handled {
+
+private:
+    /**
+     * @brief handle of the object in HandleTable<T> (slot and generation)
+     */
+    uint32_t handle;
+
+protected:
+    Handled() : handle(HandleTable<T>::acquire(this)) {}
+
+    Handled(const Handled &) : handle(HandleTable<T>::acquire(this)) {}
+
+    Handled &operator=(const Handled &) { return *this; }
+
+    ~Handled() { HandleTable<T>::release(handle); }
+
+public:
+    /**
+     * @brief Gets the slot of the object in HandleTable<T>, which also indexes the columns kept for the object
+     * @return uint32_t
+     */
+    uint32_t getHandleSlot() const { return handle & HandleTable<T>::SLOT_MASK; }
+
+    /**
+     * @brief Gets the handle of the object (slot and generation)
+     * @return uint32_t
+     */
+    uint32_t getHandle() const { return handle; }
+};
+
+/**
+ * Typed 32-bit reference to an object of type T, resolved through HandleTable<T>.
+ * Handles are half the size of a pointer and do not depend on where the object lives in memory. They convert
+ * to and from T * so they can be used where the code expects a pointer, and a handle of a destroyed object gets
+ * nullptr instead of the object that took its slot.
+ */
+template<class T>
+class Handle {
+
+public:
+    /**
+     * @brief value of the null handle (the last generation of the last slot of a full table)
+     */
+    static const uint32_t NIL = UINT32_MAX;
+
+private:
+    /**
+     * @brief handle of the referenced object (slot and generation)
+     */
+    uint32_t value;
+
+public:
+    Handle() : value(NIL) {}
+
+    Handle(nullptr_t) : value(NIL) {}
+
+    Handle(const T *object) : value(object == nullptr ? NIL : object->getHandle()) {}
+
+    /**
+     * @brief Gets the referenced object
+     * @return T *, nullptr for the null handle or if the object was destroyed
+     */
+    T *get() const { return value == NIL ? nullptr : HandleTable<T>::resolve(value); }
+
+    operator T *() const { return get(); }
+
+    T *operator->() const { return get(); }
+
+    T &operator*() const { return *get(); }
+
+    /**
+     * @brief Gets the value of the handle (slot and generation), which HandleTable<T>::resolve() takes back
+     * @return uint32_t, NIL for the null handle
+     */
+    uint32_t getValue() const { return value; }
+};
+
+template<class T>
+const uint32_t Handle<T>::NIL;
+
+#endif //AEDA_FEUP_PROJECT_HANDLE_H
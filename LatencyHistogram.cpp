@@ -0,0 +1,61 @@
+#include "LatencyHistogram.h"
+#include <sstream>
+#include <iomanip>
+
+const int LatencyHistogram::BUCKETS;
+
+void LatencyHistogram::record(uint64_t ns) {
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && (ns >> (bucket + 1)) != 0) bucket++;
+    counts[bucket]++;
+    samples++;
+    totalNs += ns;
+    if (ns > maxNs) maxNs = ns;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &h) {
+    for (int i = 0; i < BUCKETS; i++) counts[i] += h.counts[i];
+    samples += h.samples;
+    totalNs += h.totalNs;
+    if (h.maxNs > maxNs) maxNs = h.maxNs;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (samples == 0) return 0;
+    uint64_t rank = (uint64_t) (p / 100.0 * samples);
+    if (rank >= samples) rank = samples - 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen > rank) {
+            uint64_t end = (uint64_t) 1 << (i + 1);
+            return end < maxNs ? end : maxNs;
+        }
+    }
+    return maxNs;
+}
+
+void LatencyHistogram::print(ostream &out, const string &label) const {
+    out << std::left << setw(12) << label << std::right << setw(9) << samples << " ops";
+    if (samples == 0) {
+        out << endl;
+        return;
+    }
+    out << "   mean " << formatDuration(totalNs / samples) << "   p50 <=" << formatDuration(percentile(50))
+        << "   p99 <=" << formatDuration(percentile(99)) << "   max " << formatDuration(maxNs) << endl;
+    for (int i = 0; i < BUCKETS; i++) {
+        if (!counts[i]) continue;
+        uint64_t from = i ? (uint64_t) 1 << i : 0;
+        out << "    [" << setw(7) << formatDuration(from) << ", " << setw(7) << formatDuration((uint64_t) 1 << (i + 1))
+            << ")" << setw(10) << counts[i] << "  " << string((size_t) (counts[i] * 40 / samples), '#') << endl;
+    }
+}
+
+string LatencyHistogram::formatDuration(uint64_t ns) {
+    stringstream s;
+    if (ns < 1000) s << ns << "ns";
+    else if (ns < 1000000) s << ns / 1000 << "us";
+    else if (ns < 1000000000) s << ns / 1000000 << "ms";
+    else s << ns / 1000000000 << "s";
+    return s.str();
+}
@@ -0,0 +1,87 @@
+#ifndef AEDA_FEUP_PROJECT_LATENCYHISTOGRAM_H
+#define AEDA_FEUP_PROJECT_LATENCYHISTOGRAM_H
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Histogram of latencies with power of two buckets: bucket i counts the samples in [2^i, 2^(i+1)) nanoseconds
+ * (bucket 0 also counts the samples of 0 ns). Recording a sample is O(1) and does not allocate.
+ */
+class LatencyHistogram {
+
+public:
+    /**
+     * @brief number of buckets, the last one also counts every slower sample (more than 2^BUCKETS ns, about 18 min)
+     */
+    static const int BUCKETS = 40;
+
+private:
+    /**
+     * @brief number of samples of each bucket
+     */
+    uint64_t counts[BUCKETS] = {};
+    /**
+     * @brief number of samples
+     */
+    uint64_t samples = 0;
+    /**
+     * @brief sum of the samples in nanoseconds
+     */
+    uint64_t totalNs = 0;
+    /**
+     * @brief slowest sample in nanoseconds
+     */
+    uint64_t maxNs = 0;
+
+public:
+    /**
+     * @brief Adds a sample
+     * @param ns uint64_t ns
+     */
+    void record(uint64_t ns);
+
+    /**
+     * @brief Adds the samples of another histogram
+     * @param h const LatencyHistogram &h
+     */
+    void merge(const LatencyHistogram &h);
+
+    /**
+     * @brief Gets the number of samples
+     * @return uint64_t
+     */
+    uint64_t count() const { return samples; }
+
+    /**
+     * @brief Gets the sum of the samples in nanoseconds
+     * @return uint64_t
+     */
+    uint64_t total() const { return totalNs; }
+
+    /**
+     * @brief Gets an upper bound of a percentile (the end of the bucket where it falls, capped by the slowest sample)
+     * @param p double p (between 0 and 100)
+     * @return uint64_t nanoseconds
+     */
+    uint64_t percentile(double p) const;
+
+    /**
+     * @brief Prints the count, mean, p50, p99 and max, followed by one line per non empty bucket
+     * @param out ostream &out
+     * @param label const string &label
+     */
+    void print(ostream &out, const string &label) const;
+
+    /**
+     * @brief Formats a duration with the most readable unit (ns, us, ms or s)
+     * @param ns uint64_t ns
+     * @return string
+     */
+    static string formatDuration(uint64_t ns);
+};
+
+#endif //AEDA_FEUP_PROJECT_LATENCYHISTOGRAM_H
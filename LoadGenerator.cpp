@@ -0,0 +1,212 @@
+#include "LoadGenerator.h"
+
+#ifdef __linux__
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include "UnixSocket.h"
+
+LoadGenerator::~LoadGenerator() {
+    if (fd >= 0) closeSocket(fd);
+}
+
+string LoadGenerator::opName(uint8_t op) {
+    switch (op) {
+        case OP_SEARCH:
+            return "search";
+        case OP_QUOTE:
+            return "quote";
+        case OP_BOOK:
+            return "book";
+        case OP_RETURN:
+            return "return";
+        case OP_ADVANCE:
+            return "advance";
+        default:
+            return "unknown";
+    }
+}
+
+bool LoadGenerator::loadFlights() {
+    string out;
+    FrameWriter request(out);
+    request.begin(0, OP_SEARCH);
+    request.putString("");
+    request.putString("");
+    request.end();
+    for (size_t done = 0; done < out.size();) {
+        ssize_t n = send(fd, out.data() + done, out.size() - done, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        done += n;
+    }
+
+    string in;
+    char chunk[4096];
+    while (in.size() < 4 || in.size() < 4 + (size_t) FrameReader::frameLength(in.data())) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        in.append(chunk, n);
+    }
+
+    FrameReader response(in.data() + 4, FrameReader::frameLength(in.data()));
+    response.getU32();
+    if (response.getU8() != 0) return false;
+    uint32_t count = response.getU32();
+    for (uint32_t i = 0; i < count && response.ok(); i++) {
+        FlightInfo f;
+        f.id = response.getU32();
+        f.type = response.getU8();
+        response.getI64();
+        f.capacity = response.getU32();
+        response.getU32();
+        response.getU32();
+        flights.push_back(f);
+    }
+    return response.ok();
+}
+
+void LoadGenerator::nextRequest(string &out) {
+    FrameWriter request(out);
+    Pending p;
+    p.tag = sent;
+
+    if (!toReturn.empty()) {
+        p.op = OP_RETURN;
+        request.begin(p.tag, p.op);
+        request.putU32(toReturn.front());
+        toReturn.pop_front();
+    } else {
+        const FlightInfo &f = flights[(sent / 3) % flights.size()];
+        switch (sent % 3) {
+            case 0:
+                p.op = OP_SEARCH;
+                request.begin(p.tag, p.op);
+                request.putString("");
+                request.putString("");
+                break;
+            case 1:
+                p.op = OP_QUOTE;
+                request.begin(p.tag, p.op);
+                request.putU32(passengerId);
+                request.putU32(f.id);
+                break;
+            default: {
+                p.op = OP_BOOK;
+                request.begin(p.tag, p.op);
+                request.putU32(passengerId);
+                request.putU32(f.id);
+                uint32_t rows = f.capacity / 6 ? f.capacity / 6 : 1;
+                uint32_t j = sent / 3;
+                string seat = f.type == 0 ? to_string(1 + (j / 6) % rows) + (char) ('A' + j % 6) : "ALL";
+                request.putString(seat);
+                break;
+            }
+        }
+    }
+    request.end();
+    p.sent = chrono::steady_clock::now();
+    pending.push_back(p);
+    sent++;
+}
+
+void LoadGenerator::onResponse(FrameReader &response, uint8_t status, const Pending &request) {
+    auto latency = chrono::steady_clock::now() - request.sent;
+    string name = opName(request.op);
+    latencies[name].record((uint64_t) chrono::duration_cast<chrono::nanoseconds>(latency).count());
+    if (status != 0) failures[name]++;
+    else if (request.op == OP_BOOK) toReturn.push_back(response.getU32());
+}
+
+int LoadGenerator::run(const string &socketPath, unsigned int requests, unsigned int depth) {
+
+    fd = connectUnix(socketPath);
+    if (fd < 0) {
+        cout << "Failed to connect to " << socketPath << ": " << strerror(errno) << ".\n";
+        return 1;
+    }
+    if (!loadFlights()) {
+        cout << "The search of the flights failed.\n";
+        return 1;
+    }
+    if (flights.empty()) {
+        cout << "There are no flights to book.\n";
+        return 1;
+    }
+    setNonBlocking(fd);
+    if (depth == 0) depth = 1;
+
+    string out, in;
+    size_t outSent = 0;
+    unsigned int answered = 0;
+    char chunk[1 << 16];
+
+    auto start = chrono::steady_clock::now();
+    while (answered < requests) {
+        while (pending.size() < depth && sent < requests) nextRequest(out);
+
+        pollfd p;
+        p.fd = fd;
+        p.events = (short) (POLLIN | (outSent < out.size() ? POLLOUT : 0));
+        p.revents = 0;
+        if (poll(&p, 1, 5000) <= 0) {
+            cout << "The server stopped answering.\n";
+            break;
+        }
+
+        if (p.revents & POLLOUT) {
+            ssize_t n = send(fd, out.data() + outSent, out.size() - outSent, MSG_NOSIGNAL);
+            if (n > 0) outSent += n;
+            if (outSent == out.size()) {
+                out.clear();
+                outSent = 0;
+            }
+        }
+
+        if (p.revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+                cout << "The server closed the connection.\n";
+                break;
+            }
+            if (n > 0) in.append(chunk, n);
+
+            size_t pos = 0;
+            while (in.size() - pos >= 4 && in.size() - pos >= 4 + (size_t) FrameReader::frameLength(in.data() + pos)) {
+                uint32_t length = FrameReader::frameLength(in.data() + pos);
+                FrameReader response(in.data() + pos + 4, length);
+                uint32_t tag = response.getU32();
+                uint8_t status = response.getU8();
+                if (pending.empty() || pending.front().tag != tag) {
+                    cout << "Unexpected response " << tag << ".\n";
+                    return 1;
+                }
+                onResponse(response, status, pending.front());
+                pending.pop_front();
+                answered++;
+                pos += 4 + length;
+            }
+            in.erase(0, pos);
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\n[LOAD REPORT]\n\n";
+    stringstream summary;
+    summary << answered << " requests (depth " << depth << ", " << flights.size() << " flights) in " << fixed
+            << setprecision(3) << seconds << " s";
+    if (seconds > 0) summary << ", " << setprecision(0) << answered / seconds << " requests/s";
+    cout << summary.str() << "\n\n";
+    for (auto const &l : latencies) {
+        l.second.print(cout, l.first);
+        auto f = failures.find(l.first);
+        if (f != failures.end()) cout << "    " << f->second << " answered with an error\n";
+    }
+    return 0;
+}
+
+#endif //__linux__
@@ -0,0 +1,120 @@
+#ifndef AEDA_FEUP_PROJECT_LOADGENERATOR_H
+#define AEDA_FEUP_PROJECT_LOADGENERATOR_H
+
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <chrono>
+#include "Protocol.h"
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+/**
+ * Client of the BookingServer that measures it through its Unix socket.
+ * It first searches every flight, then keeps a fixed number of requests in flight on one connection (pipelining):
+ * searches of a route, quotes and bookings of the found flights, and the return of every booking that succeeded.
+ * At the end it reports the operations per second and a latency histogram per request type.
+ */
+class LoadGenerator {
+
+private:
+    /**
+     * Flight found by the first search
+     */
+    struct FlightInfo {
+        uint32_t id;
+        uint8_t type;
+        uint32_t capacity;
+    };
+
+    /**
+     * Request sent and not answered yet
+     */
+    struct Pending {
+        uint32_t tag;
+        uint8_t op;
+        chrono::steady_clock::time_point sent;
+    };
+
+    /**
+     * @brief socket connected to the server
+     */
+    int fd = -1;
+    /**
+     * @brief passenger used for the quotes and the bookings
+     */
+    uint32_t passengerId;
+    /**
+     * @brief flights found by the first search
+     */
+    vector<FlightInfo> flights;
+    /**
+     * @brief bookings to return
+     */
+    deque<uint32_t> toReturn;
+    /**
+     * @brief requests in flight, in the order they were sent
+     */
+    deque<Pending> pending;
+    /**
+     * @brief latency of each request type
+     */
+    map<string, LatencyHistogram> latencies;
+    /**
+     * @brief number of requests answered with an error, per request type
+     */
+    map<string, uint64_t> failures;
+    /**
+     * @brief number of requests sent
+     */
+    uint32_t sent = 0;
+
+    /**
+     * @brief Sends a search of every flight and waits for the answer
+     * @return true if the search succeeded and false otherwise
+     */
+    bool loadFlights();
+
+    /**
+     * @brief Appends the next request of the mix to a buffer
+     * @param out string &out
+     */
+    void nextRequest(string &out);
+
+    /**
+     * @brief Handles a response
+     * @param response FrameReader &response (after the tag)
+     * @param status uint8_t status
+     * @param request const Pending &request
+     */
+    void onResponse(FrameReader &response, uint8_t status, const Pending &request);
+
+    /**
+     * @brief Gets the name of a protocol_op_t
+     * @param op uint8_t op
+     * @return string
+     */
+    static string opName(uint8_t op);
+
+public:
+    explicit LoadGenerator(uint32_t passengerId) : passengerId(passengerId) {}
+
+    ~LoadGenerator();
+
+    /**
+     * @brief Connects to the server and sends requests keeping depth of them in flight
+     * @param socketPath const string &socketPath
+     * @param requests unsigned int requests
+     * @param depth unsigned int depth
+     * @return int 0 if the run finished and 1 if the server could not be reached
+     */
+    int run(const string &socketPath, unsigned int requests, unsigned int depth);
+};
+
+#endif //__linux__
+
+#endif //AEDA_FEUP_PROJECT_LOADGENERATOR_H
@@ -0,0 +1,248 @@
+#include "NameIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <unordered_set>
+
+/**
+ * @brief minimum fraction of the trigrams of the query that a name must contain to be a fuzzy match
+ */
+static const double FUZZY_THRESHOLD = 0.5;
+
+static bool compWord(const pair<string, Passenger *> &a, const pair<string, Passenger *> &b) {
+    return a.first < b.first;
+}
+
+static bool compByName(const pair<string, Passenger *> &a, const pair<string, Passenger *> &b) {
+    if (a.first != b.first) return a.first < b.first;
+    return a.second->getId() < b.second->getId();
+}
+
+NameIndex::NameIndex(const NameIndex &index) {
+    *this = index;
+}
+
+NameIndex &NameIndex::operator=(const NameIndex &index) {
+    lock_guard<mutex> lock(index.merging);
+    words = index.words;
+    sortedWords = index.sortedWords;
+    erasedWords = index.erasedWords;
+    grams = index.grams;
+    entries = index.entries;
+    return *this;
+}
+
+string NameIndex::normalizeName(const string &name) {
+    string normalized;
+    bool space = false;
+    for (auto c : name) {
+        if (isspace((unsigned char) c)) {
+            space = !normalized.empty();
+            continue;
+        }
+        if (space) normalized += ' ';
+        space = false;
+        normalized += (char) tolower((unsigned char) c);
+    }
+    return normalized;
+}
+
+vector<uint32_t> NameIndex::trigrams(const string &s) {
+    vector<uint32_t> result;
+    for (size_t i = 0; i + 3 <= s.size(); i++) {
+        result.push_back((uint32_t) (unsigned char) s[i] << 16 | (uint32_t) (unsigned char) s[i + 1] << 8 |
+                         (uint32_t) (unsigned char) s[i + 2]);
+    }
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void NameIndex::Postings::merge() {
+    if (sorted == items.size()) return;
+    sort(items.begin() + sorted, items.end());
+    inplace_merge(items.begin(), items.begin() + sorted, items.end());
+    sorted = items.size();
+}
+
+void NameIndex::mergeWords() const {
+    lock_guard<mutex> lock(merging);
+    if (sortedWords == words.size()) return;
+    sort(words.begin() + sortedWords, words.end(), compWord);
+    inplace_merge(words.begin(), words.begin() + sortedWords, words.end(), compWord);
+    sortedWords = words.size();
+}
+
+const vector<Passenger *> *NameIndex::postings(uint32_t gram) const {
+    auto it = grams.find(gram);
+    if (it == grams.end()) return nullptr;
+    lock_guard<mutex> lock(merging);
+    it->second.merge();
+    return &it->second.items;
+}
+
+void NameIndex::insert(Passenger *passenger) {
+    if (entries.find(passenger) != entries.end()) erase(passenger);
+
+    Entry entry;
+    entry.name = normalizeName(passenger->getName());
+    for (size_t i = 0; i < entry.name.size(); i++) {
+        if (i == 0 || entry.name[i - 1] == ' ') words.push_back(make_pair(entry.name.substr(i), passenger));
+    }
+
+    vector<uint32_t> nameGrams = trigrams(" " + entry.name + " ");
+    for (auto g : nameGrams) grams[g].items.push_back(passenger);
+    entry.grams = (uint32_t) nameGrams.size();
+    entries[passenger] = entry;
+}
+
+void NameIndex::erase(Passenger *passenger) {
+    auto it = entries.find(passenger);
+    if (it == entries.end()) return;
+
+    const string &name = it->second.name;
+    mergeWords();
+    for (size_t i = 0; i < name.size(); i++) {
+        if (i != 0 && name[i - 1] != ' ') continue;
+        string word = name.substr(i);
+        auto w = lower_bound(words.begin(), words.end(), make_pair(word, (Passenger *) nullptr), compWord);
+        for (; w != words.end() && w->first == word; w++) {
+            if (w->second != passenger) continue;
+            w->second = nullptr;
+            erasedWords++;
+            break;
+        }
+    }
+    if (erasedWords * 2 > words.size()) {
+        words.erase(remove_if(words.begin(), words.end(),
+                              [](const pair<string, Passenger *> &w) { return w.second == nullptr; }), words.end());
+        sortedWords = words.size();
+        erasedWords = 0;
+    }
+
+    for (auto g : trigrams(" " + name + " ")) {
+        auto list = grams.find(g);
+        if (list == grams.end()) continue;
+        Postings &postings = list->second;
+        postings.merge();
+        auto p = lower_bound(postings.items.begin(), postings.items.end(), passenger);
+        if (p != postings.items.end() && *p == passenger) postings.items.erase(p);
+        postings.sorted = postings.items.size();
+        if (postings.items.empty()) grams.erase(list);
+    }
+    entries.erase(it);
+}
+
+void NameIndex::update(Passenger *passenger) {
+    erase(passenger);
+    insert(passenger);
+}
+
+void NameIndex::clear() {
+    words.clear();
+    sortedWords = 0;
+    erasedWords = 0;
+    grams.clear();
+    entries.clear();
+}
+
+size_t NameIndex::size() const {
+    return entries.size();
+}
+
+vector<Passenger *> NameIndex::prefix(string query, size_t limit) const {
+    vector<Passenger *> result;
+    query = normalizeName(query);
+    if (query.empty()) return result;
+
+    mergeWords();
+    unordered_set<Passenger *> seen;
+    for (auto it = lower_bound(words.begin(), words.end(), make_pair(query, (Passenger *) nullptr), compWord);
+         it != words.end() && it->first.compare(0, query.size(), query) == 0; it++) {
+        if (it->second == nullptr || !seen.insert(it->second).second) continue;
+        result.push_back(it->second);
+        if (limit != 0 && result.size() == limit) break;
+    }
+    return result;
+}
+
+vector<Passenger *> NameIndex::substring(string query, size_t limit) const {
+    vector<Passenger *> result;
+    query = normalizeName(query);
+    if (query.empty()) return result;
+
+    vector<pair<string, Passenger *> > matches;
+    if (query.size() < 3) {
+        // too short to have a trigram
+        for (auto const &e : entries)
+            if (e.second.name.find(query) != string::npos) matches.push_back(make_pair(e.second.name, e.first));
+    } else {
+        vector<const vector<Passenger *> *> lists;
+        for (auto g : trigrams(query)) {
+            const vector<Passenger *> *list = postings(g);
+            if (list == nullptr) return result;
+            lists.push_back(list);
+        }
+        sort(lists.begin(), lists.end(),
+             [](const vector<Passenger *> *a, const vector<Passenger *> *b) { return a->size() < b->size(); });
+
+        for (auto p : *lists[0]) {
+            bool all = true;
+            for (size_t i = 1; i < lists.size() && all; i++)
+                all = binary_search(lists[i]->begin(), lists[i]->end(), p);
+            if (!all) continue;
+            // the trigrams may appear in a different order, check the name itself
+            const string &name = entries.at(p).name;
+            if (name.find(query) != string::npos) matches.push_back(make_pair(name, p));
+        }
+    }
+
+    sort(matches.begin(), matches.end(), compByName);
+    if (limit != 0 && matches.size() > limit) matches.resize(limit);
+    for (auto const &m : matches) result.push_back(m.second);
+    return result;
+}
+
+vector<Passenger *> NameIndex::fuzzy(string query, size_t limit) const {
+    vector<Passenger *> result;
+    query = normalizeName(query);
+    if (query.empty()) return result;
+
+    vector<uint32_t> queryGrams = trigrams(" " + query + " ");
+    vector<const vector<Passenger *> *> lists;
+    for (auto g : queryGrams) {
+        const vector<Passenger *> *list = postings(g);
+        if (list != nullptr) lists.push_back(list);
+    }
+    size_t minShared = max((size_t) ceil(FUZZY_THRESHOLD * queryGrams.size()), (size_t) 1);
+    if (lists.size() < minShared) return result;
+
+    // a name that shares minShared trigrams with the query is in one of the lists.size() - minShared + 1
+    // shortest lists, so only those generate candidates
+    sort(lists.begin(), lists.end(),
+         [](const vector<Passenger *> *a, const vector<Passenger *> *b) { return a->size() < b->size(); });
+    size_t candidateLists = lists.size() - minShared + 1;
+
+    unordered_set<Passenger *> candidates;
+    for (size_t i = 0; i < candidateLists; i++) candidates.insert(lists[i]->begin(), lists[i]->end());
+
+    vector<pair<double, pair<string, Passenger *> > > scored;
+    for (auto p : candidates) {
+        size_t shared = 0;
+        for (auto list : lists)
+            if (binary_search(list->begin(), list->end(), p)) shared++;
+        const Entry &entry = entries.at(p);
+        // containment of the query, names with fewer extra trigrams rank higher on ties
+        double score = (double) shared / (double) queryGrams.size() - (double) entry.grams * 1e-6;
+        if (shared >= minShared) scored.push_back(make_pair(score, make_pair(entry.name, p)));
+    }
+
+    sort(scored.begin(), scored.end(),
+         [](const pair<double, pair<string, Passenger *> > &a, const pair<double, pair<string, Passenger *> > &b) {
+             if (a.first != b.first) return a.first > b.first;
+             return compByName(a.second, b.second);
+         });
+    if (limit != 0 && scored.size() > limit) scored.resize(limit);
+    for (auto const &s : scored) result.push_back(s.second.second);
+    return result;
+}
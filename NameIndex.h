@@ -0,0 +1,161 @@
+#ifndef AEDA_FEUP_PROJECT_NAMEINDEX_H
+#define AEDA_FEUP_PROJECT_NAMEINDEX_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+#include <mutex>
+#include "Passenger.h"
+
+using namespace std;
+
+/**
+ * Search index over the normalized names of the passengers.
+ * Prefix queries use a sorted vector with one entry per word of each name, so "cru" finds "Antonio Cruz".
+ * Substring and fuzzy queries use an inverted index of the trigrams of each name: a substring query
+ * intersects the posting lists of its trigrams and a fuzzy query ranks the passengers by shared trigrams.
+ * The queries are const but merge the entries inserted since the last query, under a lock of the index, so any
+ * number of them may run at once while no passenger is inserted or erased.
+ */
+class NameIndex {
+
+private:
+    //! struct Entry
+    /*! Indexed name of a passenger */
+    struct Entry {
+        string name;        /*!< normalized name */
+        uint32_t grams = 0; /*!< number of distinct trigrams of the padded name */
+    };
+
+    //! struct Postings
+    /*! Passengers whose name contains a trigram. New passengers are appended and merged into the sorted
+     * part the next time the list is read, so loading a file does not shift the list on every insert */
+    struct Postings {
+        vector<Passenger *> items; /*!< passengers, ordered by address up to sorted */
+        size_t sorted = 0;         /*!< length of the sorted part of items */
+
+        /**
+         * @brief Merges the unsorted tail into the sorted part
+         */
+        void merge();
+    };
+
+    /**
+     * @brief normalized name starting at each word of every name with its passenger, sorted by name up to sortedWords
+     */
+    mutable vector<pair<string, Passenger *> > words;
+    /**
+     * @brief length of the sorted part of words, new entries are merged the next time words is read
+     */
+    mutable size_t sortedWords = 0;
+    /**
+     * @brief number of erased entries of words, they keep their name with a nullptr passenger until compacted
+     */
+    size_t erasedWords = 0;
+    /**
+     * @brief posting list of every trigram, merged lazily by the queries
+     */
+    mutable unordered_map<uint32_t, Postings> grams;
+    /**
+     * @brief indexed name of every passenger, used to remove it after the name changed
+     */
+    unordered_map<Passenger *, Entry> entries;
+    /**
+     * @brief lock of the lazy merges of words and of the posting lists, so concurrent queries merge them once
+     */
+    mutable mutex merging;
+
+    /**
+     * @brief Merges the unsorted tail of words into the sorted part, thread safe with the other queries
+     */
+    void mergeWords() const;
+
+    /**
+     * @brief Gets the distinct trigrams of the string passed as argument
+     * @param s const string &s
+     * @return vector<uint32_t> sorted trigrams
+     */
+    static vector<uint32_t> trigrams(const string &s);
+
+    /**
+     * @brief Gets the sorted posting list of a trigram (nullptr if no name contains it), thread safe with the other
+     * queries
+     * @param gram uint32_t gram
+     * @return const vector<Passenger *>*
+     */
+    const vector<Passenger *> *postings(uint32_t gram) const;
+
+public:
+    NameIndex() {}
+
+    /**
+     * @brief A copy gets its own merge lock
+     */
+    NameIndex(const NameIndex &index);
+
+    NameIndex &operator=(const NameIndex &index);
+
+    /**
+     * @brief Normalizes a name for the index: lower case, trimmed and with single spaces between words
+     * @param name const string &name
+     * @return string
+     */
+    static string normalizeName(const string &name);
+
+    /**
+     * @brief Indexes the passenger passed as argument
+     * @param passenger Passenger *passenger
+     */
+    void insert(Passenger *passenger);
+
+    /**
+     * @brief Removes the passenger passed as argument from the index
+     * @param passenger Passenger *passenger
+     */
+    void erase(Passenger *passenger);
+
+    /**
+     * @brief Reindexes the passenger passed as argument after its name changed
+     * @param passenger Passenger *passenger
+     */
+    void update(Passenger *passenger);
+
+    /**
+     * @brief Removes every passenger from the index
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of indexed passengers
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gets the passengers with a word of the name starting with the query, ordered by the matching words
+     * @param query string query
+     * @param limit size_t maximum number of results (0 for no limit)
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> prefix(string query, size_t limit = 0) const;
+
+    /**
+     * @brief Gets the passengers whose name contains the query, in name order
+     * @param query string query
+     * @param limit size_t maximum number of results (0 for no limit)
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> substring(string query, size_t limit = 0) const;
+
+    /**
+     * @brief Gets the passengers with a name similar to the query (typos, missing letters), most similar first
+     * @param query string query
+     * @param limit size_t maximum number of results (0 for no limit)
+     * @return vector<Passenger *>
+     */
+    vector<Passenger *> fuzzy(string query, size_t limit = 0) const;
+};
+
+#endif //AEDA_FEUP_PROJECT_NAMEINDEX_H
@@ -0,0 +1,132 @@
+#ifndef AEDA_FEUP_PROJECT_OBJECTPOOL_H
+#define AEDA_FEUP_PROJECT_OBJECTPOOL_H
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Typed pool allocator used by the operator new and operator delete of the entities of the company.
+ * Objects of type T are carved from blocks of SLOTS_PER_BLOCK slots and freed slots go to a free list that is
+ * reused by the next allocation, so long sessions do not fragment the heap. Once every object of the type has
+ * been deleted, trim() gives the blocks back, which drops a whole dataset at once.
+ * Requests with a size other than sizeof(T) (derived classes without their own operators) use the global heap.
+ */
+template<class T>
+class ObjectPool {
+
+private:
+    /**
+     * @brief number of objects of each block
+     */
+    static const size_t SLOTS_PER_BLOCK = 256;
+
+    //! union Slot
+    /*! Storage of one object, or the link to the next free slot */
+    union Slot {
+        Slot *next;                                                   /*!< next free slot */
+        typename aligned_storage<sizeof(T), alignof(T)>::type object; /*!< storage of the object */
+    };
+
+    /**
+     * @brief blocks of slots owned by the pool
+     */
+    vector<unique_ptr<Slot[]> > blocks;
+    /**
+     * @brief first free slot
+     */
+    Slot *freeList = nullptr;
+    /**
+     * @brief number of objects currently allocated from the pool
+     */
+    size_t live = 0;
+
+    /**
+     * @brief Gets the pool of type T (never destroyed, so objects may be deleted at any point of the exit)
+     * @return ObjectPool &
+     */
+    static ObjectPool &instance() {
+        static ObjectPool *pool = new ObjectPool;
+        return *pool;
+    }
+
+    /**
+     * @brief Adds a block of free slots to the pool
+     */
+    void grow() {
+        blocks.emplace_back(new Slot[SLOTS_PER_BLOCK]);
+        Slot *block = blocks.back().get();
+        for (size_t i = 0; i < SLOTS_PER_BLOCK; i++) {
+            block[i].next = freeList;
+            freeList = &block[i];
+        }
+    }
+
+public:
+    /**
+     * @brief Allocates the storage of one object
+     * @param size size_t size requested by operator new
+     * @return void *
+     */
+    static void *allocate(size_t size) {
+        if (size != sizeof(T)) return ::operator new(size);
+        ObjectPool &pool = instance();
+        if (pool.freeList == nullptr) pool.grow();
+        Slot *slot = pool.freeList;
+        pool.freeList = slot->next;
+        pool.live++;
+        return slot;
+    }
+
+    /**
+     * @brief Returns the storage of one object to the pool
+     * @param p void *p
+     * @param size size_t size passed to operator delete
+     */
+    static void release(void *p, size_t size) {
+        if (p == nullptr) return;
+        if (size != sizeof(T)) {
+            ::operator delete(p);
+            return;
+        }
+        ObjectPool &pool = instance();
+        Slot *slot = static_cast<Slot *>(p);
+        slot->next = pool.freeList;
+        pool.freeList = slot;
+        pool.live--;
+    }
+
+    /**
+     * @brief Frees every block of the pool if no object of type T is allocated
+     * @return true if the blocks were freed and false otherwise
+     */
+    static bool trim() {
+        ObjectPool &pool = instance();
+        if (pool.live != 0) return false;
+        pool.blocks.clear();
+        pool.freeList = nullptr;
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of objects of type T currently allocated from the pool
+     * @return size_t
+     */
+    static size_t size() {
+        return instance().live;
+    }
+
+    /**
+     * @brief Gets the number of slots of the pool
+     * @return size_t
+     */
+    static size_t capacity() {
+        return instance().blocks.size() * SLOTS_PER_BLOCK;
+    }
+};
+
+#endif //AEDA_FEUP_PROJECT_OBJECTPOOL_H
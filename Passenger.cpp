@@ -1,9 +1,19 @@
 #include "Passenger.h"
 #include <iomanip>
 #include <string>
+#include "RadixSort.h"
+#include "ObjectPool.h"
 
 Passenger::Passenger(unsigned int id, string name, Date dateOfBirth) : id(id), name(name), dateOfBirth(dateOfBirth) {}
 
+void *Passenger::operator new(size_t size) {
+    return ObjectPool<Passenger>::allocate(size);
+}
+
+void Passenger::operator delete(void *p, size_t size) {
+    ObjectPool<Passenger>::release(p, size);
+}
+
 unsigned int Passenger::getId() const {
     return this->id;
 }
@@ -21,45 +31,32 @@ void Passenger::setId(unsigned int id) {
 }
 
 void Passenger::setName(string name) {
-    this->name = name;
+    this->name = move(name);
 }
 
 void Passenger::setDateOfBirth(Date dateOfBirth) {
     this->dateOfBirth = dateOfBirth;
 }
 
-string Passenger::getType() const {
-
-    return "n";
-}
-
-Card *Passenger::getCard() const {
-
-    return nullptr;
-}
-
 void Passenger::setCard(Card *card) { return; }
 
 
 PassengerWithCard::PassengerWithCard(unsigned int id, string name, Date dateOfBirth, Card *card) : Passenger(id, name,
-                                                                                                             dateOfBirth),
-                                                                                                   card(card) {
+                                                                                                             dateOfBirth) {
+    setKind(PASSENGER_CARD);
+    this->card = card;
 }
 
 PassengerWithCard::PassengerWithCard(unsigned int id, string name, Date dateOfBirth, string job, int nYear = 0)
         : Passenger(id, name, dateOfBirth) {
 
+    setKind(PASSENGER_CARD);
     card = new Card(job, nYear);
 }
 
-
-Card *PassengerWithCard::getCard() const {
-
-    return card;
-}
-
 void PassengerWithCard::setCard(Card *card) {
 
+    if (this->card != card) delete this->card;
     this->card = card;
 }
 
@@ -71,6 +68,17 @@ void Passenger::printSummary() const {
 }
 
 
+void Passenger::formatSummary(string &out) const {
+
+    appendColumn(out, to_string(id), 12);
+    out += "   ";
+    appendColumn(out, name, 30);
+    out += "   ";
+    appendColumn(out, this->getDateOfBirth().print(), 13);
+    out += '\n';
+}
+
+
 void Passenger::print() const {
     cout << "Id: " << id << endl << "Name: " << name << endl << "Date of Birth: " <<
          this->getDateOfBirth().print() << endl;
@@ -91,7 +99,7 @@ Passenger::Passenger() {
 
 ostream &operator<<(ostream &o, const Passenger *p) {
     o << p->getType() << p->getId() << "; " << p->getName() << "; " << p->getDateOfBirth().print();
-    if (p->getType() == "c" && p->getCard() != nullptr) {
+    if (p->getKind() == PASSENGER_CARD && p->getCard() != nullptr) {
         o << "; " << p->getCard()->getJob() << "; " << to_string(p->getCard()->getAvgYrFlights());
     }
     return o;
@@ -99,9 +107,39 @@ ostream &operator<<(ostream &o, const Passenger *p) {
 
 PassengerWithCard::PassengerWithCard() : Passenger() {
 
+    setKind(PASSENGER_CARD);
     card = new Card;
 }
 
+PassengerWithCard::PassengerWithCard(const PassengerWithCard &p) : Passenger(p) {
+
+    card = p.card == nullptr ? nullptr : new Card(*p.card);
+}
+
+PassengerWithCard &PassengerWithCard::operator=(const PassengerWithCard &p) {
+
+    if (this == &p) return *this;
+    Card *own = card;
+    Passenger::operator=(p);
+    card = own;
+    setCard(p.card == nullptr ? nullptr : new Card(*p.card));
+    return *this;
+}
+
+PassengerWithCard::~PassengerWithCard() {
+
+    delete card;
+}
+
+void *PassengerWithCard::operator new(size_t size) {
+    return ObjectPool<PassengerWithCard>::allocate(size);
+}
+
+void PassengerWithCard::operator delete(void *p, size_t size) {
+    ObjectPool<PassengerWithCard>::release(p, size);
+}
+
+
 void PassengerWithCard::print() const {
 
     cout << "Id: " << Passenger::getId() << endl;
@@ -113,11 +151,6 @@ void PassengerWithCard::print() const {
 
 }
 
-string PassengerWithCard::getType() const {
-
-    return "c";
-}
-
 //Compare functions
 
 bool compPID(Passenger *p1, Passenger *p2) {
@@ -128,10 +161,27 @@ bool compPID(Passenger *p1, Passenger *p2) {
 
 bool compPNAME(Passenger *p1, Passenger *p2) {
 
-    return (p1->getName() < p2->getName());
+    if (p1->getName() != p2->getName()) return p1->getName() < p2->getName();
+    return p1->getId() < p2->getId();
 }
 
 bool compPAGE(Passenger *p1, Passenger *p2) {
 
-    return p1->getDateOfBirth() > p2->getDateOfBirth();
+    if (!(p1->getDateOfBirth() == p2->getDateOfBirth())) return p1->getDateOfBirth() > p2->getDateOfBirth();
+    return p1->getId() < p2->getId();
+}
+
+uint64_t keyPID(Passenger *p) {
+
+    return p->getId();
+}
+
+uint64_t keyPNAME(Passenger *p) {
+
+    return prefixKey(p->getName());
+}
+
+uint64_t keyPAGE(Passenger *p) {
+
+    return ~dateKey(p->getDateOfBirth());
 }
\ No newline at end of file
@@ -5,17 +5,42 @@
 #include <string>
 #include <vector>
 #include <queue>
+#include <cstdint>
 #include "Card.h"
 #include "helper.h"
+#include "Handle.h"
 
 using namespace std;
 
-class Passenger {
+/*! type of a passenger, stored in the passenger so it can be checked without a virtual call */
+enum passenger_type_t {
+    PASSENGER_REGULAR = 0, /*!< Passenger without a card */
+    PASSENGER_CARD = 1     /*!< PassengerWithCard */
+};
+
+class Passenger : public Handled<Passenger> {
 
 private:
     unsigned int id;
     string name;
     Date dateOfBirth;
+    /**
+     * @brief passenger_type_t of the object
+     */
+    uint8_t kind = PASSENGER_REGULAR;
+
+protected:
+    /**
+     * @brief Card of the passenger, always nullptr for a Passenger without a card (owned by PassengerWithCard)
+     */
+    Card *card = nullptr;
+
+    /**
+     * @brief Sets the type tag of the object, used by the constructors of the subclasses
+     * @param k passenger_type_t k
+     */
+    void setKind(passenger_type_t k) { kind = (uint8_t) k; }
+
 public:
     /**
      * @brief Default Constructor of a Passenger object
@@ -30,6 +55,25 @@ public:
      */
     Passenger(unsigned int id, string name, Date dateOfBirth);
 
+    /**
+     * @brief Destructor of a Passenger object
+     */
+    virtual ~Passenger() {}
+
+    /**
+     * @brief Allocates a Passenger from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a Passenger to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     //get Methods
     /**
      * @brief Gets the ID number of a Passenger
@@ -73,6 +117,12 @@ public:
      */
     void printSummary() const;
 
+    /**
+     * @brief Appends the same row as printSummary() to the buffer passed as argument
+     * @param out string &out
+     */
+    void formatSummary(string &out) const;
+
     /**
      * @brief Prints the id, name and the date of birth of a Passenger object
      */
@@ -82,13 +132,19 @@ public:
      * @brief checks if the object is a Passenger or a PassengerWithCard
      * @return string "n" if it is a Passenger, "c" if it is a PassengerWithCard
      */
-    virtual string getType() const;
+    string getType() const { return kind == PASSENGER_CARD ? "c" : "n"; }
+
+    /**
+     * @brief Gets the type tag of the object
+     * @return passenger_type_t
+     */
+    passenger_type_t getKind() const { return (passenger_type_t) kind; }
 
     /**
     * @brief Gets the card of the passenger
-    * @return Card * pointer to a Card object related to the Passenger
+    * @return Card * pointer to a Card object related to the Passenger, nullptr if it has no card
     */
-    virtual Card *getCard() const;
+    Card *getCard() const { return card; }
 
     /**
     * @brief Sets the card of the passenger
@@ -116,11 +172,6 @@ public:
 
 class PassengerWithCard : public Passenger {
 
-private:
-    /**
-     * @brief Card pointer to a Card object of a Passenger
-     */
-    Card *card;
 public:
     /**
      * @brief Default constructor of a PassengerWithCard object
@@ -145,16 +196,42 @@ public:
      * @param nYear
      */
     PassengerWithCard(unsigned int id, string name, Date dateOfBirth, string job, int nYear);
-    //get Methods
+
+    /**
+     * @brief Copy constructor of a PassengerWithCard object, the copy gets its own Card
+     * @param p const PassengerWithCard &p
+     */
+    PassengerWithCard(const PassengerWithCard &p);
+
+    /**
+     * @brief Copy assignment of a PassengerWithCard object, the copy gets its own Card
+     * @param p const PassengerWithCard &p
+     * @return PassengerWithCard &
+     */
+    PassengerWithCard &operator=(const PassengerWithCard &p);
+
+    /**
+     * @brief Destructor of a PassengerWithCard object, deletes its Card
+     */
+    ~PassengerWithCard();
+
+    /**
+     * @brief Allocates a PassengerWithCard from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
     /**
-     * @brief Gets the card of a PassengerWithCard object
-     * @return pointer to a Card object
+     * @brief Returns a PassengerWithCard to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
      */
-    Card *getCard() const;
+    static void operator delete(void *p, size_t size);
 
     //Set Methods
     /**
-     * @brief Sets the card of a PassengerWithCard object to the passed parameter
+     * @brief Sets the card of a PassengerWithCard object to the passed parameter, the previous Card is deleted
      * @param *card Card *card
      */
     void setCard(Card *card);
@@ -164,12 +241,6 @@ public:
      */
     void print() const;
 
-    /**
-     * @brief Checks if the PassengerWithCard holds a card object
-     * @return string "c" if the Passenger really has a card
-     */
-    string getType() const;
-
 };
 
 /**
@@ -184,7 +255,7 @@ bool compPID(Passenger *p1, Passenger *p2);
  * @brief compares two objects of class Passenger based on their name
  * @param p1 Passenger * p1
  * @param p2 Passenger * p2
- * @return returns true if p1's name is less than p2's name, false otherwise
+ * @return returns true if p1's name is less than p2's name (or the names are equal and p1's id is less)
  */
 bool compPNAME(Passenger *p1, Passenger *p2);
 
@@ -192,8 +263,32 @@ bool compPNAME(Passenger *p1, Passenger *p2);
  * @brief compares two objects of class Passenger based on their age
  * @param p1 Passenger * p1
  * @param p2 Passenger * p2
- * @return returns true if p1 is younger than p2, false otherwise
+ * @return returns true if p1 is younger than p2 (or as old and p1's id is less), false otherwise
  */
 bool compPAGE(Passenger *p1, Passenger *p2);
 
+/**
+ * @brief sort key consistent with compPID
+ * @param p Passenger * p
+ * @return uint64_t
+ */
+uint64_t keyPID(Passenger *p);
+
+/**
+ * @brief sort key consistent with compPNAME (name prefix, ties are settled by compPNAME)
+ * @param p Passenger * p
+ * @return uint64_t
+ */
+uint64_t keyPNAME(Passenger *p);
+
+/**
+ * @brief sort key consistent with compPAGE
+ * @param p Passenger * p
+ * @return uint64_t
+ */
+uint64_t keyPAGE(Passenger *p);
+
+/*! 32-bit handle of a Passenger */
+typedef Handle<Passenger> PassengerId;
+
 #endif //AEDA_FEUP_PROJECT_PASSENGER_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "PassengerStore.h"
+#include <algorithm>
+
+void PassengerStore::link(uint32_t slot, passenger_status_t status) {
+    Slot &s = slots[slot];
+    s.status = (uint8_t) status;
+    s.prev = tail[status];
+    s.next = NIL;
+    if (tail[status] != NIL) slots[tail[status]].next = slot;
+    else head[status] = slot;
+    tail[status] = slot;
+    count[status]++;
+}
+
+void PassengerStore::unlink(uint32_t slot) {
+    Slot &s = slots[slot];
+    if (s.prev != NIL) slots[s.prev].next = s.next;
+    else head[s.status] = s.next;
+    if (s.next != NIL) slots[s.next].prev = s.prev;
+    else tail[s.status] = s.prev;
+    s.prev = s.next = NIL;
+    count[s.status]--;
+}
+
+uint32_t PassengerStore::slotOf(const Passenger *passenger) const {
+    if (passenger == nullptr) return NIL;
+    uint32_t slot = ids.find(passenger->getId());
+    if (slot == FlatIdMap::NOT_FOUND || slots[slot].passenger != passenger) return NIL;
+    return slot;
+}
+
+bool PassengerStore::insert(Passenger *passenger, passenger_status_t status) {
+    if (passenger == nullptr || ids.contains(passenger->getId())) return false;
+
+    uint32_t slot;
+    if (freeSlot != NIL) {
+        slot = freeSlot;
+        freeSlot = slots[slot].next;
+    } else {
+        slot = (uint32_t) slots.size();
+        slots.emplace_back();
+    }
+    slots[slot].passenger = passenger;
+    link(slot, status);
+    ids.insert(passenger->getId(), slot);
+    return true;
+}
+
+bool PassengerStore::erase(Passenger *passenger) {
+    uint32_t slot = slotOf(passenger);
+    if (slot == NIL) return false;
+
+    unlink(slot);
+    ids.erase(passenger->getId());
+    slots[slot].passenger = nullptr;
+    slots[slot].next = freeSlot;
+    freeSlot = slot;
+    return true;
+}
+
+bool PassengerStore::setStatus(Passenger *passenger, passenger_status_t status) {
+    uint32_t slot = slotOf(passenger);
+    if (slot == NIL || slots[slot].status == status) return false;
+    unlink(slot);
+    link(slot, status);
+    return true;
+}
+
+passenger_status_t PassengerStore::getStatus(const Passenger *passenger) const {
+    uint32_t slot = slotOf(passenger);
+    if (slot == NIL) return PASSENGER_ACTIVE;
+    return (passenger_status_t) slots[slot].status;
+}
+
+Passenger *PassengerStore::find(unsigned int id) const {
+    uint32_t slot = ids.find(id);
+    if (slot == FlatIdMap::NOT_FOUND) return nullptr;
+    return slots[slot].passenger;
+}
+
+bool PassengerStore::contains(const Passenger *passenger) const {
+    return slotOf(passenger) != NIL;
+}
+
+PassengerStore::Range PassengerStore::all() const {
+    if (head[PASSENGER_ACTIVE] == NIL) return Range(this, head[PASSENGER_INACTIVE], false, size());
+    return Range(this, head[PASSENGER_ACTIVE], true, size());
+}
+
+PassengerStore::Range PassengerStore::withStatus(passenger_status_t status) const {
+    return Range(this, head[status], false, count[status]);
+}
+
+size_t PassengerStore::size() const {
+    return count[PASSENGER_ACTIVE] + count[PASSENGER_INACTIVE];
+}
+
+bool PassengerStore::empty() const {
+    return size() == 0;
+}
+
+void PassengerStore::sort(passenger_status_t status, bool (*comp)(Passenger *, Passenger *)) {
+    vector<uint32_t> order;
+    order.reserve(count[status]);
+    for (uint32_t s = head[status]; s != NIL; s = slots[s].next) order.push_back(s);
+    stable_sort(order.begin(), order.end(),
+                [this, comp](uint32_t a, uint32_t b) { return comp(slots[a].passenger, slots[b].passenger); });
+
+    head[status] = tail[status] = NIL;
+    count[status] = 0;
+    for (auto s : order) link(s, status);
+}
+
+void PassengerStore::sortLast(passenger_status_t status, bool (*comp)(Passenger *, Passenger *)) {
+    uint32_t slot = tail[status];
+    if (slot == NIL) return;
+    Passenger *passenger = slots[slot].passenger;
+    uint32_t before = slots[slot].prev;
+    if (before == NIL || !comp(passenger, slots[before].passenger)) return;
+    while (before != NIL && comp(passenger, slots[before].passenger)) before = slots[before].prev;
+
+    // the slot goes right after before (or first), and some slot of the list is still after it
+    unlink(slot);
+    Slot &s = slots[slot];
+    s.status = (uint8_t) status;
+    s.prev = before;
+    s.next = before == NIL ? head[status] : slots[before].next;
+    if (before == NIL) head[status] = slot;
+    else slots[before].next = slot;
+    slots[s.next].prev = slot;
+    count[status]++;
+}
+
+void PassengerStore::clear() {
+    slots.clear();
+    ids.clear();
+    freeSlot = NIL;
+    head[PASSENGER_ACTIVE] = head[PASSENGER_INACTIVE] = NIL;
+    tail[PASSENGER_ACTIVE] = tail[PASSENGER_INACTIVE] = NIL;
+    count[PASSENGER_ACTIVE] = count[PASSENGER_INACTIVE] = 0;
+}
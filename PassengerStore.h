@@ -0,0 +1,237 @@
+#ifndef AEDA_FEUP_PROJECT_PASSENGERSTORE_H
+#define AEDA_FEUP_PROJECT_PASSENGERSTORE_H
+
+#include <vector>
+#include <cstdint>
+#include "Passenger.h"
+#include "FlatIdMap.h"
+
+using namespace std;
+
+/*! status of a passenger in the PassengerStore */
+enum passenger_status_t {
+    PASSENGER_ACTIVE = 0,  /*!< Passenger with a reservation in the last 6 months */
+    PASSENGER_INACTIVE = 1 /*!< Passenger without reservations in the last 6 months */
+};
+
+/**
+ * Single container for every passenger of the company.
+ * Passengers live in the slots of a slot map with a status bit; the slots of each status are chained in an
+ * intrusive doubly linked list, so the active, inactive or all passengers can be iterated without copies and
+ * a status change only relinks one slot. A flat id index gives the slot of a passenger in O(1).
+ */
+class PassengerStore {
+
+public:
+    /**
+     * @brief slot index used as the end of a list
+     */
+    static const uint32_t NIL = UINT32_MAX;
+
+private:
+    //! struct Slot
+    /*! A passenger of the store with its links in the list of its status */
+    struct Slot {
+        Passenger *passenger = nullptr; /*!< passenger, nullptr if the slot is free */
+        uint32_t prev = NIL;            /*!< previous slot with the same status */
+        uint32_t next = NIL;            /*!< next slot with the same status, or next free slot */
+        uint8_t status = PASSENGER_ACTIVE; /*!< passenger_status_t of the passenger */
+    };
+
+    /**
+     * @brief slots of the store
+     */
+    vector<Slot> slots;
+    /**
+     * @brief first free slot, the free slots are chained through Slot::next
+     */
+    uint32_t freeSlot = NIL;
+    /**
+     * @brief first slot of each status list
+     */
+    uint32_t head[2] = {NIL, NIL};
+    /**
+     * @brief last slot of each status list
+     */
+    uint32_t tail[2] = {NIL, NIL};
+    /**
+     * @brief number of passengers of each status
+     */
+    size_t count[2] = {0, 0};
+    /**
+     * @brief slot of each passenger by id
+     */
+    FlatIdMap ids;
+
+    /**
+     * @brief Appends a slot to the list of the status passed as argument
+     * @param slot uint32_t slot
+     * @param status passenger_status_t status
+     */
+    void link(uint32_t slot, passenger_status_t status);
+
+    /**
+     * @brief Removes a slot from the list of its status
+     * @param slot uint32_t slot
+     */
+    void unlink(uint32_t slot);
+
+    /**
+     * @brief Gets the slot of the passenger passed as argument
+     * @param passenger const Passenger *passenger
+     * @return uint32_t slot, NIL if the passenger is not in the store
+     */
+    uint32_t slotOf(const Passenger *passenger) const;
+
+public:
+    /**
+     * Forward iterator over the passengers of one status list, or of the active list followed by the inactive one
+     */
+    class Iterator {
+        const PassengerStore *store;
+        uint32_t slot;
+        bool chain;
+
+    public:
+        Iterator(const PassengerStore *store, uint32_t slot, bool chain) : store(store), slot(slot), chain(chain) {}
+
+        Passenger *operator*() const { return store->slots[slot].passenger; }
+
+        Iterator &operator++() {
+            slot = store->slots[slot].next;
+            if (slot == NIL && chain) {
+                slot = store->head[PASSENGER_INACTIVE];
+                chain = false;
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator &it) const { return slot == it.slot; }
+
+        bool operator!=(const Iterator &it) const { return slot != it.slot; }
+    };
+
+    /**
+     * Range of passengers that can be used in a range-based for loop
+     */
+    class Range {
+        const PassengerStore *store;
+        uint32_t first;
+        bool chain;
+        size_t length;
+
+    public:
+        Range(const PassengerStore *store, uint32_t first, bool chain, size_t length) :
+                store(store), first(first), chain(chain), length(length) {}
+
+        Iterator begin() const { return Iterator(store, first, chain); }
+
+        Iterator end() const { return Iterator(store, NIL, false); }
+
+        size_t size() const { return length; }
+
+        bool empty() const { return length == 0; }
+
+        /**
+         * @brief Copies the passengers of the range to a vector
+         * @return vector<Passenger *>
+         */
+        vector<Passenger *> toVector() const {
+            vector<Passenger *> v;
+            v.reserve(length);
+            for (auto p : *this) v.push_back(p);
+            return v;
+        }
+    };
+
+    /**
+     * @brief Adds a passenger with the status passed as argument
+     * @param passenger Passenger *passenger
+     * @param status passenger_status_t status
+     * @return true if it was added and false if there is already a passenger with the same id
+     */
+    bool insert(Passenger *passenger, passenger_status_t status = PASSENGER_ACTIVE);
+
+    /**
+     * @brief Removes a passenger from the store
+     * @param passenger Passenger *passenger
+     * @return true if it was removed and false if it was not in the store
+     */
+    bool erase(Passenger *passenger);
+
+    /**
+     * @brief Changes the status of a passenger in O(1)
+     * @param passenger Passenger *passenger
+     * @param status passenger_status_t status
+     * @return true if the status changed and false otherwise
+     */
+    bool setStatus(Passenger *passenger, passenger_status_t status);
+
+    /**
+     * @brief Gets the status of a passenger of the store
+     * @param passenger const Passenger *passenger
+     * @return passenger_status_t
+     */
+    passenger_status_t getStatus(const Passenger *passenger) const;
+
+    /**
+     * @brief Gets the passenger with the id passed as argument
+     * @param id unsigned int id
+     * @return Passenger *, nullptr if there is no passenger with that id
+     */
+    Passenger *find(unsigned int id) const;
+
+    /**
+     * @brief Checks if the passenger passed as argument is in the store
+     * @param passenger const Passenger *passenger
+     * @return true if it is and false otherwise
+     */
+    bool contains(const Passenger *passenger) const;
+
+    /**
+     * @brief Gets the active passengers followed by the inactive ones
+     * @return Range
+     */
+    Range all() const;
+
+    /**
+     * @brief Gets the passengers with the status passed as argument
+     * @param status passenger_status_t status
+     * @return Range
+     */
+    Range withStatus(passenger_status_t status) const;
+
+    /**
+     * @brief Gets the number of passengers of the store
+     * @return size_t
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks if the store has no passengers
+     * @return true if it is empty and false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Reorders the list of a status with the comparator passed as argument
+     * @param status passenger_status_t status
+     * @param comp comparator
+     */
+    void sort(passenger_status_t status, bool (*comp)(Passenger *, Passenger *));
+
+    /**
+     * @brief Moves the last passenger of a sorted list of a status back to its place, walking from the end of the
+     * list, so a passenger appended in order costs O(1)
+     * @param status passenger_status_t status
+     * @param comp comparator
+     */
+    void sortLast(passenger_status_t status, bool (*comp)(Passenger *, Passenger *));
+
+    /**
+     * @brief Removes every passenger from the store
+     */
+    void clear();
+};
+
+#endif //AEDA_FEUP_PROJECT_PASSENGERSTORE_H
@@ -0,0 +1,106 @@
+#include "PricingEngine.h"
+
+PricingEngine::PricingEngine() : rules(defaultRules()) {}
+
+PricingEngine::PricingEngine(vector<PricingRule> rules) : rules(rules) {}
+
+vector<PricingRule> PricingEngine::defaultRules() {
+    vector<PricingRule> r;
+    r.push_back({KIND_COMMERCIAL, 48 * 60, true, 10});
+    return r;
+}
+
+const vector<PricingRule> &PricingEngine::getRules() const {
+    return rules;
+}
+
+void PricingEngine::addRule(PricingRule rule) {
+    rules.push_back(rule);
+}
+
+int PricingEngine::cardDiscount(Passenger *p) {
+    if (p == nullptr || p->getKind() != PASSENGER_CARD || p->getCard() == nullptr) return 0;
+    return p->getCard()->getAvgYrFlights();
+}
+
+void PricingEngine::load(const vector<Flight *> &flights, int now) {
+    size_t n = flights.size();
+    baseCents.resize(n);
+    occupancy.resize(n);
+    capacity.resize(n);
+    minutesToFlight.resize(n);
+    kind.resize(n);
+
+    // the hot fields come from the FlightTable, so no virtual call is made per flight
+    for (size_t i = 0; i < n; i++) {
+        uint32_t slot = flights[i]->getHandleSlot();
+        bool commercial = flights[i]->getKind() == FLIGHT_COMMERCIAL;
+        baseCents[i] = (int64_t) FlightTable::getBasePrice(slot) * 100;
+        capacity[i] = FlightTable::getCapacity(slot);
+        occupancy[i] = FlightTable::getOccupancy(slot);
+        if (!commercial && occupancy[i]) occupancy[i] = capacity[i];
+        minutesToFlight[i] = FlightTable::getDeparture(slot) - now;
+        kind[i] = commercial ? KIND_COMMERCIAL : KIND_RENTED;
+    }
+}
+
+/**
+ * @brief units of a scaled price in a cent
+ */
+static const int64_t SCALE = 100;
+
+/**
+ * @brief Applies a percentage to a scaled price, rounding to the nearest hundredth of a cent
+ * @param scaled int64_t scaled
+ * @param percent int64_t percent (of the price that is kept)
+ * @return int64_t
+ */
+static inline int64_t applyPercent(int64_t scaled, int64_t percent) {
+    return (scaled * percent + 50) / 100;
+}
+
+void PricingEngine::scale(vector<int64_t> &out) {
+    size_t n = baseCents.size();
+
+    out.resize(n);
+    for (size_t i = 0; i < n; i++) out[i] = baseCents[i] * SCALE;
+
+    // one pass per rule, every flight of the batch goes through the same arithmetic (a rule that does not fire
+    // keeps 100% of the price, which the rounding leaves unchanged)
+    for (auto const &r : rules) {
+        int32_t free = r.requiresFreeSeat ? 0 : 1;
+        for (size_t i = 0; i < n; i++) {
+            int64_t fires = ((kind[i] & r.kinds) != 0) & (minutesToFlight[i] < r.maxMinutesToFlight) &
+                            (free | (occupancy[i] < capacity[i]));
+            out[i] = applyPercent(out[i], 100 - fires * r.percentOff);
+        }
+    }
+}
+
+int64_t PricingEngine::finish(int64_t scaled, int cardDiscount) const {
+    // the card discount and the conversion to cents are rounded once, like a table of a single rule
+    return (scaled * (100 - cardDiscount) + SCALE * 50) / (SCALE * 100);
+}
+
+void PricingEngine::price(int cardDiscount, vector<int64_t> &out) {
+    scale(out);
+    for (size_t i = 0; i < out.size(); i++) out[i] = finish(out[i], cardDiscount);
+}
+
+int64_t PricingEngine::priceOne(Passenger *p, Flight *f, int now) const {
+    uint32_t slot = f->getHandleSlot();
+    bool commercial = f->getKind() == FLIGHT_COMMERCIAL;
+    int32_t seats = FlightTable::getCapacity(slot);
+    int32_t sold = FlightTable::getOccupancy(slot);
+    if (!commercial && sold) sold = seats;
+    int32_t minutes = FlightTable::getDeparture(slot) - now;
+    uint8_t k = commercial ? KIND_COMMERCIAL : KIND_RENTED;
+
+    int64_t scaled = (int64_t) FlightTable::getBasePrice(slot) * 100 * SCALE;
+    for (auto const &r : rules) {
+        int64_t fires = ((k & r.kinds) != 0) & (minutes < r.maxMinutesToFlight) &
+                        ((r.requiresFreeSeat ? 0 : 1) | (sold < seats));
+        scaled = applyPercent(scaled, 100 - fires * r.percentOff);
+    }
+    return finish(scaled, cardDiscount(p));
+}
@@ -0,0 +1,136 @@
+#ifndef AEDA_FEUP_PROJECT_PRICINGENGINE_H
+#define AEDA_FEUP_PROJECT_PRICINGENGINE_H
+
+#include <vector>
+#include <cstdint>
+#include "Flight.h"
+
+using namespace std;
+
+/*! bit flags used by a PricingRule to select the kind of flights it applies to */
+enum flight_kind_t {
+    KIND_COMMERCIAL = 1, /*!< Commercial flights */
+    KIND_RENTED = 2      /*!< Rented flights */
+};
+
+//! struct PricingRule
+/*! A row of the pricing table: a percentage discount that fires when every condition of the row holds */
+struct PricingRule {
+    uint8_t kinds;              /*!< bitmask of flight_kind_t the rule applies to */
+    int32_t maxMinutesToFlight; /*!< the rule only fires if the flight departs in less than this many minutes */
+    bool requiresFreeSeat;      /*!< the rule only fires if the flight still has free seats */
+    int32_t percentOff;         /*!< discount applied when the rule fires */
+};
+
+/**
+ * The PricingEngine prices a whole set of flights in a single pass using integer cents.
+ * The flights are flattened into parallel arrays and every rule of the pricing table is applied as one
+ * branch-free pass over those arrays, so adding a rule adds a pass instead of a branch per flight.
+ * Prices are kept in hundredths of a cent and each rule rounds its result to that unit, so the prices stay in
+ * range whatever the number of rules of the table.
+ */
+class PricingEngine {
+
+private:
+    /**
+     * @brief pricing table applied to every batch
+     */
+    vector<PricingRule> rules;
+    /**
+     * @brief base price of each flight in cents
+     */
+    vector<int64_t> baseCents;
+    /**
+     * @brief number of occupied seats of each flight
+     */
+    vector<int32_t> occupancy;
+    /**
+     * @brief number of seats of each flight
+     */
+    vector<int32_t> capacity;
+    /**
+     * @brief minutes until the departure of each flight
+     */
+    vector<int32_t> minutesToFlight;
+    /**
+     * @brief flight_kind_t of each flight
+     */
+    vector<uint8_t> kind;
+
+public:
+    /**
+     * @brief Constructor of a PricingEngine with the company default pricing table
+     */
+    PricingEngine();
+
+    /**
+     * @brief Constructor of a PricingEngine with a custom pricing table
+     * @param rules vector<PricingRule> rules
+     */
+    explicit PricingEngine(vector<PricingRule> rules);
+
+    /**
+     * @brief Gets the default pricing table (10% off commercial flights with free seats departing within 48 hours)
+     * @return vector<PricingRule>
+     */
+    static vector<PricingRule> defaultRules();
+
+    /**
+     * @brief Gets the pricing table of the engine
+     * @return const vector<PricingRule>&
+     */
+    const vector<PricingRule> &getRules() const;
+
+    /**
+     * @brief Adds a rule to the pricing table
+     * @param rule PricingRule rule
+     */
+    void addRule(PricingRule rule);
+
+    /**
+     * @brief Flattens the flights passed as argument into the engine arrays
+     * @param flights const vector<Flight *> &flights
+     * @param now int current time in minutes (Date::convertToMinutes)
+     */
+    void load(const vector<Flight *> &flights, int now);
+
+    /**
+     * @brief Applies the pricing table to every loaded flight without the card discount
+     * @param out vector<int64_t> &out scaled price (hundredths of a cent) of each loaded flight, in load order
+     */
+    void scale(vector<int64_t> &out);
+
+    /**
+     * @brief Turns a scaled price into cents applying the card discount passed as argument
+     * @param scaled int64_t scaled price returned by scale()
+     * @param cardDiscount int average number of flights per year of the passenger card (0 if there is no card)
+     * @return int64_t price in cents
+     */
+    int64_t finish(int64_t scaled, int cardDiscount) const;
+
+    /**
+     * @brief Prices every loaded flight for a passenger with the card discount passed as argument
+     * @param cardDiscount int average number of flights per year of the passenger card (0 if there is no card)
+     * @param out vector<int64_t> &out price of each loaded flight in cents, in load order
+     */
+    void price(int cardDiscount, vector<int64_t> &out);
+
+    /**
+     * @brief Prices a single flight for the passenger passed as argument, with the same arithmetic as price() but
+     * without the batch buffers, so it can be called by many threads at once
+     * @param p Passenger *p
+     * @param f Flight *f
+     * @param now int current time in minutes (Date::convertToMinutes)
+     * @return int64_t price in cents
+     */
+    int64_t priceOne(Passenger *p, Flight *f, int now) const;
+
+    /**
+     * @brief Gets the card discount of a Passenger (0 if the passenger has no card)
+     * @param p Passenger *p
+     * @return int
+     */
+    static int cardDiscount(Passenger *p);
+};
+
+#endif //AEDA_FEUP_PROJECT_PRICINGENGINE_H
@@ -0,0 +1,208 @@
+#ifndef AEDA_FEUP_PROJECT_PROTOCOL_H
+#define AEDA_FEUP_PROJECT_PROTOCOL_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Binary protocol of the booking server (see BookingServer).
+ *
+ * Every message is a frame: a 32-bit length of the rest of the frame followed by a 32-bit tag chosen by the client
+ * and echoed in the response, and a one byte code (protocol_op_t in requests, service_status_t or STATUS_BAD_REQUEST
+ * in responses). Integers are little endian and strings are a 16-bit length followed by the bytes.
+ *
+ * Requests and responses:
+ *  - OP_SEARCH  departure, destination (empty matches any city) ->
+ *               count, then per flight: id, type, departure minute (i64), capacity, occupancy, base price
+ *  - OP_QUOTE   passenger id, flight id -> price in cents (i64)
+ *  - OP_BOOK    passenger id, flight id, seat -> booking id
+ *  - OP_RETURN  booking id -> (nothing)
+ *  - OP_ADVANCE minutes -> current minute (i64)
+ *  - OP_HOLD    passenger id, flight id, seat, minutes -> minute of the expiry of the hold (i64)
+ *  - OP_RELEASE passenger id, flight id, seat -> (nothing)
+ *  - OP_GROUP   count, then per seat: passenger id, flight id, seat (ANY to let the group choose) ->
+ *               count, then the booking ids in the order of the request (all or nothing)
+ *  - OP_WAIT    passenger id, flight id -> waiters of the flight
+ * A client may send many requests without waiting (pipelining); the responses come back in the same order.
+ */
+
+/*! request codes of the protocol */
+enum protocol_op_t {
+    OP_SEARCH = 1,  /*!< future flights of a route with free seats */
+    OP_QUOTE = 2,   /*!< price of a ticket for a passenger */
+    OP_BOOK = 3,    /*!< Company::book */
+    OP_RETURN = 4,  /*!< Company::returnBooking */
+    OP_ADVANCE = 5, /*!< Company::advanceClock */
+    OP_HOLD = 6,    /*!< Company::holdSeat */
+    OP_RELEASE = 7, /*!< Company::releaseHold */
+    OP_GROUP = 8,   /*!< Company::bookGroup */
+    OP_WAIT = 9     /*!< Company::joinWaitlist */
+};
+
+/**
+ * @brief response code of a malformed request or of an unknown protocol_op_t
+ */
+const uint8_t STATUS_BAD_REQUEST = 255;
+
+/**
+ * @brief size of the frame header (length and tag)
+ */
+const size_t FRAME_HEADER = 8;
+
+/**
+ * @brief largest frame accepted, the connection is closed when a peer announces a longer one
+ */
+const uint32_t MAX_FRAME = 1 << 16;
+
+/**
+ * Appends frames to a buffer. begin() reserves the header, the put functions append the fields and end() writes
+ * the length, so several frames can be written back to back in the same buffer.
+ */
+class FrameWriter {
+
+private:
+    /**
+     * @brief buffer that receives the frames
+     */
+    string &buffer;
+    /**
+     * @brief position of the frame being written
+     */
+    size_t start = 0;
+
+public:
+    explicit FrameWriter(string &buffer) : buffer(buffer) {}
+
+    /**
+     * @brief Starts a frame
+     * @param tag uint32_t tag
+     * @param code uint8_t code (protocol_op_t or status)
+     */
+    void begin(uint32_t tag, uint8_t code) {
+        start = buffer.size();
+        putU32(0);
+        putU32(tag);
+        putU8(code);
+    }
+
+    /**
+     * @brief Finishes the frame started by begin(), writing its length
+     */
+    void end() {
+        uint32_t length = (uint32_t) (buffer.size() - start - 4);
+        for (int i = 0; i < 4; i++) buffer[start + i] = (char) (length >> (8 * i));
+    }
+
+    /**
+     * @brief Discards the frame started by begin()
+     */
+    void cancel() { buffer.resize(start); }
+
+    void putU8(uint8_t v) { buffer.push_back((char) v); }
+
+    void putU32(uint32_t v) {
+        for (int i = 0; i < 4; i++) buffer.push_back((char) (v >> (8 * i)));
+    }
+
+    void putI64(int64_t v) {
+        for (int i = 0; i < 8; i++) buffer.push_back((char) ((uint64_t) v >> (8 * i)));
+    }
+
+    void putString(const string &s) {
+        size_t n = s.size() < 0xFFFF ? s.size() : 0xFFFF;
+        buffer.push_back((char) n);
+        buffer.push_back((char) (n >> 8));
+        buffer.append(s, 0, n);
+    }
+};
+
+/**
+ * Reads the fields of a frame. Reading past the end of the frame makes ok() false instead of failing, so a request
+ * can be decoded first and checked once.
+ */
+class FrameReader {
+
+private:
+    /**
+     * @brief next byte to read
+     */
+    const unsigned char *p;
+    /**
+     * @brief bytes left in the frame
+     */
+    size_t left;
+    /**
+     * @brief false if a read went past the end of the frame
+     */
+    bool valid = true;
+
+    bool take(size_t n) {
+        if (left < n) {
+            valid = false;
+            left = 0;
+            return false;
+        }
+        left -= n;
+        return true;
+    }
+
+public:
+    FrameReader(const char *data, size_t size) : p((const unsigned char *) data), left(size) {}
+
+    /**
+     * @brief Gets the length announced by a frame header
+     * @param data const char *data (at least 4 bytes)
+     * @return uint32_t length of the frame after the length field
+     */
+    static uint32_t frameLength(const char *data) {
+        const unsigned char *b = (const unsigned char *) data;
+        return (uint32_t) b[0] | (uint32_t) b[1] << 8 | (uint32_t) b[2] << 16 | (uint32_t) b[3] << 24;
+    }
+
+    /**
+     * @brief Checks if every read was inside the frame
+     * @return true if the reads were valid and false otherwise
+     */
+    bool ok() const { return valid; }
+
+    /**
+     * @brief Checks if the whole frame was read
+     * @return true if there is nothing left and false otherwise
+     */
+    bool atEnd() const { return left == 0; }
+
+    uint8_t getU8() {
+        if (!take(1)) return 0;
+        return *p++;
+    }
+
+    uint32_t getU32() {
+        if (!take(4)) return 0;
+        uint32_t v = frameLength((const char *) p);
+        p += 4;
+        return v;
+    }
+
+    int64_t getI64() {
+        if (!take(8)) return 0;
+        uint64_t v = 0;
+        for (int i = 7; i >= 0; i--) v = v << 8 | p[i];
+        p += 8;
+        return (int64_t) v;
+    }
+
+    string getString() {
+        if (!take(2)) return "";
+        size_t n = p[0] | (size_t) p[1] << 8;
+        p += 2;
+        if (!take(n)) return "";
+        string s((const char *) p, n);
+        p += n;
+        return s;
+    }
+};
+
+#endif //AEDA_FEUP_PROJECT_PROTOCOL_H
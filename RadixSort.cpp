@@ -0,0 +1,110 @@
+#include "RadixSort.h"
+#include <thread>
+
+static const int RADIX_PASSES = 8;
+static const int RADIX_BUCKETS = 256;
+
+static inline unsigned int digit(const SortKey &k, int pass) {
+    return (unsigned int) (k.key >> (8 * pass)) & 0xFF;
+}
+
+void radixSort(vector<SortKey> &keys) {
+    if (keys.size() >= RADIX_PARALLEL_THRESHOLD) {
+        unsigned int threads = thread::hardware_concurrency();
+        if (threads > 1) {
+            radixSortParallel(keys, threads);
+            return;
+        }
+    }
+
+    size_t n = keys.size();
+    if (n < 2) return;
+
+    // histograms of every digit in a single pass
+    vector<size_t> count(RADIX_PASSES * RADIX_BUCKETS, 0);
+    for (auto const &k : keys)
+        for (int p = 0; p < RADIX_PASSES; p++) count[p * RADIX_BUCKETS + digit(k, p)]++;
+
+    vector<SortKey> buffer(n);
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        size_t *c = &count[p * RADIX_BUCKETS];
+        if (c[digit(keys[0], p)] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            size_t t = c[b];
+            c[b] = offset;
+            offset += t;
+        }
+        for (auto const &k : keys) buffer[c[digit(k, p)]++] = k;
+        keys.swap(buffer);
+    }
+}
+
+void radixSortParallel(vector<SortKey> &keys, unsigned int threads) {
+    size_t n = keys.size();
+    if (n < 2) return;
+    if (threads < 1) threads = 1;
+
+    size_t chunk = (n + threads - 1) / threads;
+    vector<SortKey> buffer(n);
+    vector<vector<size_t> > count(threads, vector<size_t>(RADIX_BUCKETS));
+
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        vector<thread> workers;
+
+        for (unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                vector<size_t> &c = count[t];
+                fill(c.begin(), c.end(), 0);
+                size_t end = min(n, (t + 1) * chunk);
+                for (size_t i = t * chunk; i < end; i++) c[digit(keys[i], p)]++;
+            });
+        }
+        for (auto &w : workers) w.join();
+        workers.clear();
+
+        // every thread writes its part of each bucket after the parts of the previous threads
+        size_t offset = 0;
+        bool constant = false;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            size_t total = 0;
+            for (unsigned int t = 0; t < threads; t++) {
+                size_t c = count[t][b];
+                count[t][b] = offset;
+                offset += c;
+                total += c;
+            }
+            if (total == n) constant = true;
+        }
+        if (constant) continue;
+
+        for (unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                vector<size_t> &c = count[t];
+                size_t end = min(n, (t + 1) * chunk);
+                for (size_t i = t * chunk; i < end; i++) buffer[c[digit(keys[i], p)]++] = keys[i];
+            });
+        }
+        for (auto &w : workers) w.join();
+        keys.swap(buffer);
+    }
+}
+
+uint64_t dateKey(const Date &d) {
+    uint64_t key = (uint64_t) (uint32_t) (d.year + 0x8000) << 32;
+    key |= (uint64_t) (d.month & 0xFF) << 24;
+    key |= (uint64_t) (d.day & 0xFF) << 16;
+    key |= (uint64_t) (d.hour & 0xFF) << 8;
+    key |= (uint64_t) (d.minute & 0xFF);
+    return key;
+}
+
+uint64_t prefixKey(const string &s) {
+    uint64_t key = 0;
+    for (size_t i = 0; i < 8; i++) {
+        key <<= 8;
+        if (i < s.size()) key |= (unsigned char) s[i];
+    }
+    return key;
+}
@@ -0,0 +1,78 @@
+#ifndef AEDA_FEUP_PROJECT_RADIXSORT_H
+#define AEDA_FEUP_PROJECT_RADIXSORT_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include "helper.h"
+
+using namespace std;
+
+//! struct SortKey
+/*! Fixed width sort key extracted once from an object, with the position of the object it was taken from */
+struct SortKey {
+    uint64_t key;   /*!< sort key */
+    uint32_t index; /*!< position of the object in the container being sorted */
+};
+
+/**
+ * @brief Minimum number of keys for which radixSort() splits the work among several threads
+ */
+const size_t RADIX_PARALLEL_THRESHOLD = 1 << 16;
+
+/**
+ * @brief Sorts the keys passed as argument with a stable LSD radix sort (8 passes of 8 bits, constant digits are skipped)
+ * @param keys vector<SortKey> &keys
+ */
+void radixSort(vector<SortKey> &keys);
+
+/**
+ * @brief Sorts the keys passed as argument with a stable LSD radix sort using the number of threads passed as argument
+ * @param keys vector<SortKey> &keys
+ * @param threads unsigned int threads
+ */
+void radixSortParallel(vector<SortKey> &keys, unsigned int threads);
+
+/**
+ * @brief Builds a sort key that preserves the chronological order of Date objects
+ * @param d const Date &d
+ * @return uint64_t
+ */
+uint64_t dateKey(const Date &d);
+
+/**
+ * @brief Builds a sort key from the first 8 characters of a string, preserving the order of std::string
+ * @param s const string &s
+ * @return uint64_t
+ */
+uint64_t prefixKey(const string &s);
+
+/**
+ * @brief Sorts a vector of pointers by a precomputed key with radixSort(), equal keys are ordered by comp
+ * @param items vector<T *> &items
+ * @param key key extractor, key(a) < key(b) must imply comp(a, b)
+ * @param comp comparator used to order the objects that share a key (may be nullptr)
+ */
+template<class T>
+void radixSortBy(vector<T *> &items, uint64_t (*key)(T *), bool (*comp)(T *, T *)) {
+    size_t n = items.size();
+    vector<SortKey> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = {key(items[i]), (uint32_t) i};
+
+    radixSort(keys);
+
+    vector<T *> sorted(n);
+    for (size_t i = 0; i < n; i++) sorted[i] = items[keys[i].index];
+
+    if (comp != nullptr) {
+        for (size_t i = 0, j; i < n; i = j) {
+            for (j = i + 1; j < n && keys[j].key == keys[i].key; j++);
+            if (j - i > 1) stable_sort(sorted.begin() + i, sorted.begin() + j, comp);
+        }
+    }
+
+    items.swap(sorted);
+}
+
+#endif //AEDA_FEUP_PROJECT_RADIXSORT_H
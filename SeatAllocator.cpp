@@ -0,0 +1,145 @@
+#include "SeatAllocator.h"
+#include <algorithm>
+#include <array>
+
+const size_t SeatAllocator::EXTRA_ROWS;
+
+//! struct Run
+/*! Block of adjacent free seats of a row */
+struct Run {
+    size_t row;          /*!< row of the block */
+    unsigned int column; /*!< first column of the block */
+    unsigned int length; /*!< seats of the block */
+};
+
+/**
+ * @brief Counts the seats of a row mask, without relying on a popcount instruction being available
+ * @param m uint32_t m
+ * @return unsigned int
+ */
+static unsigned int countSeats(uint32_t m) {
+    m = m - ((m >> 1) & 0x55555555u);
+    m = (m & 0x33333333u) + ((m >> 2) & 0x33333333u);
+    return (((m + (m >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+/**
+ * @brief Appends the blocks of adjacent free seats of a row, from the front of the row
+ * @param row size_t row
+ * @param free uint32_t free (free seats of the row)
+ * @param runs vector<Run> &runs
+ */
+static void appendRuns(size_t row, uint32_t free, vector<Run> &runs) {
+    while (free) {
+        unsigned int column = (unsigned int) __builtin_ctz(free);
+        unsigned int length = (unsigned int) __builtin_ctz(~(free >> column));
+        runs.push_back(Run{row, column, length});
+        free &= ~(((uint32_t(1) << length) - 1) << column);
+    }
+}
+
+bool SeatAllocator::allocate(const SeatMap &seats, unsigned int k, vector<size_t> &chosen) {
+    const unsigned int ROW = SeatMap::ROW_SEATS;
+    const uint32_t all = (uint32_t(1) << ROW) - 1;
+    chosen.clear();
+    if (k == 0) return true;
+
+    size_t rows = seats.size() / ROW;
+    vector<uint32_t> free(rows);
+    vector<uint8_t> freeSeats(rows);
+    size_t total = 0;
+    for (size_t r = 0; r < rows; r++) {
+        free[r] = ~seats.rowMask(r) & all;
+        freeSeats[r] = (uint8_t) countSeats(free[r]);
+        total += freeSeats[r];
+    }
+    if (total < k) return false;
+
+    if (k <= ROW) {
+        // a block fits exactly when the seats on both of its sides are taken (or past the ends of the row)
+        size_t firstRow = rows;
+        unsigned int firstColumn = 0;
+        for (size_t r = 0; r < rows; r++) {
+            uint32_t starts = blockStarts(free[r], k);
+            if (!starts) continue;
+            uint32_t exact = starts & ~(free[r] << 1) & ~(free[r] >> k);
+            if (exact) {
+                firstRow = r;
+                firstColumn = (unsigned int) __builtin_ctz(exact);
+                break;
+            }
+            if (firstRow == rows) {
+                firstRow = r;
+                firstColumn = (unsigned int) __builtin_ctz(starts);
+            }
+        }
+        if (firstRow < rows) {
+            for (unsigned int i = 0; i < k; i++) chosen.push_back(firstRow * ROW + firstColumn + i);
+            return true;
+        }
+    }
+
+    // the fewest consecutive rows that hold the party, with two pointers over the free seats per row
+    size_t span = rows, sum = 0, end = 0;
+    for (size_t r = 0; r < rows; r++) {
+        while (end < rows && sum < k) sum += freeSeats[end++];
+        if (sum < k) break;
+        span = min(span, end - r);
+        sum -= freeSeats[r];
+    }
+
+    // blocks of each length in the rows before each row, so any cluster counts its blocks by length at once
+    vector<array<uint16_t, SeatMap::ROW_SEATS + 1> > before(rows + 1);
+    before[0].fill(0);
+    for (size_t r = 0; r < rows; r++) {
+        before[r + 1] = before[r];
+        for (uint32_t m = free[r]; m;) {
+            unsigned int column = (unsigned int) __builtin_ctz(m);
+            unsigned int length = (unsigned int) __builtin_ctz(~(m >> column));
+            before[r + 1][length]++;
+            m &= ~(((uint32_t(1) << length) - 1) << column);
+        }
+    }
+
+    // the cluster that splits the party in the fewest blocks (taking its longest blocks first), then the tightest
+    // and then the one nearest to the front
+    size_t bestParts = SIZE_MAX, bestFirst = 0, bestWidth = 0;
+    size_t fewest = (k + ROW - 1) / ROW;
+    for (size_t width = span; width <= span + EXTRA_ROWS && width <= rows && bestParts > fewest; width++) {
+        for (size_t first = 0; first + width <= rows && bestParts > fewest; first++) {
+            // a cluster with a full row at one end has the blocks of a narrower one, which was already tried
+            if (!free[first] || !free[first + width - 1]) continue;
+
+            // a party takes at most k blocks, so this loop is short and needs no division
+            size_t need = k, parts = 0;
+            for (unsigned int l = ROW; l >= 1 && need > 0 && parts < bestParts; l--) {
+                size_t count = (size_t) (before[first + width][l] - before[first][l]);
+                for (; count > 0 && need > 0; count--, parts++) need -= min(need, (size_t) l);
+            }
+            if (need > 0 || parts >= bestParts) continue;
+            bestParts = parts;
+            bestFirst = first;
+            bestWidth = width;
+        }
+    }
+
+    vector<Run> runs;
+    for (size_t r = bestFirst; r < bestFirst + bestWidth; r++) appendRuns(r, free[r], runs);
+    stable_sort(runs.begin(), runs.end(), [](const Run &a, const Run &b) { return a.length > b.length; });
+
+    size_t need = k;
+    for (size_t i = 0; i < runs.size() && need > 0; i++) {
+        for (unsigned int c = 0; c < runs[i].length && need > 0; c++, need--)
+            chosen.push_back(runs[i].row * ROW + runs[i].column + c);
+    }
+    sort(chosen.begin(), chosen.end());
+    return true;
+}
+
+size_t SeatAllocator::parts(const vector<size_t> &seats) {
+    size_t n = 0;
+    for (size_t i = 0; i < seats.size(); i++) {
+        if (i == 0 || seats[i] != seats[i - 1] + 1 || seats[i] % SeatMap::ROW_SEATS == 0) n++;
+    }
+    return n;
+}
@@ -0,0 +1,55 @@
+#ifndef AEDA_FEUP_PROJECT_SEATALLOCATOR_H
+#define AEDA_FEUP_PROJECT_SEATALLOCATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SeatMap.h"
+
+using namespace std;
+
+/**
+ * Chooses the seats of a party on a SeatMap, reading it one row mask at a time.
+ * The free seats of a row are a mask of ROW_SEATS bits, and the columns where k adjacent free seats start are the
+ * bits left in the mask after ANDing it with itself shifted right by 1 .. k-1. A party that fits in a row gets such a
+ * block, preferring one that fills a gap exactly so the longer gaps stay whole for the next parties. A party that
+ * does not fit in any row is split in as few blocks as possible, taken from the tightest cluster of rows.
+ */
+class SeatAllocator {
+
+public:
+    /**
+     * @brief rows that a split party may spread over beyond the fewest rows that hold it, if that splits it less
+     */
+    static const size_t EXTRA_ROWS = 2;
+
+    /**
+     * @brief Gets the columns where k adjacent seats of a row mask start
+     * @param free uint32_t free (free seats of a row)
+     * @param k unsigned int k (at least 1)
+     * @return uint32_t mask of the first columns of the blocks
+     */
+    static uint32_t blockStarts(uint32_t free, unsigned int k) {
+        uint32_t starts = free;
+        for (unsigned int i = 1; i < k && starts; i++) starts &= free >> i;
+        return starts;
+    }
+
+    /**
+     * @brief Chooses free seats for a party, without claiming them
+     * @param seats const SeatMap &seats
+     * @param k unsigned int k (size of the party)
+     * @param chosen vector<size_t> &chosen (gets the seat indexes in increasing order)
+     * @return true if the map has k free seats and false otherwise
+     */
+    static bool allocate(const SeatMap &seats, unsigned int k, vector<size_t> &chosen);
+
+    /**
+     * @brief Counts the blocks of adjacent seats of the same row in a set of seats
+     * @param seats const vector<size_t> &seats (in increasing order)
+     * @return size_t
+     */
+    static size_t parts(const vector<size_t> &seats);
+};
+
+#endif //AEDA_FEUP_PROJECT_SEATALLOCATOR_H
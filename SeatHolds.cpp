@@ -0,0 +1,69 @@
+#include "SeatHolds.h"
+#include <algorithm>
+
+const SeatHolds::Hold *SeatHolds::find(unsigned int flightId, uint32_t seat) const {
+    auto it = holds.find(key(flightId, seat));
+    return it == holds.end() ? nullptr : &it->second;
+}
+
+void SeatHolds::forget(unsigned int flightId, uint32_t seat) {
+    auto it = seatsOf.find(flightId);
+    if (it == seatsOf.end()) return;
+    vector<uint32_t> &seats = it->second;
+    auto s = std::find(seats.begin(), seats.end(), seat);
+    if (s != seats.end()) {
+        *s = seats.back();
+        seats.pop_back();
+    }
+    if (seats.empty()) seatsOf.erase(it);
+}
+
+void SeatHolds::hold(Flight *flight, uint32_t seat, unsigned int passengerId, uint64_t now, uint64_t expiry) {
+    if (timers.size() == 0) {
+        // an empty wheel expires nothing, it only catches up with the clock
+        vector<uint64_t> none;
+        timers.advance(now, none);
+    }
+    uint64_t k = key(flight->getId(), seat);
+    auto it = holds.find(k);
+    if (it != holds.end()) timers.cancel(it->second.timer);
+    else seatsOf[flight->getId()].push_back(seat);
+    holds[k] = {flight, seat, passengerId, expiry, timers.schedule(expiry, k)};
+}
+
+bool SeatHolds::erase(unsigned int flightId, uint32_t seat) {
+    auto it = holds.find(key(flightId, seat));
+    if (it == holds.end()) return false;
+    timers.cancel(it->second.timer);
+    holds.erase(it);
+    forget(flightId, seat);
+    return true;
+}
+
+void SeatHolds::eraseFlight(unsigned int flightId) {
+    auto it = seatsOf.find(flightId);
+    if (it == seatsOf.end()) return;
+    for (auto seat : it->second) {
+        auto h = holds.find(key(flightId, seat));
+        timers.cancel(h->second.timer);
+        holds.erase(h);
+    }
+    seatsOf.erase(it);
+}
+
+void SeatHolds::expire(uint64_t now, vector<Hold> &expired) {
+    vector<uint64_t> keys;
+    timers.advance(now, keys);
+    for (auto k : keys) {
+        auto it = holds.find(k);
+        expired.push_back(it->second);
+        forget(it->second.flight->getId(), it->second.seat);
+        holds.erase(it);
+    }
+}
+
+void SeatHolds::clear() {
+    holds.clear();
+    timers.clear();
+    seatsOf.clear();
+}
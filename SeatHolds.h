@@ -0,0 +1,105 @@
+#ifndef AEDA_FEUP_PROJECT_SEATHOLDS_H
+#define AEDA_FEUP_PROJECT_SEATHOLDS_H
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include "Flight.h"
+#include "TimingWheel.h"
+
+using namespace std;
+
+/**
+ * Temporary holds of seats of commercial flights, by flight and seat index (SeatMap::index).
+ * The seat of a hold is claimed on its flight, so nobody else can book it, and a TimingWheel ticking on the minutes
+ * of the Company clock expires the holds that were neither booked nor released.
+ */
+class SeatHolds {
+
+public:
+    //! struct Hold
+    /*! A seat held by a passenger */
+    struct Hold {
+        Flight *flight;           /*!< flight of the seat */
+        uint32_t seat;            /*!< SeatMap::index of the seat */
+        unsigned int passengerId; /*!< passenger that holds the seat */
+        uint64_t expiry;          /*!< minute of the expiry */
+        uint32_t timer;           /*!< timer of the expiry in the wheel */
+    };
+
+private:
+    /**
+     * @brief holds by key()
+     */
+    unordered_map<uint64_t, Hold> holds;
+    /**
+     * @brief expiry of the holds, the payload of a timer is the key of its hold
+     */
+    TimingWheel timers;
+    /**
+     * @brief held seats of each flight, so the holds of a flight are removed without a search
+     */
+    unordered_map<unsigned int, vector<uint32_t> > seatsOf;
+
+    static uint64_t key(unsigned int flightId, uint32_t seat) { return (uint64_t) flightId << 32 | seat; }
+
+    /**
+     * @brief Removes a seat from the held seats of its flight
+     * @param flightId unsigned int flightId
+     * @param seat uint32_t seat
+     */
+    void forget(unsigned int flightId, uint32_t seat);
+
+public:
+    /**
+     * @brief Finds the hold of a seat
+     * @param flightId unsigned int flightId
+     * @param seat uint32_t seat
+     * @return const Hold *, nullptr if the seat is not held
+     */
+    const Hold *find(unsigned int flightId, uint32_t seat) const;
+
+    /**
+     * @brief Adds the hold of a seat already claimed on its flight, or moves the expiry of an existing hold
+     * @param flight Flight *flight
+     * @param seat uint32_t seat
+     * @param passengerId unsigned int passengerId
+     * @param now uint64_t now (minute of the clock)
+     * @param expiry uint64_t expiry (minute)
+     */
+    void hold(Flight *flight, uint32_t seat, unsigned int passengerId, uint64_t now, uint64_t expiry);
+
+    /**
+     * @brief Removes the hold of a seat without releasing the seat
+     * @param flightId unsigned int flightId
+     * @param seat uint32_t seat
+     * @return true if the seat was held and false otherwise
+     */
+    bool erase(unsigned int flightId, uint32_t seat);
+
+    /**
+     * @brief Removes every hold of a flight without releasing the seats
+     * @param flightId unsigned int flightId
+     */
+    void eraseFlight(unsigned int flightId);
+
+    /**
+     * @brief Removes the holds that expire up to the minute passed as argument, the seats must then be released
+     * @param now uint64_t now (minute)
+     * @param expired vector<Hold> &expired
+     */
+    void expire(uint64_t now, vector<Hold> &expired);
+
+    /**
+     * @brief Removes every hold without releasing the seats
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of holds
+     * @return size_t
+     */
+    size_t size() const { return holds.size(); }
+};
+
+#endif //AEDA_FEUP_PROJECT_SEATHOLDS_H
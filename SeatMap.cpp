@@ -0,0 +1,87 @@
+#include "SeatMap.h"
+#include <cctype>
+
+const unsigned int SeatMap::ROW_SEATS;
+
+SeatMap::SeatMap(const SeatMap &s) {
+    *this = s;
+}
+
+SeatMap &SeatMap::operator=(const SeatMap &s) {
+    if (this == &s) return *this;
+    size_t n = wordCount(s.seats);
+    words.reset(n ? new atomic<uint64_t>[n] : nullptr);
+    for (size_t i = 0; i < n; i++) words[i].store(s.words[i].load(memory_order_relaxed), memory_order_relaxed);
+    seats = s.seats;
+    return *this;
+}
+
+void SeatMap::resize(size_t n) {
+    size_t oldWords = wordCount(seats), newWords = wordCount(n);
+    if (newWords != oldWords) {
+        unique_ptr<atomic<uint64_t>[]> bits(newWords ? new atomic<uint64_t>[newWords] : nullptr);
+        for (size_t i = 0; i < newWords; i++)
+            bits[i].store(i < oldWords ? words[i].load(memory_order_relaxed) : 0, memory_order_relaxed);
+        words = move(bits);
+    }
+    seats = n;
+    // the seats past the end must stay free, so a later growth does not bring them back
+    if (n % 64) words[newWords - 1].fetch_and((uint64_t(1) << (n % 64)) - 1, memory_order_relaxed);
+}
+
+void SeatMap::clear() {
+    for (size_t i = 0; i < wordCount(seats); i++) words[i].store(0, memory_order_relaxed);
+}
+
+bool SeatMap::claim(size_t seat) {
+    if (seat >= seats) return false;
+    uint64_t bit = uint64_t(1) << (seat % 64);
+    atomic<uint64_t> &word = words[seat / 64];
+    uint64_t old = word.load(memory_order_relaxed);
+    do {
+        if (old & bit) return false;
+    } while (!word.compare_exchange_weak(old, old | bit, memory_order_acq_rel, memory_order_relaxed));
+    return true;
+}
+
+void SeatMap::release(size_t seat) {
+    if (seat >= seats) return;
+    words[seat / 64].fetch_and(~(uint64_t(1) << (seat % 64)), memory_order_acq_rel);
+}
+
+bool SeatMap::taken(size_t seat) const {
+    if (seat >= seats) return false;
+    return (words[seat / 64].load(memory_order_acquire) >> (seat % 64)) & 1;
+}
+
+size_t SeatMap::count() const {
+    size_t n = 0;
+    for (size_t i = 0; i < wordCount(seats); i++) n += __builtin_popcountll(words[i].load(memory_order_relaxed));
+    return n;
+}
+
+uint32_t SeatMap::rowMask(size_t row) const {
+    size_t first = row * ROW_SEATS;
+    if (first >= seats) return 0;
+    // a row starts anywhere in a word and may go on in the next one
+    size_t offset = first % 64;
+    uint64_t bits = words[first / 64].load(memory_order_acquire) >> offset;
+    if (offset + ROW_SEATS > 64 && first / 64 + 1 < wordCount(seats))
+        bits |= words[first / 64 + 1].load(memory_order_acquire) << (64 - offset);
+    return (uint32_t) bits & ((uint32_t(1) << ROW_SEATS) - 1);
+}
+
+int SeatMap::index(const string &seat, unsigned int capacity) {
+    if (seat.size() < 2 || seat[0] == '0' || seat.back() < 'A' || seat.back() > 'F') return -1;
+    unsigned int row = 0;
+    for (size_t i = 0; i + 1 < seat.size(); i++) {
+        if (!isdigit(seat[i])) return -1;
+        row = row * 10 + (seat[i] - '0');
+        if (row > capacity / ROW_SEATS) return -1;
+    }
+    return (int) ((row - 1) * ROW_SEATS + (seat.back() - 'A'));
+}
+
+string SeatMap::name(size_t seat) {
+    return to_string(seat / ROW_SEATS + 1) + (char) ('A' + seat % ROW_SEATS);
+}
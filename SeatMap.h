@@ -0,0 +1,124 @@
+#ifndef AEDA_FEUP_PROJECT_SEATMAP_H
+#define AEDA_FEUP_PROJECT_SEATMAP_H
+
+#include <string>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Occupancy bitset of the seats of a CommercialFlight, one bit per seat ((row - 1) * 6 + column).
+ * Claiming and releasing a seat are single atomic read-modify-writes on the word of the seat, so many threads can
+ * book seats of the same flight at once: of two threads claiming the same seat exactly one wins, without locks.
+ * Resizing and copying are not atomic and must only happen while no thread is claiming.
+ */
+class SeatMap {
+
+private:
+    /**
+     * @brief bits of the seats, 64 per word
+     */
+    unique_ptr<atomic<uint64_t>[]> words;
+    /**
+     * @brief number of seats
+     */
+    size_t seats = 0;
+
+    /**
+     * @brief Gets the number of words of a number of seats
+     * @param n size_t n
+     * @return size_t
+     */
+    static size_t wordCount(size_t n) { return (n + 63) / 64; }
+
+public:
+    /**
+     * @brief seats of a row, the columns A to F
+     */
+    static const unsigned int ROW_SEATS = 6;
+
+    SeatMap() {}
+
+    /**
+     * @brief Copy constructor, copies the bits as they are at the time of the copy
+     * @param s const SeatMap &s
+     */
+    SeatMap(const SeatMap &s);
+
+    /**
+     * @brief Copies the bits of another SeatMap
+     * @param s const SeatMap &s
+     * @return SeatMap &
+     */
+    SeatMap &operator=(const SeatMap &s);
+
+    /**
+     * @brief Changes the number of seats, keeping the bits of the seats that remain
+     * @param n size_t n
+     */
+    void resize(size_t n);
+
+    /**
+     * @brief Frees every seat
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of seats
+     * @return size_t
+     */
+    size_t size() const { return seats; }
+
+    /**
+     * @brief Claims a free seat
+     * @param seat size_t seat
+     * @return true if this call took the seat and false if it was taken or out of the map
+     */
+    bool claim(size_t seat);
+
+    /**
+     * @brief Frees a seat
+     * @param seat size_t seat
+     */
+    void release(size_t seat);
+
+    /**
+     * @brief Checks if a seat is taken
+     * @param seat size_t seat
+     * @return true if the seat is taken and false otherwise
+     */
+    bool taken(size_t seat) const;
+
+    /**
+     * @brief Counts the taken seats
+     * @return size_t
+     */
+    size_t count() const;
+
+    /**
+     * @brief Gets the taken seats of a row as a mask, bit j for the column j
+     * @param row size_t row (0 for the first row)
+     * @return uint32_t (only the low ROW_SEATS bits are used)
+     */
+    uint32_t rowMask(size_t row) const;
+
+    /**
+     * @brief Gets the index of a seat name ("12C")
+     * @param seat const string &seat
+     * @param capacity unsigned int capacity (6 seats per row)
+     * @return int index of the seat, -1 if the name is not a seat of the capacity
+     */
+    static int index(const string &seat, unsigned int capacity);
+
+    /**
+     * @brief Gets the name of a seat index
+     * @param seat size_t seat
+     * @return string
+     */
+    static string name(size_t seat);
+};
+
+#endif //AEDA_FEUP_PROJECT_SEATMAP_H
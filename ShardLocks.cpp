@@ -0,0 +1,21 @@
+#include "ShardLocks.h"
+
+const unsigned int ShardLocks::SHARD_BITS;
+const size_t ShardLocks::SHARDS;
+const uint32_t ShardLocks::ALL;
+
+ShardLocks::Guard::Guard(ShardLocks &locks, uint32_t exclusive, uint32_t shared) : locks(locks),
+                                                                                    exclusive(exclusive),
+                                                                                    shared(shared & ~exclusive) {
+    for (size_t i = 0; i < SHARDS; i++) {
+        if (this->exclusive >> i & 1) locks.locks[i].lock();
+        else if (this->shared >> i & 1) locks.locks[i].lock_shared();
+    }
+}
+
+ShardLocks::Guard::~Guard() {
+    for (size_t i = SHARDS; i-- > 0;) {
+        if (exclusive >> i & 1) locks.locks[i].unlock();
+        else if (shared >> i & 1) locks.locks[i].unlock_shared();
+    }
+}
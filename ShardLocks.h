@@ -0,0 +1,104 @@
+#ifndef AEDA_FEUP_PROJECT_SHARDLOCKS_H
+#define AEDA_FEUP_PROJECT_SHARDLOCKS_H
+
+#include <shared_mutex>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Reader-writer locks of the shards of the Company. Passengers, flights and bookings belong to the shard of the hash
+ * of their id (a booking to the shard of its passenger), and an operation locks the shards of the objects it
+ * touches: shared to read them and exclusive to change them. Changes to the set of objects (creating or deleting a
+ * flight or a passenger, loading files, advancing the clock) lock every shard.
+ *
+ * A Guard always locks its shards in increasing order, so two operations that need the same shards can never wait
+ * for each other in a cycle, whatever order their objects come in.
+ */
+class ShardLocks {
+
+public:
+    /**
+     * @brief log2 of the number of shards
+     */
+    static const unsigned int SHARD_BITS = 4;
+    /**
+     * @brief number of shards (at most 32, the shards of an operation are a bit mask)
+     */
+    static const size_t SHARDS = size_t(1) << SHARD_BITS;
+    /**
+     * @brief mask with every shard
+     */
+    static const uint32_t ALL = (uint32_t) ((uint64_t(1) << SHARDS) - 1);
+
+    /**
+     * Locks a set of shards for the lifetime of the object
+     */
+    class Guard {
+
+    private:
+        ShardLocks &locks;
+        uint32_t exclusive;
+        uint32_t shared;
+
+    public:
+        /**
+         * @brief Locks the shards of the masks in increasing order (a shard in both masks is locked exclusive)
+         * @param locks ShardLocks &locks
+         * @param exclusive uint32_t exclusive (shards that are changed)
+         * @param shared uint32_t shared (shards that are only read)
+         */
+        Guard(ShardLocks &locks, uint32_t exclusive, uint32_t shared = 0);
+
+        Guard(const Guard &) = delete;
+
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard();
+    };
+
+private:
+    /**
+     * @brief lock of each shard
+     */
+    shared_timed_mutex locks[SHARDS];
+    /**
+     * @brief lock of the indexes shared by every shard, always taken after the shards and held briefly
+     */
+    mutex indexes;
+
+public:
+    ShardLocks() {}
+
+    /**
+     * @brief A copy of a Company gets its own unlocked shards
+     */
+    ShardLocks(const ShardLocks &) {}
+
+    ShardLocks &operator=(const ShardLocks &) { return *this; }
+
+    /**
+     * @brief Gets the shard of an id
+     * @param id unsigned int id
+     * @return size_t
+     */
+    static size_t shardOf(unsigned int id) { return (uint32_t) (id * 2654435761u) >> (32 - SHARD_BITS); }
+
+    /**
+     * @brief Gets the mask of the shard of an id
+     * @param id unsigned int id
+     * @return uint32_t
+     */
+    static uint32_t maskOf(unsigned int id) { return uint32_t(1) << shardOf(id); }
+
+    /**
+     * @brief Gets the lock of the indexes shared by every shard (sorted views, fare calendar, passenger status
+     * lists, object pools), which a thread must take after its shards
+     * @return mutex &
+     */
+    mutex &indexLock() { return indexes; }
+};
+
+#endif //AEDA_FEUP_PROJECT_SHARDLOCKS_H
@@ -0,0 +1,296 @@
+#include "Snapshot.h"
+#include "RadixSort.h"
+
+PassengerRow::PassengerRow(const Passenger *p) : id(p->getId()), name(p->getName()),
+                                                 birth(dateKey(p->getDateOfBirth())) {
+    stringstream s;
+    s << p;
+    line = s.str();
+    p->formatSummary(summary);
+}
+
+FlightRow::FlightRow(Flight *f) : id(f->getId()), price(f->getBasePrice()), departure(dateKey(f->getDate())),
+                                  destination(f->getDestination()) {
+    f->formatHead(head);
+    if (f->getKind() == FLIGHT_RENTED) {
+        if (f->getBuyer() != nullptr)
+            seats.emplace_back("", make_shared<const string>(to_string(f->getBuyer()->getId())));
+    } else {
+        const PassengerMap &passengers = f->getPassengers();
+        for (auto it = passengers.begin(); it != passengers.end();) {
+            string row = it->first.substr(0, it->first.size() - 1), text;
+            f->formatSeatRow(text, it->first);
+            seats.emplace_back(row + 'A', make_shared<const string>(std::move(text)));
+            it = passengers.upper_bound(row + (char) ('A' + SeatMap::ROW_SEATS - 1));
+        }
+    }
+    f->formatList(list);
+}
+
+FlightRow::FlightRow(const FlightRow &before, Flight *f, const string &seat) : FlightRow(before) {
+    string from = seat.substr(0, seat.size() - 1) + 'A', text;
+    auto it = lower_bound(seats.begin(), seats.end(), from,
+                          [](const pair<string, shared_ptr<const string> > &s, const string &k) {
+                              return s.first < k;
+                          });
+    bool found = it != seats.end() && it->first == from;
+    f->formatSeatRow(text, seat);
+    if (text.empty()) {
+        if (found) seats.erase(it);
+    } else if (found) it->second = make_shared<const string>(std::move(text));
+    else seats.emplace(it, from, make_shared<const string>(std::move(text)));
+}
+
+ostream &operator<<(ostream &o, const PassengerRow &row) {
+    return o << row.line;
+}
+
+ostream &operator<<(ostream &o, const FlightRow &row) {
+    o << row.head;
+    if (row.seats.empty()) return o << "no_passengers";
+    for (size_t i = 0; i < row.seats.size(); i++) o << (i == 0 ? "" : ", ") << *row.seats[i].second;
+    return o;
+}
+
+/**
+ * @brief Appends the rows of a table or an order to a vector in their order
+ * @param rows const Rows &rows
+ * @param out vector<const Row *> &out
+ */
+template<class Rows, class Row>
+static void appendRows(const Rows &rows, vector<const Row *> &out) {
+    for (auto const &r : rows) out.push_back(&r);
+}
+
+vector<const PassengerRow *> CompanySnapshot::passengersBy(type t) const {
+    vector<const PassengerRow *> rows;
+    rows.reserve((t != PINC ? active->size() : 0) + (t != PACT ? inactive->size() : 0));
+    switch (t) {
+        case PID:
+            // both tables are in id order, so they are merged in linear time
+            appendRows(*active, rows);
+            appendRows(*inactive, rows);
+            inplace_merge(rows.begin(), rows.begin() + active->size(), rows.end(),
+                          [](const PassengerRow *a, const PassengerRow *b) { return a->id < b->id; });
+            break;
+        case PNAME:
+            appendRows(*passengersByName, rows);
+            break;
+        case PAGE:
+            appendRows(*passengersByAge, rows);
+            break;
+        case PACT:
+            appendRows(*active, rows);
+            break;
+        case PINC:
+            appendRows(*inactive, rows);
+            break;
+        default:
+            break;
+    }
+    return rows;
+}
+
+vector<const FlightRow *> CompanySnapshot::flightsBy(type t) const {
+    vector<const FlightRow *> rows;
+    rows.reserve(flights->size());
+    switch (t) {
+        case FID:
+            appendRows(*flights, rows);
+            break;
+        case FPRICEL:
+        case FPRICEH:
+            appendRows(*flightsByPrice, rows);
+            if (t == FPRICEH) reverse(rows.begin(), rows.end());
+            break;
+        case FDEST:
+            appendRows(*flightsByDestination, rows);
+            break;
+        case FTIME:
+            appendRows(*flightsByTime, rows);
+            break;
+        default:
+            break;
+    }
+    return rows;
+}
+
+SnapshotStore::Batch::Batch(SnapshotStore &store) : store(store) {
+    lock_guard<mutex> lock(store.writers);
+    store.depth++;
+}
+
+SnapshotStore::Batch::~Batch() {
+    lock_guard<mutex> lock(store.writers);
+    store.depth--;
+    store.publish();
+}
+
+SnapshotStore::SnapshotStore() {
+    CompanySnapshot *empty = new CompanySnapshot;
+    empty->active = new RowTable<PassengerRow>;
+    empty->inactive = new RowTable<PassengerRow>;
+    empty->flights = new RowTable<FlightRow>;
+    empty->passengersByName = new RowOrder<PassengerRow, PassengerByName>;
+    empty->passengersByAge = new RowOrder<PassengerRow, PassengerByAge>;
+    empty->flightsByPrice = new RowOrder<FlightRow, FlightByPrice>;
+    empty->flightsByDestination = new RowOrder<FlightRow, FlightByDestination>;
+    empty->flightsByTime = new RowOrder<FlightRow, FlightByTime>;
+    current.store(empty);
+}
+
+SnapshotStore::SnapshotStore(const SnapshotStore &) : SnapshotStore() {}
+
+SnapshotStore::~SnapshotStore() {
+    const CompanySnapshot *last = current.load();
+    vector<const PassengerChunk *> passengerChunks;
+    vector<const FlightChunk *> flightChunks;
+    last->active->collect(passengerChunks);
+    last->inactive->collect(passengerChunks);
+    last->flights->collect(flightChunks);
+    last->passengersByName->collect(passengerChunks);
+    last->passengersByAge->collect(passengerChunks);
+    last->flightsByPrice->collect(flightChunks);
+    last->flightsByDestination->collect(flightChunks);
+    last->flightsByTime->collect(flightChunks);
+    for (auto c : passengerChunks) delete c;
+    for (auto c : flightChunks) delete c;
+    delete last->active;
+    delete last->inactive;
+    delete last->flights;
+    delete last->passengersByName;
+    delete last->passengersByAge;
+    delete last->flightsByPrice;
+    delete last->flightsByDestination;
+    delete last->flightsByTime;
+    delete last;
+}
+
+void SnapshotStore::publish() {
+    if (depth > 0) return;
+    bool passengers = passengersCleared || !activeChanges.empty() || !inactiveChanges.empty();
+    bool flights = flightsCleared || !flightChanges.empty();
+    if (!passengers && !flights) return;
+
+    const CompanySnapshot *old = current.load();
+    CompanySnapshot *next = new CompanySnapshot(*old);
+    vector<const PassengerChunk *> passengerChunks;
+    vector<const FlightChunk *> flightChunks;
+    if (passengers) {
+        // a passenger has a row in one of the tables, but in every order
+        vector<RowChange<PassengerRow> > changes;
+        auto change = [&](unsigned int id, const shared_ptr<const PassengerRow> &row) {
+            const PassengerRow *before = nullptr;
+            if (!passengersCleared) {
+                before = old->active->find(id);
+                if (before == nullptr) before = old->inactive->find(id);
+            }
+            if (before != nullptr || row != nullptr) changes.push_back({before, row});
+        };
+        for (auto const &c : activeChanges) {
+            auto other = inactiveChanges.find(c.first);
+            change(c.first, c.second != nullptr || other == inactiveChanges.end() ? c.second : other->second);
+        }
+        for (auto const &c : inactiveChanges)
+            if (activeChanges.find(c.first) == activeChanges.end()) change(c.first, c.second);
+
+        next->passengersByName = old->passengersByName->apply(changes, passengersCleared, passengerChunks);
+        next->passengersByAge = old->passengersByAge->apply(changes, passengersCleared, passengerChunks);
+        next->active = old->active->apply(activeChanges, passengersCleared, passengerChunks);
+        next->inactive = old->inactive->apply(inactiveChanges, passengersCleared, passengerChunks);
+    }
+    if (flights) {
+        vector<RowChange<FlightRow> > changes;
+        for (auto const &c : flightChanges) {
+            const FlightRow *before = flightsCleared ? nullptr : old->flights->find(c.first);
+            if (before != nullptr || c.second != nullptr) changes.push_back({before, c.second});
+        }
+        next->flightsByPrice = old->flightsByPrice->apply(changes, flightsCleared, flightChunks);
+        next->flightsByDestination = old->flightsByDestination->apply(changes, flightsCleared, flightChunks);
+        next->flightsByTime = old->flightsByTime->apply(changes, flightsCleared, flightChunks);
+        next->flights = old->flights->apply(flightChanges, flightsCleared, flightChunks);
+    }
+    passengersCleared = flightsCleared = false;
+
+    current.store(next);
+
+    // only readers that pinned an epoch before the store above can still use the old version
+    epochs.retire(old);
+    if (passengers) {
+        epochs.retire(old->active);
+        epochs.retire(old->inactive);
+        epochs.retire(old->passengersByName);
+        epochs.retire(old->passengersByAge);
+    }
+    if (flights) {
+        epochs.retire(old->flights);
+        epochs.retire(old->flightsByPrice);
+        epochs.retire(old->flightsByDestination);
+        epochs.retire(old->flightsByTime);
+    }
+    for (auto c : passengerChunks) epochs.retire(c);
+    for (auto c : flightChunks) epochs.retire(c);
+    epochs.reclaim();
+}
+
+void SnapshotStore::putPassenger(const Passenger *p, bool active) {
+    unique_ptr<PassengerRow> row(new PassengerRow(p));
+    unsigned int id = row->id;
+    lock_guard<mutex> lock(writers);
+    (active ? inactiveChanges : activeChanges)[id].reset();
+    (active ? activeChanges : inactiveChanges)[id] = std::move(row);
+    publish();
+}
+
+void SnapshotStore::erasePassenger(unsigned int id) {
+    lock_guard<mutex> lock(writers);
+    activeChanges[id].reset();
+    inactiveChanges[id].reset();
+    publish();
+}
+
+void SnapshotStore::putFlight(Flight *f) {
+    unique_ptr<FlightRow> row(new FlightRow(f));
+    unsigned int id = row->id;
+    lock_guard<mutex> lock(writers);
+    flightChanges[id] = std::move(row);
+    publish();
+}
+
+void SnapshotStore::putFlightSeat(Flight *f, const string &seat) {
+    if (f->getKind() != FLIGHT_COMMERCIAL) {
+        putFlight(f);
+        return;
+    }
+    unsigned int id = f->getId();
+    lock_guard<mutex> lock(writers);
+    // the last row of the flight is its pending change or its row in the current snapshot
+    const FlightRow *before = nullptr;
+    auto pending = flightChanges.find(id);
+    if (pending != flightChanges.end()) before = pending->second.get();
+    else if (!flightsCleared) before = current.load()->flights->find(id);
+    flightChanges[id] = before != nullptr ? make_shared<const FlightRow>(*before, f, seat)
+                                          : make_shared<const FlightRow>(f);
+    publish();
+}
+
+void SnapshotStore::eraseFlight(unsigned int id) {
+    lock_guard<mutex> lock(writers);
+    flightChanges[id].reset();
+    publish();
+}
+
+void SnapshotStore::clearPassengers() {
+    lock_guard<mutex> lock(writers);
+    activeChanges.clear();
+    inactiveChanges.clear();
+    passengersCleared = true;
+    publish();
+}
+
+void SnapshotStore::clearFlights() {
+    lock_guard<mutex> lock(writers);
+    flightChanges.clear();
+    flightsCleared = true;
+    publish();
+}
@@ -0,0 +1,620 @@
+#ifndef AEDA_FEUP_PROJECT_SNAPSHOT_H
+#define AEDA_FEUP_PROJECT_SNAPSHOT_H
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <iterator>
+#include <algorithm>
+#include <unordered_set>
+#include "helper.h"
+#include "Passenger.h"
+#include "Flight.h"
+#include "Epoch.h"
+
+using namespace std;
+
+/**
+ * Immutable copy of what the reports and the passengers file show of a Passenger
+ */
+struct PassengerRow {
+    unsigned int id;
+    string name;
+    /**
+     * @brief dateKey of the date of birth
+     */
+    uint64_t birth;
+    /**
+     * @brief line of the passengers file
+     */
+    string line;
+    /**
+     * @brief row of the passenger summary (Passenger::formatSummary)
+     */
+    string summary;
+
+    explicit PassengerRow(const Passenger *p);
+};
+
+/**
+ * Immutable copy of what the reports and the flights file show of a Flight
+ */
+struct FlightRow {
+    unsigned int id;
+    unsigned int price;
+    /**
+     * @brief dateKey of the departure
+     */
+    uint64_t departure;
+    string destination;
+    /**
+     * @brief line of the flights file up to the passengers (Flight::formatHead)
+     */
+    string head;
+    /**
+     * @brief passengers of the line by seat row, in the order of the file: the seat A of the row (the buyer id of a
+     * rented flight is kept under an empty key) and the passengers of the row, shared with the older rows
+     */
+    vector<pair<string, shared_ptr<const string> > > seats;
+    /**
+     * @brief row of the flight list (Flight::formatList)
+     */
+    string list;
+
+    explicit FlightRow(Flight *f);
+
+    /**
+     * @brief Builds the row of a flight in which only the passengers of the seat row of a seat changed since the
+     * row passed as argument, so only that seat row is rendered again
+     * @param before const FlightRow &before
+     * @param f Flight *f (commercial)
+     * @param seat const string &seat
+     */
+    FlightRow(const FlightRow &before, Flight *f, const string &seat);
+};
+
+/**
+ * @brief Writes the line of the passengers file of a row
+ */
+ostream &operator<<(ostream &o, const PassengerRow &row);
+
+/**
+ * @brief Writes the line of the flights file of a row
+ */
+ostream &operator<<(ostream &o, const FlightRow &row);
+
+//! struct PassengerByName
+/*! Order of the passengers by name list, ties by id */
+struct PassengerByName {
+    bool operator()(const PassengerRow &a, const PassengerRow &b) const {
+        return a.name != b.name ? a.name < b.name : a.id < b.id;
+    }
+};
+
+//! struct PassengerByAge
+/*! Order of the passengers by age list (youngest first), ties by id */
+struct PassengerByAge {
+    bool operator()(const PassengerRow &a, const PassengerRow &b) const {
+        return a.birth != b.birth ? a.birth > b.birth : a.id < b.id;
+    }
+};
+
+//! struct FlightByPrice
+/*! Order of the flights by price list (low to high), ties by id */
+struct FlightByPrice {
+    bool operator()(const FlightRow &a, const FlightRow &b) const {
+        return a.price != b.price ? a.price < b.price : a.id < b.id;
+    }
+};
+
+//! struct FlightByDestination
+/*! Order of the flights by destination list, ties by id */
+struct FlightByDestination {
+    bool operator()(const FlightRow &a, const FlightRow &b) const {
+        return a.destination != b.destination ? a.destination < b.destination : a.id < b.id;
+    }
+};
+
+//! struct FlightByTime
+/*! Order of the flights by time to flight list, ties by id */
+struct FlightByTime {
+    bool operator()(const FlightRow &a, const FlightRow &b) const {
+        return a.departure != b.departure ? a.departure < b.departure : a.id < b.id;
+    }
+};
+
+/**
+ * Immutable table of rows in increasing id order, split in chunks of at most 2 * CHUNK rows.
+ * A new version of a table shares every chunk that its changes did not touch with the previous one, so publishing a
+ * change copies the chunk directory and one chunk instead of the whole table.
+ */
+template<class Row>
+class RowTable {
+
+public:
+    /**
+     * @brief rows of a chunk after a split
+     */
+    static const size_t CHUNK = 64;
+
+    //! struct Chunk
+    /*! Consecutive rows of a table, never empty. The rows are shared by the copies of the chunk */
+    struct Chunk {
+        vector<shared_ptr<const Row> > rows; /*!< rows in increasing id order */
+    };
+
+    /**
+     * Iterates the rows of a table in increasing id order
+     */
+    class Iterator {
+
+    private:
+        const vector<const Chunk *> *chunks;
+        size_t chunk;
+        size_t row;
+
+    public:
+        Iterator(const vector<const Chunk *> *chunks, size_t chunk) : chunks(chunks), chunk(chunk), row(0) {}
+
+        const Row &operator*() const { return *(*chunks)[chunk]->rows[row]; }
+
+        Iterator &operator++() {
+            if (++row == (*chunks)[chunk]->rows.size()) {
+                chunk++;
+                row = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator &it) const { return chunk == it.chunk && row == it.row; }
+
+        bool operator!=(const Iterator &it) const { return !(*this == it); }
+    };
+
+private:
+    /**
+     * @brief chunks in increasing id order, shared with the other versions of the table
+     */
+    vector<const Chunk *> chunks;
+    /**
+     * @brief number of rows
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Gets the position of the chunk that holds the id passed as argument, or that would hold it
+     * @param id unsigned int id
+     * @return size_t (the table must not be empty)
+     */
+    size_t locate(unsigned int id) const {
+        auto it = upper_bound(chunks.begin(), chunks.end(), id,
+                              [](unsigned int i, const Chunk *c) { return i < c->rows.front()->id; });
+        return it == chunks.begin() ? 0 : (size_t) (it - chunks.begin()) - 1;
+    }
+
+    /**
+     * @brief Gets the position of a row in a chunk, or where it would be inserted
+     * @param chunk const Chunk *chunk
+     * @param id unsigned int id
+     * @return size_t
+     */
+    static size_t position(const Chunk *chunk, unsigned int id) {
+        auto it = lower_bound(chunk->rows.begin(), chunk->rows.end(), id,
+                              [](const shared_ptr<const Row> &r, unsigned int i) { return r->id < i; });
+        return (size_t) (it - chunk->rows.begin());
+    }
+
+public:
+    size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+
+    Iterator begin() const { return Iterator(&chunks, 0); }
+
+    Iterator end() const { return Iterator(&chunks, chunks.size()); }
+
+    /**
+     * @brief Finds a row by id
+     * @param id unsigned int id
+     * @return const Row *, nullptr if there is none
+     */
+    const Row *find(unsigned int id) const {
+        if (chunks.empty()) return nullptr;
+        const Chunk *chunk = chunks[locate(id)];
+        size_t i = position(chunk, id);
+        return i < chunk->rows.size() && chunk->rows[i]->id == id ? chunk->rows[i].get() : nullptr;
+    }
+
+    /**
+     * @brief Builds the next version of the table. Every touched chunk is copied once (its rows are shared, not
+     * copied) and the copy is changed in place; the chunks that the new version no longer uses are appended to
+     * replaced, to be retired once the new version is published
+     * @param changes map<unsigned int, shared_ptr<const Row> > &changes (new row by id, nullptr erases; the rows are
+     * moved)
+     * @param clear bool clear (if true, the changes apply to an empty table)
+     * @param replaced vector<const Chunk *> &replaced
+     * @return RowTable * new version
+     */
+    RowTable *apply(map<unsigned int, shared_ptr<const Row> > &changes, bool clear,
+                    vector<const Chunk *> &replaced) const {
+        RowTable *next = new RowTable;
+        if (clear) replaced.insert(replaced.end(), chunks.begin(), chunks.end());
+        else *next = *this;
+
+        unordered_set<const Chunk *> fresh;
+        for (auto &c : changes) {
+            unsigned int id = c.first;
+            if (next->chunks.empty()) {
+                if (c.second == nullptr) continue;
+                Chunk *chunk = new Chunk;
+                chunk->rows.emplace_back(std::move(c.second));
+                next->chunks.push_back(chunk);
+                fresh.insert(chunk);
+                next->count++;
+                continue;
+            }
+
+            size_t i = next->locate(id);
+            const Chunk *old = next->chunks[i];
+            size_t pos = position(old, id);
+            bool found = pos < old->rows.size() && old->rows[pos]->id == id;
+            if (!found && c.second == nullptr) continue;
+
+            Chunk *chunk;
+            if (fresh.count(old)) chunk = const_cast<Chunk *>(old);
+            else {
+                chunk = new Chunk(*old);
+                fresh.insert(chunk);
+                replaced.push_back(old);
+                next->chunks[i] = chunk;
+            }
+
+            if (c.second == nullptr) {
+                chunk->rows.erase(chunk->rows.begin() + pos);
+                next->count--;
+                if (chunk->rows.empty()) {
+                    next->chunks.erase(next->chunks.begin() + i);
+                    fresh.erase(chunk);
+                    delete chunk;
+                }
+            } else if (found) chunk->rows[pos] = std::move(c.second);
+            else {
+                chunk->rows.emplace(chunk->rows.begin() + pos, std::move(c.second));
+                next->count++;
+                if (chunk->rows.size() > 2 * CHUNK) {
+                    Chunk *half = new Chunk;
+                    half->rows.assign(make_move_iterator(chunk->rows.begin() + CHUNK),
+                                      make_move_iterator(chunk->rows.end()));
+                    chunk->rows.erase(chunk->rows.begin() + CHUNK, chunk->rows.end());
+                    next->chunks.insert(next->chunks.begin() + i + 1, half);
+                    fresh.insert(half);
+                }
+            }
+        }
+        changes.clear();
+        return next;
+    }
+
+    /**
+     * @brief Appends every chunk of the table to the vector passed as argument
+     * @param out vector<const Chunk *> &out
+     */
+    void collect(vector<const Chunk *> &out) const { out.insert(out.end(), chunks.begin(), chunks.end()); }
+};
+
+template<class Row>
+const size_t RowTable<Row>::CHUNK;
+
+//! struct RowChange
+/*! Change of a row of the tables of a RowOrder */
+template<class Row>
+struct RowChange {
+    const Row *old;            /*!< row that is replaced or erased, nullptr for a new row */
+    shared_ptr<const Row> row; /*!< new row, nullptr if the row is erased */
+};
+
+/**
+ * Immutable sequence of the rows of one or more RowTables in the order of Less, which must break the ties by id.
+ * It is split in chunks like a RowTable and shares the rows of the tables, so publishing a change moves one row in
+ * each order (copying the chunk directory and one chunk) and a list is read in its order without being sorted.
+ */
+template<class Row, class Less>
+class RowOrder {
+
+public:
+    typedef typename RowTable<Row>::Chunk Chunk;
+    typedef typename RowTable<Row>::Iterator Iterator;
+
+    typedef RowChange<Row> Change;
+
+private:
+    /**
+     * @brief chunks in the order of Less, shared with the other versions of the order
+     */
+    vector<const Chunk *> chunks;
+    /**
+     * @brief number of rows
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Gets the position of the chunk that holds the row passed as argument, or that would hold it
+     * @param row const Row &row
+     * @return size_t (the order must not be empty)
+     */
+    size_t locate(const Row &row) const {
+        auto it = upper_bound(chunks.begin(), chunks.end(), &row,
+                              [](const Row *r, const Chunk *c) { return Less()(*r, *c->rows.front()); });
+        return it == chunks.begin() ? 0 : (size_t) (it - chunks.begin()) - 1;
+    }
+
+    /**
+     * @brief Gets the position of a row in a chunk, or where it would be inserted
+     * @param chunk const Chunk *chunk
+     * @param row const Row &row
+     * @return size_t
+     */
+    static size_t position(const Chunk *chunk, const Row &row) {
+        auto it = lower_bound(chunk->rows.begin(), chunk->rows.end(), &row,
+                              [](const shared_ptr<const Row> &r, const Row *b) { return Less()(*r, *b); });
+        return (size_t) (it - chunk->rows.begin());
+    }
+
+public:
+    size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+
+    Iterator begin() const { return Iterator(&chunks, 0); }
+
+    Iterator end() const { return Iterator(&chunks, chunks.size()); }
+
+    /**
+     * @brief Builds the next version of the order like RowTable::apply. If clear is true the new rows are sorted
+     * once, as after loading a file; otherwise each change erases its old row and inserts its new one
+     * @param changes const vector<Change> &changes
+     * @param clear bool clear (if true, the changes apply to an empty order)
+     * @param replaced vector<const Chunk *> &replaced
+     * @return RowOrder * new version
+     */
+    RowOrder *apply(const vector<Change> &changes, bool clear, vector<const Chunk *> &replaced) const {
+        RowOrder *next = new RowOrder;
+        if (clear) {
+            replaced.insert(replaced.end(), chunks.begin(), chunks.end());
+            vector<shared_ptr<const Row> > rows;
+            for (auto const &c : changes) if (c.row != nullptr) rows.push_back(c.row);
+            sort(rows.begin(), rows.end(),
+                 [](const shared_ptr<const Row> &a, const shared_ptr<const Row> &b) { return Less()(*a, *b); });
+            for (size_t i = 0; i < rows.size(); i += RowTable<Row>::CHUNK) {
+                Chunk *chunk = new Chunk;
+                chunk->rows.assign(rows.begin() + i, rows.begin() + min(i + RowTable<Row>::CHUNK, rows.size()));
+                next->chunks.push_back(chunk);
+            }
+            next->count = rows.size();
+            return next;
+        }
+        *next = *this;
+
+        unordered_set<const Chunk *> fresh;
+        auto own = [next, &fresh, &replaced](size_t i) {
+            const Chunk *old = next->chunks[i];
+            if (fresh.count(old)) return const_cast<Chunk *>(old);
+            Chunk *chunk = new Chunk(*old);
+            fresh.insert(chunk);
+            replaced.push_back(old);
+            next->chunks[i] = chunk;
+            return chunk;
+        };
+
+        for (auto const &c : changes) {
+            if (c.old != nullptr && !next->chunks.empty()) {
+                size_t i = next->locate(*c.old);
+                size_t pos = position(next->chunks[i], *c.old);
+                if (pos < next->chunks[i]->rows.size() && next->chunks[i]->rows[pos].get() == c.old) {
+                    Chunk *chunk = own(i);
+                    chunk->rows.erase(chunk->rows.begin() + pos);
+                    next->count--;
+                    if (chunk->rows.empty()) {
+                        next->chunks.erase(next->chunks.begin() + i);
+                        fresh.erase(chunk);
+                        delete chunk;
+                    }
+                }
+            }
+            if (c.row == nullptr) continue;
+
+            next->count++;
+            if (next->chunks.empty()) {
+                Chunk *chunk = new Chunk;
+                chunk->rows.push_back(c.row);
+                next->chunks.push_back(chunk);
+                fresh.insert(chunk);
+                continue;
+            }
+            size_t i = next->locate(*c.row);
+            Chunk *chunk = own(i);
+            chunk->rows.insert(chunk->rows.begin() + position(chunk, *c.row), c.row);
+            if (chunk->rows.size() > 2 * RowTable<Row>::CHUNK) {
+                Chunk *half = new Chunk;
+                half->rows.assign(chunk->rows.begin() + RowTable<Row>::CHUNK, chunk->rows.end());
+                chunk->rows.erase(chunk->rows.begin() + RowTable<Row>::CHUNK, chunk->rows.end());
+                next->chunks.insert(next->chunks.begin() + i + 1, half);
+                fresh.insert(half);
+            }
+        }
+        return next;
+    }
+
+    /**
+     * @brief Appends every chunk of the order to the vector passed as argument
+     * @param out vector<const Chunk *> &out
+     */
+    void collect(vector<const Chunk *> &out) const { out.insert(out.end(), chunks.begin(), chunks.end()); }
+};
+
+/**
+ * Consistent version of the passengers and the future flights of the Company, never changed once published
+ */
+struct CompanySnapshot {
+    const RowTable<PassengerRow> *active = nullptr;   /*!< active passengers */
+    const RowTable<PassengerRow> *inactive = nullptr; /*!< inactive passengers */
+    const RowTable<FlightRow> *flights = nullptr;     /*!< flights that did not land */
+    const RowOrder<PassengerRow, PassengerByName> *passengersByName = nullptr; /*!< every passenger by name */
+    const RowOrder<PassengerRow, PassengerByAge> *passengersByAge = nullptr;   /*!< every passenger by age */
+    const RowOrder<FlightRow, FlightByPrice> *flightsByPrice = nullptr;        /*!< flights by price */
+    const RowOrder<FlightRow, FlightByDestination> *flightsByDestination = nullptr; /*!< flights by destination */
+    const RowOrder<FlightRow, FlightByTime> *flightsByTime = nullptr;          /*!< flights by departure */
+
+    /**
+     * @brief Gets the passengers of a list of the lists menu in the order of the list, without sorting them
+     * @param t type t (PID, PNAME, PAGE, PACT or PINC, ties are ordered by id)
+     * @return vector<const PassengerRow *>
+     */
+    vector<const PassengerRow *> passengersBy(type t) const;
+
+    /**
+     * @brief Gets the flights of a list of the lists menu in the order of the list, without sorting them
+     * @param t type t (FID, FPRICEL, FPRICEH, FDEST or FTIME, ties are ordered by id)
+     * @return vector<const FlightRow *>
+     */
+    vector<const FlightRow *> flightsBy(type t) const;
+};
+
+/**
+ * Read-copy-update publication of the CompanySnapshot.
+ * Readers pin an epoch and read the current snapshot without any lock, so a long report or a save never blocks the
+ * bookings and always sees one consistent version. Writers render the rows of the objects they changed and publish
+ * a new snapshot that shares the untouched chunks with the previous one; the versions that are no longer current
+ * are deleted once the readers that pinned them leave.
+ */
+class SnapshotStore {
+
+public:
+    /**
+     * Pins the current snapshot while it is in scope
+     */
+    class Reader {
+
+    private:
+        EpochDomain::Guard guard;
+        const CompanySnapshot *snapshot;
+
+    public:
+        explicit Reader(const SnapshotStore &store) : guard(store.epochs), snapshot(store.current.load()) {}
+
+        const CompanySnapshot *operator->() const { return snapshot; }
+
+        const CompanySnapshot &operator*() const { return *snapshot; }
+    };
+
+    /**
+     * Defers the publication of the changes made while it is in scope, which are then published as one version
+     */
+    class Batch {
+
+    private:
+        SnapshotStore &store;
+
+    public:
+        explicit Batch(SnapshotStore &store);
+
+        Batch(const Batch &) = delete;
+
+        Batch &operator=(const Batch &) = delete;
+
+        ~Batch();
+    };
+
+private:
+    typedef RowTable<PassengerRow>::Chunk PassengerChunk;
+    typedef RowTable<FlightRow>::Chunk FlightChunk;
+
+    /**
+     * @brief epochs pinned by the readers
+     */
+    mutable EpochDomain epochs;
+    /**
+     * @brief snapshot read by new readers
+     */
+    atomic<const CompanySnapshot *> current;
+    /**
+     * @brief serializes the writers
+     */
+    mutex writers;
+    /**
+     * @brief number of open batches
+     */
+    unsigned int depth = 0;
+    /**
+     * @brief changes not published yet
+     */
+    map<unsigned int, shared_ptr<const PassengerRow> > activeChanges, inactiveChanges;
+    map<unsigned int, shared_ptr<const FlightRow> > flightChanges;
+    /**
+     * @brief true if the passengers or the flights were cleared since the last publication
+     */
+    bool passengersCleared = false, flightsCleared = false;
+
+    /**
+     * @brief Publishes the pending changes unless a batch is open (writers must be held)
+     */
+    void publish();
+
+public:
+    SnapshotStore();
+
+    /**
+     * @brief Snapshots are not copied, a copy starts with an empty snapshot
+     */
+    SnapshotStore(const SnapshotStore &);
+
+    SnapshotStore &operator=(const SnapshotStore &) { return *this; }
+
+    ~SnapshotStore();
+
+    /**
+     * @brief Publishes the current state of a passenger
+     * @param p const Passenger *p
+     * @param active bool active
+     */
+    void putPassenger(const Passenger *p, bool active);
+
+    /**
+     * @brief Publishes the removal of a passenger
+     * @param id unsigned int id
+     */
+    void erasePassenger(unsigned int id);
+
+    /**
+     * @brief Publishes the current state of a flight
+     * @param f Flight *f
+     */
+    void putFlight(Flight *f);
+
+    /**
+     * @brief Publishes a flight in which only the passengers of the seat row of a seat changed
+     * @param f Flight *f
+     * @param seat const string &seat
+     */
+    void putFlightSeat(Flight *f, const string &seat);
+
+    /**
+     * @brief Publishes the removal of a flight
+     * @param id unsigned int id
+     */
+    void eraseFlight(unsigned int id);
+
+    /**
+     * @brief Publishes the removal of every passenger
+     */
+    void clearPassengers();
+
+    /**
+     * @brief Publishes the removal of every flight
+     */
+    void clearFlights();
+};
+
+#endif //AEDA_FEUP_PROJECT_SNAPSHOT_H
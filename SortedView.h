@@ -0,0 +1,201 @@
+#ifndef AEDA_FEUP_PROJECT_SORTEDVIEW_H
+#define AEDA_FEUP_PROJECT_SORTEDVIEW_H
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "RadixSort.h"
+
+using namespace std;
+
+/**
+ * A persistent sorted permutation of a container of pointers, stamped with the version of the container it reflects.
+ * While the stamp matches, the view is kept up to date incrementally; once it falls behind it is rebuilt lazily
+ * the next time it is read.
+ */
+template<class T>
+class SortedView {
+
+public:
+    typedef bool (*Compare)(T *, T *);
+    typedef uint64_t (*Key)(T *);
+
+private:
+    /**
+     * @brief comparator that defines the order of the view
+     */
+    Compare comp;
+    /**
+     * @brief fixed width key consistent with comp, used to rebuild the view with a radix sort
+     */
+    Key key;
+    /**
+     * @brief sorted pointers
+     */
+    vector<T *> items;
+    /**
+     * @brief version of the source container the view reflects
+     */
+    unsigned int version = 0;
+    /**
+     * @brief true once the view has been built at least once
+     */
+    bool built = false;
+
+    /**
+     * @brief Gets the position of the item passed as argument (items.end() if it is not in the view)
+     * @param item T *item
+     * @return iterator
+     */
+    typename vector<T *>::iterator locate(T *item) {
+        auto range = equal_range(items.begin(), items.end(), item, comp);
+        auto it = find(range.first, range.second, item);
+        if (it != range.second) return it;
+        // the sort key of the item changed since it was inserted
+        return find(items.begin(), items.end(), item);
+    }
+
+public:
+    /**
+     * @brief Constructor of a SortedView with the comparator and the sort key passed as argument
+     * @param comp Compare comp
+     * @param key Key key (if nullptr the view is rebuilt with std::sort)
+     */
+    explicit SortedView(Compare comp = nullptr, Key key = nullptr) : comp(comp), key(key) {}
+
+    /**
+     * @brief Checks if the view reflects the version passed as argument
+     * @param v unsigned int v
+     * @return true if the view is up to date and false otherwise
+     */
+    bool current(unsigned int v) const { return built && version == v; }
+
+    /**
+     * @brief Gets the comparator of the view
+     * @return Compare
+     */
+    Compare getCompare() const { return comp; }
+
+    /**
+     * @brief Gets the sorted items
+     * @return const vector<T *>&
+     */
+    const vector<T *> &get() const { return items; }
+
+    /**
+     * @brief Rebuilds the view from the passed source and stamps it with the version passed as argument
+     * @param source vector<T *> source
+     * @param v unsigned int v
+     */
+    void rebuild(vector<T *> source, unsigned int v) {
+        items = std::move(source);
+        if (key != nullptr) radixSortBy(items, key, comp);
+        else sort(items.begin(), items.end(), comp);
+        version = v;
+        built = true;
+    }
+
+    /**
+     * @brief Marks the view as stale so that it is rebuilt on the next read
+     */
+    void invalidate() { built = false; }
+
+    /**
+     * @brief Restamps the view after a change of the source that does not affect it
+     * @param from unsigned int version before the change
+     * @param to unsigned int version after the change
+     */
+    void touch(unsigned int from, unsigned int to) {
+        if (current(from)) version = to;
+    }
+
+    /**
+     * @brief Inserts an item in order if the view is up to date, otherwise leaves it stale
+     * @param item T *item
+     * @param from unsigned int version before the change
+     * @param to unsigned int version after the change
+     */
+    void insert(T *item, unsigned int from, unsigned int to) {
+        if (!current(from)) return;
+        items.insert(upper_bound(items.begin(), items.end(), item, comp), item);
+        version = to;
+    }
+
+    /**
+     * @brief Erases an item if the view is up to date, otherwise leaves it stale
+     * @param item T *item
+     * @param from unsigned int version before the change
+     * @param to unsigned int version after the change
+     */
+    void erase(T *item, unsigned int from, unsigned int to) {
+        if (!current(from)) return;
+        auto it = locate(item);
+        if (it != items.end()) items.erase(it);
+        version = to;
+    }
+
+    /**
+     * @brief Moves an item whose sort key changed to its new position if the view is up to date
+     * @param item T *item
+     * @param from unsigned int version before the change
+     * @param to unsigned int version after the change
+     */
+    void reposition(T *item, unsigned int from, unsigned int to) {
+        if (!current(from)) return;
+        auto it = find(items.begin(), items.end(), item);
+        if (it != items.end()) items.erase(it);
+        items.insert(upper_bound(items.begin(), items.end(), item, comp), item);
+        version = to;
+    }
+};
+
+/**
+ * @brief Gets a page of an already sorted vector in O(pageSize)
+ * @param sorted const vector<T *> &sorted
+ * @param page size_t page (starting at 0)
+ * @param pageSize size_t pageSize
+ * @return vector<T *>
+ */
+template<class T>
+vector<T *> slicePage(const vector<T *> &sorted, size_t page, size_t pageSize) {
+    size_t first = page * pageSize;
+    if (first >= sorted.size()) return vector<T *>();
+    size_t last = min(sorted.size(), first + pageSize);
+    return vector<T *>(sorted.begin() + first, sorted.begin() + last);
+}
+
+/**
+ * @brief Gets a page of an already sorted vector read backwards in O(pageSize)
+ * @param sorted const vector<T *> &sorted
+ * @param page size_t page (starting at 0, the first page ends with the last item)
+ * @param pageSize size_t pageSize
+ * @return vector<T *>
+ */
+template<class T>
+vector<T *> sliceReversedPage(const vector<T *> &sorted, size_t page, size_t pageSize) {
+    size_t first = page * pageSize;
+    if (first >= sorted.size()) return vector<T *>();
+    size_t last = min(sorted.size(), first + pageSize);
+    return vector<T *>(sorted.rbegin() + first, sorted.rbegin() + last);
+}
+
+/**
+ * @brief Gets a page of an unsorted vector with heap selection, only the first (page + 1) * pageSize items are sorted.
+ * comp must be a total order (ties broken by id) so that consecutive pages never share or skip an item
+ * @param source const vector<T *> &source
+ * @param comp comparator of the list order
+ * @param page size_t page (starting at 0)
+ * @param pageSize size_t pageSize
+ * @return vector<T *>
+ */
+template<class T>
+vector<T *> selectPage(const vector<T *> &source, bool (*comp)(T *, T *), size_t page, size_t pageSize) {
+    size_t first = page * pageSize;
+    if (first >= source.size()) return vector<T *>();
+    size_t last = min(source.size(), first + pageSize);
+    vector<T *> top(last);
+    partial_sort_copy(source.begin(), source.end(), top.begin(), top.end(), comp);
+    return vector<T *>(top.begin() + first, top.end());
+}
+
+#endif //AEDA_FEUP_PROJECT_SORTEDVIEW_H
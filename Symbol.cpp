@@ -0,0 +1,58 @@
+#include "Symbol.h"
+#include "helper.h"
+
+const uint32_t SymbolTable::NONE;
+
+SymbolTable::SymbolTable() {
+    auto it = ids.emplace("", 0).first;
+    texts.push_back(&it->first);
+    normalizedIds.push_back(0);
+}
+
+SymbolTable &SymbolTable::instance() {
+    static SymbolTable *table = new SymbolTable;
+    return *table;
+}
+
+uint32_t SymbolTable::intern(const string &text) {
+    SymbolTable &t = instance();
+    auto it = t.ids.find(text);
+    if (it != t.ids.end()) return it->second;
+
+    uint32_t id = (uint32_t) t.texts.size();
+    it = t.ids.emplace(text, id).first;
+    t.texts.push_back(&it->first);
+    t.normalizedIds.push_back(id);
+
+    // computed now so normalized() never changes the table
+    string s = normalizedText(text);
+    if (s != text) {
+        uint32_t n = intern(s);
+        t.normalizedIds[id] = n;
+    }
+    return id;
+}
+
+uint32_t SymbolTable::find(const string &text) {
+    SymbolTable &t = instance();
+    auto it = t.ids.find(text);
+    return it == t.ids.end() ? NONE : it->second;
+}
+
+string SymbolTable::normalizedText(string text) {
+    if (text.find_first_not_of(' ') == string::npos) return "";
+    normalize(text);
+    return text;
+}
+
+const string &SymbolTable::text(uint32_t id) {
+    return *instance().texts[id];
+}
+
+uint32_t SymbolTable::normalized(uint32_t id) {
+    return instance().normalizedIds[id];
+}
+
+size_t SymbolTable::size() {
+    return instance().texts.size();
+}
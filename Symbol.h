@@ -0,0 +1,139 @@
+#ifndef AEDA_FEUP_PROJECT_SYMBOL_H
+#define AEDA_FEUP_PROJECT_SYMBOL_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Global intern table of the names repeated across the company (cities, airplane models and card jobs).
+ * Each distinct text is stored once and gets a 32-bit id; the empty string always has id 0.
+ * Only intern() changes the table, so threads that only look texts up can share it while nothing is interned.
+ */
+class SymbolTable {
+
+private:
+    /**
+     * @brief id of each text, the keys are the only copy of the texts
+     */
+    unordered_map<string, uint32_t> ids;
+    /**
+     * @brief text of each id (points to a key of ids)
+     */
+    vector<const string *> texts;
+    /**
+     * @brief id of the normalized text (lower case, trimmed) of each id
+     */
+    vector<uint32_t> normalizedIds;
+
+    SymbolTable();
+
+    /**
+     * @brief Gets the table (never destroyed, so symbols may be used at any point of the exit)
+     * @return SymbolTable &
+     */
+    static SymbolTable &instance();
+
+public:
+    /**
+     * @brief id returned by find() for a text that is not in the table
+     */
+    static const uint32_t NONE = UINT32_MAX;
+
+    /**
+     * @brief Gets the id of a text, adding it (and its normalized text) to the table if it is new
+     * @param text const string &text
+     * @return uint32_t
+     */
+    static uint32_t intern(const string &text);
+
+    /**
+     * @brief Gets the id of a text without changing the table
+     * @param text const string &text
+     * @return uint32_t, NONE if the text was never interned
+     */
+    static uint32_t find(const string &text);
+
+    /**
+     * @brief Normalizes a text the way the normalized ids are computed (see normalize in helper)
+     * @param text string text
+     * @return string
+     */
+    static string normalizedText(string text);
+
+    /**
+     * @brief Gets the text of an id
+     * @param id uint32_t id
+     * @return const string &
+     */
+    static const string &text(uint32_t id);
+
+    /**
+     * @brief Gets the id of the normalized text (see normalize in helper) of an id, computed when the id is interned
+     * @param id uint32_t id
+     * @return uint32_t
+     */
+    static uint32_t normalized(uint32_t id);
+
+    /**
+     * @brief Gets the number of distinct texts of the table
+     * @return size_t
+     */
+    static size_t size();
+};
+
+/**
+ * Interned string: a 32-bit id of the SymbolTable. Copies and equality tests are O(1).
+ */
+class Symbol {
+
+private:
+    /**
+     * @brief id of the text in the SymbolTable
+     */
+    uint32_t id;
+
+public:
+    Symbol() : id(0) {}
+
+    Symbol(const string &text) : id(SymbolTable::intern(text)) {}
+
+    Symbol(const char *text) : id(SymbolTable::intern(text)) {}
+
+    /**
+     * @brief Gets the text of the symbol
+     * @return const string &
+     */
+    const string &str() const { return SymbolTable::text(id); }
+
+    /**
+     * @brief Gets the id of the symbol
+     * @return uint32_t
+     */
+    uint32_t getId() const { return id; }
+
+    /**
+     * @brief Gets the symbol of the normalized text (lower case, trimmed)
+     * @return Symbol
+     */
+    Symbol normalized() const {
+        Symbol s;
+        s.id = SymbolTable::normalized(id);
+        return s;
+    }
+
+    bool operator==(const Symbol &s) const { return id == s.id; }
+
+    bool operator!=(const Symbol &s) const { return id != s.id; }
+
+    /**
+     * @brief Alphabetical order of the texts (equal symbols are detected without comparing the texts)
+     * @return true if the text of lhs comes before the text of rhs
+     */
+    bool operator<(const Symbol &s) const { return id != s.id && str() < s.str(); }
+};
+
+#endif //AEDA_FEUP_PROJECT_SYMBOL_H
@@ -1,13 +1,22 @@
 #include "Technician.h"
 #include "Application.h"
+#include "ObjectPool.h"
 
 Technician::Technician(unsigned int id, string name, vector<string> models) {
     this->id = id;
     this->name = name;
-    this->models = models;
+    this->models.assign(models.begin(), models.end());
     this->timeWhenAvailable = Application::currentDate;
 
 }
+
+void *Technician::operator new(size_t size) {
+    return ObjectPool<Technician>::allocate(size);
+}
+
+void Technician::operator delete(void *p, size_t size) {
+    ObjectPool<Technician>::release(p, size);
+}
 //get methods
 
 unsigned int Technician::getId() const {
@@ -18,7 +27,7 @@ string Technician::getName() const {
     return this->name;
 }
 
-vector<string> Technician::getModels() const {
+const vector<Symbol> &Technician::getModels() const {
     return this->models;
 }
 
@@ -33,11 +42,31 @@ void Technician::setId(unsigned int id) {
 }
 
 void Technician::setName(string name) {
-    this->name = name;
+    this->name = move(name);
 }
 
 void Technician::setModels(vector<string> models) {
-    this->models = models;
+    this->models.assign(models.begin(), models.end());
+}
+
+void Technician::addModel(Symbol model) {
+    this->models.push_back(model);
+}
+
+bool Technician::removeModel(Symbol model) {
+    for (auto it = this->models.begin(); it != this->models.end(); it++) {
+        if (*it == model) {
+            this->models.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Technician::hasModel(Symbol model) const {
+    for (auto const &m: this->models)
+        if (m == model) return true;
+    return false;
 }
 
 //Operator overload to sort the priority queue
@@ -54,7 +83,7 @@ ostream &operator<<(ostream &o, const Technician *t) {
     o << to_string(t->id) << "; " << t->name << "; ";
     if (!t->models.empty()) {
         for (int i = 0; i < t->models.size(); i++) {
-            o << t->models.at(i);
+            o << t->models.at(i).str();
             if (i != t->models.size() - 1) o << ", ";
         }
     } else o << "no_models";
@@ -71,8 +100,8 @@ void Technician::print() const {
     for (int i = 0; i < models.size(); i++) {
         if (first) {
             first = false;
-            cout << models.at(i);
-        } else cout << " , " << models.at(i);
+            cout << models.at(i).str();
+        } else cout << " , " << models.at(i).str();
     }
     cout << endl;
     cout << "Time Until Available: ";
@@ -88,7 +117,7 @@ void Technician::printSummary() const {
     size_t s = this->models.size();
     for (auto const &m: this->models) {
         s--;
-        cout << m;
+        cout << m.str();
         if (s) cout << ", ";
     }
     cout << endl;
@@ -7,6 +7,7 @@
 #include <queue>
 #include <queue>
 #include "helper.h"
+#include "Symbol.h"
 
 using namespace std;
 
@@ -14,7 +15,7 @@ class Technician {
 private:
     unsigned int id;
     string name;
-    vector<string> models;
+    vector<Symbol> models;
     Date timeWhenAvailable;
 
 public:
@@ -26,6 +27,20 @@ public:
      */
     Technician(unsigned int id, string name, vector<string> model);
 
+    /**
+     * @brief Allocates a Technician from its ObjectPool
+     * @param size size_t size
+     * @return void *
+     */
+    static void *operator new(size_t size);
+
+    /**
+     * @brief Returns a Technician to its ObjectPool
+     * @param p void *p
+     * @param size size_t size
+     */
+    static void operator delete(void *p, size_t size);
+
     /**
      * @brief Gets the ID number of a Technician
      * @return unsigned int ID of a Technician
@@ -39,10 +54,10 @@ public:
     string getName() const;
 
     /**
-     * @brief Gets the models of a Technician
-     * @return vector <string> models of a Technician
+     * @brief Gets the models of a Technician, without copying them
+     * @return const vector <Symbol> & models of a Technician
      */
-    vector<string> getModels() const;
+    const vector<Symbol> &getModels() const;
 
     /**
      * @brief Gets the time untill the Technician is available
@@ -50,6 +65,13 @@ public:
      */
     Date getTimeWhenAvailable() const;
 
+    /**
+     * @brief Checks if the Technician can repair the model passed as argument (compares interned ids)
+     * @param model Symbol model
+     * @return true if it can and false otherwise
+     */
+    bool hasModel(Symbol model) const;
+
     /**
      * @brief Sets the id of the Technician object to the passed argument
      * @param id unsigned int id
@@ -68,6 +90,19 @@ public:
      */
     void setModels(vector<string> model);
 
+    /**
+     * @brief Adds a model to the Technician
+     * @param model Symbol model
+     */
+    void addModel(Symbol model);
+
+    /**
+     * @brief Removes a model from the Technician
+     * @param model Symbol model
+     * @return true if the model was removed and false if the Technician did not have it
+     */
+    bool removeModel(Symbol model);
+
     /**
      * @brief Sets the timeUntilAvailable of the Technician object to the passed argument
      * @param time Date time
@@ -0,0 +1,122 @@
+#include "TimingWheel.h"
+
+const uint32_t TimingWheel::NIL;
+const unsigned int TimingWheel::LEVEL_BITS;
+const size_t TimingWheel::SLOTS;
+const unsigned int TimingWheel::LEVELS;
+
+TimingWheel::TimingWheel() {
+    clear();
+}
+
+void TimingWheel::place(uint32_t t) {
+    Timer &timer = timers[t];
+    uint64_t expiry = timer.expiry < base ? base : timer.expiry;
+    uint64_t distance = expiry - base;
+
+    unsigned int level = 0;
+    while (level + 1 < LEVELS && distance >= uint64_t(1) << (LEVEL_BITS * (level + 1))) level++;
+    uint64_t reach = (uint64_t(1) << (LEVEL_BITS * LEVELS)) - 1;
+    if (distance > reach) expiry = base + reach;
+
+    size_t slot = (size_t) (expiry >> (LEVEL_BITS * level)) & (SLOTS - 1);
+    timer.bucket = (uint32_t) (level * SLOTS + slot);
+    timer.prev = NIL;
+    timer.next = heads[timer.bucket];
+    if (timer.next != NIL) timers[timer.next].prev = t;
+    heads[timer.bucket] = t;
+    occupied[level] |= uint64_t(1) << slot;
+}
+
+void TimingWheel::unlink(uint32_t t) {
+    Timer &timer = timers[t];
+    if (timer.prev != NIL) timers[timer.prev].next = timer.next;
+    else heads[timer.bucket] = timer.next;
+    if (timer.next != NIL) timers[timer.next].prev = timer.prev;
+    if (heads[timer.bucket] == NIL) occupied[timer.bucket / SLOTS] &= ~(uint64_t(1) << (timer.bucket % SLOTS));
+}
+
+size_t TimingWheel::cascade(unsigned int level) {
+    size_t slot = (size_t) (base >> (LEVEL_BITS * level)) & (SLOTS - 1);
+    size_t bucket = level * SLOTS + slot;
+    uint32_t t = heads[bucket];
+    heads[bucket] = NIL;
+    occupied[level] &= ~(uint64_t(1) << slot);
+    while (t != NIL) {
+        uint32_t next = timers[t].next;
+        place(t);
+        t = next;
+    }
+    return slot;
+}
+
+uint32_t TimingWheel::schedule(uint64_t expiry, uint64_t payload) {
+    uint32_t t;
+    if (freeTimer != NIL) {
+        t = freeTimer;
+        freeTimer = timers[t].next;
+    } else {
+        t = (uint32_t) timers.size();
+        timers.emplace_back();
+    }
+    timers[t].expiry = expiry;
+    timers[t].payload = payload;
+    place(t);
+    count++;
+    return t;
+}
+
+bool TimingWheel::cancel(uint32_t timer) {
+    if (timer >= timers.size() || timers[timer].bucket == NIL) return false;
+    unlink(timer);
+    timers[timer].bucket = NIL;
+    timers[timer].next = freeTimer;
+    freeTimer = timer;
+    count--;
+    return true;
+}
+
+void TimingWheel::advance(uint64_t now, vector<uint64_t> &expired) {
+    while (base <= now) {
+        if (count == 0) {
+            // an empty wheel jumps straight to the clock
+            base = now + 1;
+            return;
+        }
+
+        size_t slot = (size_t) base & (SLOTS - 1);
+        if (slot == 0) {
+            for (unsigned int level = 1; level < LEVELS; level++) {
+                if (cascade(level) != 0) break;
+            }
+        }
+
+        uint32_t t = heads[slot];
+        heads[slot] = NIL;
+        occupied[0] &= ~(uint64_t(1) << slot);
+        while (t != NIL) {
+            Timer &timer = timers[t];
+            expired.push_back(timer.payload);
+            uint32_t next = timer.next;
+            timer.bucket = NIL;
+            timer.next = freeTimer;
+            freeTimer = t;
+            count--;
+            t = next;
+        }
+
+        // skip to the next non empty bucket of this turn of the first level, or to the start of the next turn,
+        // but never past now: a timer scheduled later must still find its tick unprocessed
+        uint64_t later = slot + 1 < SLOTS ? occupied[0] >> (slot + 1) : 0;
+        uint64_t next = later != 0 ? base + (uint64_t) __builtin_ctzll(later) + 1 : (base | (SLOTS - 1)) + 1;
+        base = next < now + 1 ? next : now + 1;
+    }
+}
+
+void TimingWheel::clear() {
+    timers.clear();
+    freeTimer = NIL;
+    for (auto &h : heads) h = NIL;
+    for (auto &o : occupied) o = 0;
+    count = 0;
+}
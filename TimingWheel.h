@@ -0,0 +1,123 @@
+#ifndef AEDA_FEUP_PROJECT_TIMINGWHEEL_H
+#define AEDA_FEUP_PROJECT_TIMINGWHEEL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Hierarchical timing wheel of timers that expire at a tick (a minute of the Company clock, or any other clock).
+ * Level L has SLOTS buckets of SLOTS^L ticks each; a timer is linked in the bucket of the lowest level that covers
+ * its distance to the clock, and the buckets of a level are moved down (cascaded) when the level below wraps.
+ * Scheduling and cancelling a timer are O(1), and every timer is moved at most LEVELS times before it expires.
+ * Empty buckets are skipped with a bitmap per level, so the clock can jump ahead cheaply.
+ */
+class TimingWheel {
+
+public:
+    static const uint32_t NIL = UINT32_MAX;
+    /**
+     * @brief log2 of the buckets of a level
+     */
+    static const unsigned int LEVEL_BITS = 6;
+    static const size_t SLOTS = size_t(1) << LEVEL_BITS;
+    /**
+     * @brief levels of the wheel, timers further than SLOTS^LEVELS ticks are parked in the last level
+     */
+    static const unsigned int LEVELS = 5;
+
+private:
+    //! struct Timer
+    /*! A timer with its links in the list of its bucket */
+    struct Timer {
+        uint64_t expiry = 0;    /*!< tick of the expiry */
+        uint64_t payload = 0;   /*!< value returned when the timer expires */
+        uint32_t prev = NIL;    /*!< previous timer of the bucket */
+        uint32_t next = NIL;    /*!< next timer of the bucket, or next free timer */
+        uint32_t bucket = NIL;  /*!< bucket of the timer, NIL if the timer is free */
+    };
+
+    /**
+     * @brief timers, a free timer is reused by the next schedule()
+     */
+    vector<Timer> timers;
+    /**
+     * @brief first free timer
+     */
+    uint32_t freeTimer = NIL;
+    /**
+     * @brief first timer of each bucket, level by level
+     */
+    uint32_t heads[LEVELS * SLOTS];
+    /**
+     * @brief non empty buckets of each level
+     */
+    uint64_t occupied[LEVELS];
+    /**
+     * @brief next tick to process, every tick before it has been processed
+     */
+    uint64_t base = 0;
+    /**
+     * @brief number of scheduled timers
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Links a timer in the bucket of its expiry relative to base
+     * @param t uint32_t t
+     */
+    void place(uint32_t t);
+
+    /**
+     * @brief Unlinks a timer from its bucket
+     * @param t uint32_t t
+     */
+    void unlink(uint32_t t);
+
+    /**
+     * @brief Moves the timers of the current bucket of a level to the lower levels
+     * @param level unsigned int level (at least 1)
+     * @return size_t index of the bucket cascaded
+     */
+    size_t cascade(unsigned int level);
+
+public:
+    TimingWheel();
+
+    /**
+     * @brief Schedules a timer
+     * @param expiry uint64_t expiry (a tick already processed expires on the next advance)
+     * @param payload uint64_t payload
+     * @return uint32_t id of the timer, valid until it expires or is cancelled
+     */
+    uint32_t schedule(uint64_t expiry, uint64_t payload);
+
+    /**
+     * @brief Cancels a scheduled timer
+     * @param timer uint32_t timer
+     * @return true if the timer was scheduled and false otherwise
+     */
+    bool cancel(uint32_t timer);
+
+    /**
+     * @brief Processes every tick up to now, appending the payloads of the timers that expire in expiry order
+     * @param now uint64_t now
+     * @param expired vector<uint64_t> &expired
+     */
+    void advance(uint64_t now, vector<uint64_t> &expired);
+
+    /**
+     * @brief Cancels every timer
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of scheduled timers
+     * @return size_t
+     */
+    size_t size() const { return count; }
+};
+
+#endif //AEDA_FEUP_PROJECT_TIMINGWHEEL_H
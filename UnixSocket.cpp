@@ -0,0 +1,103 @@
+#include "UnixSocket.h"
+
+#ifdef __linux__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+
+/**
+ * @brief set by the handler of SIGINT and SIGTERM
+ */
+static volatile sig_atomic_t stopSignalled = 0;
+
+/**
+ * @brief Handler of SIGINT and SIGTERM, both stop the server the same way so the signal number is not used
+ */
+static void onStopSignal(int) {
+    stopSignalled = 1;
+}
+
+/**
+ * @brief Fills the address of a path
+ * @param path const string &path
+ * @param address sockaddr_un &address
+ * @return true if the path fits in the address and false otherwise
+ */
+static bool unixAddress(const string &path, sockaddr_un &address) {
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(address.sun_path, path.c_str());
+    return true;
+}
+
+int listenUnix(const string &path) {
+    sockaddr_un address;
+    if (!unixAddress(path, address)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    unlink(path.c_str());
+    if (bind(fd, (sockaddr *) &address, sizeof(address)) < 0 || listen(fd, 128) < 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+int acceptUnix(int listenFd) {
+    return accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+}
+
+int connectUnix(const string &path) {
+    sockaddr_un address;
+    if (!unixAddress(path, address)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (sockaddr *) &address, sizeof(address)) < 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+int setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0) return -1;
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+void closeSocket(int fd) {
+    close(fd);
+}
+
+void removeSocket(const string &path) {
+    unlink(path.c_str());
+}
+
+void watchStopSignals() {
+    // no SA_RESTART, so a blocking wait returns when the signal arrives
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onStopSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+}
+
+bool stopRequested() {
+    return stopSignalled != 0;
+}
+
+#endif //__linux__
@@ -0,0 +1,69 @@
+#ifndef AEDA_FEUP_PROJECT_UNIXSOCKET_H
+#define AEDA_FEUP_PROJECT_UNIXSOCKET_H
+
+#ifdef __linux__
+
+#include <string>
+
+using namespace std;
+
+/**
+ * Thin wrappers of the Unix domain socket and signal calls used by the BookingServer and the LoadGenerator.
+ * They live in their own translation unit because <unistd.h> (also pulled in by <csignal>) declares a pause() that
+ * clashes with the one of helper.h. The functions that return an int return -1 and leave errno set on failure.
+ */
+
+/**
+ * @brief Creates a non-blocking socket listening on the path passed as argument (an old socket file is replaced)
+ * @param path const string &path
+ * @return int socket
+ */
+int listenUnix(const string &path);
+
+/**
+ * @brief Accepts a pending connection as a non-blocking socket
+ * @param listenFd int listenFd
+ * @return int socket, -1 if there is none
+ */
+int acceptUnix(int listenFd);
+
+/**
+ * @brief Connects a blocking socket to the path passed as argument
+ * @param path const string &path
+ * @return int socket
+ */
+int connectUnix(const string &path);
+
+/**
+ * @brief Makes a socket non-blocking
+ * @param fd int fd
+ * @return int 0 on success
+ */
+int setNonBlocking(int fd);
+
+/**
+ * @brief Closes a socket (or any file descriptor)
+ * @param fd int fd
+ */
+void closeSocket(int fd);
+
+/**
+ * @brief Removes the socket file of a path
+ * @param path const string &path
+ */
+void removeSocket(const string &path);
+
+/**
+ * @brief Makes SIGINT and SIGTERM request a stop (without restarting the interrupted call) and ignores SIGPIPE
+ */
+void watchStopSignals();
+
+/**
+ * @brief Checks if SIGINT or SIGTERM arrived since watchStopSignals() was called
+ * @return true if a stop was requested and false otherwise
+ */
+bool stopRequested();
+
+#endif //__linux__
+
+#endif //AEDA_FEUP_PROJECT_UNIXSOCKET_H
@@ -0,0 +1,100 @@
+#include "Waitlist.h"
+#include <algorithm>
+
+bool Waitlist::waiting(unsigned int flightId, const Waiter &w) const {
+    auto it = tickets.find(key(flightId, w.passengerId));
+    return it != tickets.end() && it->second == w.ticket;
+}
+
+bool Waitlist::forget(unsigned int flightId, unsigned int passengerId) {
+    if (tickets.erase(key(flightId, passengerId)) == 0) return false;
+    auto it = flightsOf.find(passengerId);
+    if (it != flightsOf.end()) {
+        vector<unsigned int> &flights = it->second;
+        flights.erase(find(flights.begin(), flights.end(), flightId));
+        if (flights.empty()) flightsOf.erase(it);
+    }
+    auto q = queues.find(flightId);
+    if (q != queues.end()) q->second.size--;
+    return true;
+}
+
+void Waitlist::compact(unsigned int flightId, Queue &queue) {
+    if (queue.heap.size() <= 2 * queue.size + 16) return;
+    vector<Waiter> kept;
+    kept.reserve(queue.size);
+    for (auto const &w : queue.heap) {
+        if (waiting(flightId, w)) kept.push_back(w);
+    }
+    make_heap(kept.begin(), kept.end(), later);
+    queue.heap.swap(kept);
+}
+
+bool Waitlist::add(unsigned int flightId, unsigned int passengerId, int priority) {
+    if (contains(flightId, passengerId)) return false;
+    restore(flightId, Waiter{passengerId, priority, nextTicket++});
+    return true;
+}
+
+void Waitlist::restore(unsigned int flightId, const Waiter &waiter) {
+    tickets[key(flightId, waiter.passengerId)] = waiter.ticket;
+    flightsOf[waiter.passengerId].push_back(flightId);
+    Queue &queue = queues[flightId];
+    queue.heap.push_back(waiter);
+    push_heap(queue.heap.begin(), queue.heap.end(), later);
+    queue.size++;
+}
+
+bool Waitlist::pop(unsigned int flightId, Waiter &next) {
+    auto it = queues.find(flightId);
+    if (it == queues.end()) return false;
+    Queue &queue = it->second;
+    while (!queue.heap.empty()) {
+        pop_heap(queue.heap.begin(), queue.heap.end(), later);
+        Waiter w = queue.heap.back();
+        queue.heap.pop_back();
+        if (!waiting(flightId, w)) continue;
+        forget(flightId, w.passengerId);
+        next = w;
+        if (queue.size == 0) queues.erase(it);
+        return true;
+    }
+    queues.erase(it);
+    return false;
+}
+
+bool Waitlist::erase(unsigned int flightId, unsigned int passengerId) {
+    if (!forget(flightId, passengerId)) return false;
+    auto it = queues.find(flightId);
+    if (it->second.size == 0) queues.erase(it);
+    else compact(flightId, it->second);
+    return true;
+}
+
+void Waitlist::erasePassenger(unsigned int passengerId) {
+    auto it = flightsOf.find(passengerId);
+    if (it == flightsOf.end()) return;
+    vector<unsigned int> flights = it->second;
+    for (auto f : flights) erase(f, passengerId);
+}
+
+void Waitlist::eraseFlight(unsigned int flightId) {
+    auto it = queues.find(flightId);
+    if (it == queues.end()) return;
+    vector<Waiter> heap = it->second.heap;
+    for (auto const &w : heap) {
+        if (waiting(flightId, w)) forget(flightId, w.passengerId);
+    }
+    queues.erase(flightId);
+}
+
+void Waitlist::clear() {
+    queues.clear();
+    tickets.clear();
+    flightsOf.clear();
+}
+
+size_t Waitlist::size(unsigned int flightId) const {
+    auto it = queues.find(flightId);
+    return it == queues.end() ? 0 : it->second.size;
+}
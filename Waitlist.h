@@ -0,0 +1,164 @@
+#ifndef AEDA_FEUP_PROJECT_WAITLIST_H
+#define AEDA_FEUP_PROJECT_WAITLIST_H
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Passengers waiting for a seat of a full commercial flight, by flight id.
+ * The waiters of a flight are a binary heap served by priority (the avgYrFlights of their card, card holders first)
+ * and then by the order of their requests, so the next waiter is found in O(log n). Removing a waiter only forgets its
+ * ticket: its entry stays in the heap until it reaches the top (or the heap is compacted) and is then discarded.
+ */
+class Waitlist {
+
+public:
+    //! struct Waiter
+    /*! A passenger waiting for a seat */
+    struct Waiter {
+        unsigned int passengerId; /*!< passenger that waits */
+        int priority;             /*!< avgYrFlights of the card of the passenger, -1 without a card */
+        uint64_t ticket;          /*!< order of the request, an earlier request has a lower ticket */
+    };
+
+private:
+    //! struct Queue
+    /*! Waiters of a flight */
+    struct Queue {
+        vector<Waiter> heap; /*!< heap of the waiters, with the removed ones not yet discarded */
+        size_t size = 0;     /*!< waiters still waiting */
+    };
+
+    /**
+     * @brief waiters by flight id
+     */
+    unordered_map<unsigned int, Queue> queues;
+    /**
+     * @brief ticket of each waiter still waiting by key(), an entry of a heap is discarded if its ticket is not here
+     */
+    unordered_map<uint64_t, uint64_t> tickets;
+    /**
+     * @brief flights each passenger waits for, so a deleted passenger leaves every waitlist without a search
+     */
+    unordered_map<unsigned int, vector<unsigned int> > flightsOf;
+    /**
+     * @brief ticket of the next request
+     */
+    uint64_t nextTicket = 0;
+
+    static uint64_t key(unsigned int flightId, unsigned int passengerId) {
+        return (uint64_t) flightId << 32 | passengerId;
+    }
+
+    /**
+     * @brief Order of the heaps: true if the first waiter is served after the second
+     * @param a const Waiter &a
+     * @param b const Waiter &b
+     * @return bool
+     */
+    static bool later(const Waiter &a, const Waiter &b) {
+        return a.priority != b.priority ? a.priority < b.priority : a.ticket > b.ticket;
+    }
+
+    /**
+     * @brief Checks if an entry of the heap of a flight is a waiter still waiting
+     * @param flightId unsigned int flightId
+     * @param w const Waiter &w
+     * @return bool
+     */
+    bool waiting(unsigned int flightId, const Waiter &w) const;
+
+    /**
+     * @brief Forgets a waiter (its entry is discarded later) and the flight from the flights of the passenger
+     * @param flightId unsigned int flightId
+     * @param passengerId unsigned int passengerId
+     * @return true if the passenger was waiting for the flight and false otherwise
+     */
+    bool forget(unsigned int flightId, unsigned int passengerId);
+
+    /**
+     * @brief Rebuilds the heap of a flight without its discarded entries once they are most of the heap
+     * @param flightId unsigned int flightId
+     * @param queue Queue &queue
+     */
+    void compact(unsigned int flightId, Queue &queue);
+
+public:
+    /**
+     * @brief Adds a passenger to the waiters of a flight
+     * @param flightId unsigned int flightId
+     * @param passengerId unsigned int passengerId
+     * @param priority int priority
+     * @return true if the passenger was added and false if it was already waiting (it keeps its place)
+     */
+    bool add(unsigned int flightId, unsigned int passengerId, int priority);
+
+    /**
+     * @brief Checks if a passenger waits for a flight
+     * @param flightId unsigned int flightId
+     * @param passengerId unsigned int passengerId
+     * @return bool
+     */
+    bool contains(unsigned int flightId, unsigned int passengerId) const {
+        return tickets.find(key(flightId, passengerId)) != tickets.end();
+    }
+
+    /**
+     * @brief Puts back a waiter taken by pop() that could not be served, in the place it had
+     * @param flightId unsigned int flightId
+     * @param waiter const Waiter &waiter
+     */
+    void restore(unsigned int flightId, const Waiter &waiter);
+
+    /**
+     * @brief Takes the next waiter of a flight
+     * @param flightId unsigned int flightId
+     * @param next Waiter &next
+     * @return true if the flight had a waiter and false otherwise
+     */
+    bool pop(unsigned int flightId, Waiter &next);
+
+    /**
+     * @brief Removes a passenger from the waiters of a flight
+     * @param flightId unsigned int flightId
+     * @param passengerId unsigned int passengerId
+     * @return true if the passenger was waiting and false otherwise
+     */
+    bool erase(unsigned int flightId, unsigned int passengerId);
+
+    /**
+     * @brief Removes a passenger from every waitlist
+     * @param passengerId unsigned int passengerId
+     */
+    void erasePassenger(unsigned int passengerId);
+
+    /**
+     * @brief Removes every waiter of a flight
+     * @param flightId unsigned int flightId
+     */
+    void eraseFlight(unsigned int flightId);
+
+    /**
+     * @brief Removes every waiter
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of waiters of a flight
+     * @param flightId unsigned int flightId
+     * @return size_t
+     */
+    size_t size(unsigned int flightId) const;
+
+    /**
+     * @brief Gets the number of waiters of every flight
+     * @return size_t
+     */
+    size_t size() const { return tickets.size(); }
+};
+
+#endif //AEDA_FEUP_PROJECT_WAITLIST_H
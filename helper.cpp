@@ -87,6 +87,11 @@ void trimString(string &s) {
     s = s.substr(0, s.find_last_not_of(" ") + 1);
 }
 
+void appendColumn(string &out, const string &s, size_t width) {
+    out += s;
+    if (s.size() < width) out.append(width - s.size(), ' ');
+}
+
 // Function to wait for next menu input
 void pause() {
     string foo;
@@ -204,17 +209,24 @@ bool validDate(Date &date) {
 }
 
 void Date::normalize() {
-    while (this->minute > 59) {
-        this->minute -= 60;
-        this->hour++;
+    // the carries are divided out instead of subtracted one at a time, differences of dates can be years long
+    if (this->minute > 59) {
+        this->hour += this->minute / 60;
+        this->minute %= 60;
+    }
+    if (this->hour > 23) {
+        this->day += this->hour / 24;
+        this->hour %= 24;
     }
-    while (this->hour > 23) {
-        this->hour -= 24;
-        this->day++;
+    if (this->month > 12) {
+        this->year += (this->month - 1) / 12;
+        this->month = (this->month - 1) % 12 + 1;
     }
-    while (this->month > 12) {
-        this->month -= 12;
-        this->year++;
+    if (this->month >= 1 && this->day > 396) {
+        // every 12 months starting at any month have 365 days
+        int years = (this->day - 32) / 365;
+        this->day -= years * 365;
+        this->year += years;
     }
     while (this->day > monthdays[this->month]) {
         this->day -= monthdays[this->month];
@@ -231,7 +243,7 @@ int Date::convertToMinutes() const {
     int t = this->minute;
     t += this->hour * 60;
     t += this->day * 24 * 60;
-    for (int i = 1; i <= this->month; i++) t += monthdays[i] * 24 * 60;
+    for (int i = 1; i < this->month; i++) t += monthdays[i] * 24 * 60;
     t += this->year * 525600;
     return t;
 
@@ -21,7 +21,13 @@ enum type {
     FPRICEL = 8,   /*!< Flights based on Price(lowest to highest) */
     FPRICEH = 9,   /*!< Flights based on Price(highest to lowest) */
     FDEST = 10,     /*!< Flights by Destination city */
-    FTIME = 11      /*!< Flights by the time remaining to the time of the flight */
+    FTIME = 11,     /*!< Flights by the time remaining to the time of the flight */
+    FCAL = 12,      /*!< Cheapest fare per day of a route */
+    FCHEAP = 13,    /*!< Cheapest flights, one page at a time */
+    FNEXT = 14,     /*!< Next departures, one page at a time */
+    PNAMEPAGE = 15, /*!< Passengers by name, one page at a time */
+    PBIRTH = 16,    /*!< Passengers born between two dates */
+    PAGEGROUP = 17  /*!< Number of passengers per age group */
 };
 /*! enum used on time management menu */
 enum date_member_t {
@@ -152,9 +158,9 @@ struct Date {
      */
     string printTime() const {
         stringstream s;
-        cout << std::right << setfill('0')
-             << setw(2) << to_string(this->hour) << ":" << setfill('0') << setw(2) << to_string(this->minute)
-             << resetiosflags(std::ios::showbase) << setfill(' ');
+        s << std::right << setfill('0')
+          << setw(2) << to_string(this->hour) << ":" << setfill('0') << setw(2) << to_string(this->minute)
+          << resetiosflags(std::ios::showbase) << setfill(' ');
         return s.str();
     }
 
@@ -184,6 +190,14 @@ bool validArg(int &variable);
  */
 void trimString(string &s);
 
+/**
+ * @brief appends s to out left aligned in a column of the given width (like std::left << setw(width) << s)
+ * @param out string &out
+ * @param s const string &s
+ * @param width size_t width
+ */
+void appendColumn(string &out, const string &s, size_t width);
+
 /**
  * @brief waits for user input
  */
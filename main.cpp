@@ -1,6 +1,17 @@
 #include "Application.h"
+#include "LoadGenerator.h"
 
-int main() {
+int main(int argc, char *argv[]) {
     Application app;
+    if (argc == 3 && string(argv[1]) == "--batch") return app.runBatch(argv[2]);
+#ifdef __linux__
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--serve") return app.serve(argv[2], argc == 4 ? argv[3] : "");
+    if (argc >= 4 && argc <= 6 && string(argv[1]) == "--loadgen") {
+        LoadGenerator generator((uint32_t) strtoul(argv[3], nullptr, 10));
+        unsigned int requests = argc >= 5 ? (unsigned int) strtoul(argv[4], nullptr, 10) : 100000;
+        unsigned int depth = argc >= 6 ? (unsigned int) strtoul(argv[5], nullptr, 10) : 64;
+        return generator.run(argv[2], requests, depth);
+    }
+#endif
     app.mainMenu();
-}
\ No newline at end of file
+}